@@ -0,0 +1,34 @@
+#include "benchmark/benchmark_api.h"
+#include "coverage.h"
+
+#include <cstdint>
+#include <set>
+#include <utility>
+
+// a program counter walking a 64KB ROM: mostly straight-line code with short loops
+static std::uint32_t next_pc(std::uint32_t pc, std::uint32_t step)
+{
+	return ((step & 31) == 31) ? (pc - 0x40) & 0xffff : (pc + 2) & 0xffff;
+}
+
+static void BM_coverage_map_record(benchmark::State& state) {
+	util::coverage_map map("program", 0xffff);
+	std::uint32_t pc = 0, step = 0;
+	while (state.KeepRunning()) {
+		map.record(util::coverage_map::EXEC, pc);
+		pc = next_pc(pc, step++);
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_coverage_map_record);
+
+// what trackpc does per instruction: a set of (pc, opcode crc) pairs
+static void BM_coverage_set_insert(benchmark::State& state) {
+	std::set<std::pair<std::uint32_t, std::uint32_t>> set;
+	std::uint32_t pc = 0, step = 0;
+	while (state.KeepRunning()) {
+		set.insert(std::make_pair(pc, std::uint32_t(0x1234)));
+		pc = next_pc(pc, step++);
+	}
+}
+BENCHMARK(BM_coverage_set_insert);
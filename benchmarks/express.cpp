@@ -0,0 +1,47 @@
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "debug/express.h"
+
+// a typical conditional breakpoint: registers, a constant and a memory read
+static const char *const condition = "(pc == 1234 && b@(sp + 2) != 0) || (a & k) == 3";
+
+static u64 s_pc = 0x1000, s_sp = 0x80, s_a = 0x11;
+
+static symbol_table &benchmark_symbols()
+{
+	static symbol_table symbols(nullptr);
+	static bool initialized = false;
+	if (!initialized)
+	{
+		symbols.add("pc", symbol_table::READ_WRITE, &s_pc);
+		symbols.add("sp", symbol_table::READ_WRITE, &s_sp);
+		symbols.add("a", [] (symbol_table &table) { return s_a; });
+		symbols.add("k", 0x0f);
+		symbols.configure_memory(nullptr,
+				[] (void *param, const char *name, expression_space space) { return expression_error::NONE; },
+				[] (void *param, const char *name, expression_space space, u32 offset, int size, bool disable_se) -> u64 { return offset & 0xff; },
+				nullptr);
+		initialized = true;
+	}
+	return symbols;
+}
+
+static void BM_express_interpreted(benchmark::State& state) {
+	parsed_expression expression(&benchmark_symbols(), condition);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(expression.execute_interpreted());
+		s_pc++;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_express_interpreted);
+
+static void BM_express_compiled(benchmark::State& state) {
+	parsed_expression expression(&benchmark_symbols(), condition);
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(expression.execute());
+		s_pc++;
+	}
+}
+// Register the function as a benchmark
+BENCHMARK(BM_express_compiled);
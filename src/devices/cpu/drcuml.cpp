@@ -35,6 +35,8 @@
 #include "drcuml.h"
 
 #include "emuopts.h"
+#include "drcfe.h"
+#include "drcumlsh.h"
 #include "drcbec.h"
 #include "drcbex86.h"
 #include "drcbex64.h"
@@ -75,6 +77,19 @@ struct bevalidate_test
 };
 
 
+// addresses of a straight run of compiled instructions, recorded together
+struct coverage_run
+{
+	device_execute_interface *  exec;       // device whose coverage map gets them
+	u32                         count;      // number of addresses
+	offs_t                      pc[1];      // addresses, including delay slots
+};
+
+
+// instructions that may leave a sequence before its end
+constexpr u32 COVERAGE_RUN_END = OPFLAG_IS_BRANCH | OPFLAG_CAN_TRIGGER_SW_INT | OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_REDISPATCH;
+
+
 
 //**************************************************************************
 //  DRC BACKEND INTERFACE
@@ -234,6 +249,67 @@ uml::code_handle *drcuml_state::handle_alloc(char const *name)
 }
 
 
+//-------------------------------------------------
+//  record_coverage - record a run of executed
+//  instructions in the device's coverage map
+//-------------------------------------------------
+
+static void record_coverage(void *param)
+{
+	coverage_run const &run = *reinterpret_cast<coverage_run const *>(param);
+	util::coverage_map *const map = run.exec->exec_coverage();
+	if (map != nullptr)
+		for (u32 index = 0; index < run.count; index++)
+			map->record(util::coverage_map::EXEC, run.pc[index]);
+}
+
+
+//-------------------------------------------------
+//  generate_coverage - generate code recording
+//  the run of instructions from desc up to the
+//  first one that may leave the sequence early;
+//  cores call this before compiling each
+//  instruction that starts a run
+//-------------------------------------------------
+
+opcode_desc const *drcuml_state::generate_coverage(drcuml_block &block, opcode_desc const *desc, opcode_desc const *seqlast)
+{
+	// find the end of the run
+	opcode_desc const *last = desc;
+	while (last != seqlast && !(last->flags & COVERAGE_RUN_END))
+		last = last->next();
+	opcode_desc const *const next = last->next();
+
+	// coverage can only be turned on without the debugger before anything
+	// is compiled, so there's no need to pay for the check otherwise
+	device_execute_interface *exec;
+	if (!(m_device.machine().debug_flags & (DEBUG_FLAG_ENABLED | DEBUG_FLAG_COVERAGE)) || !m_device.interface(exec))
+		return next;
+
+	// gather the addresses, delay slots included
+	std::vector<offs_t> pcs;
+	for (opcode_desc const *curdesc = desc; curdesc != next; curdesc = curdesc->next())
+	{
+		pcs.push_back(curdesc->pc);
+		for (opcode_desc const *slot = curdesc->delay.first(); slot != nullptr; slot = slot->next())
+			pcs.push_back(slot->pc);
+	}
+
+	// the run lives in the cache alongside the code, so it goes when the code does
+	coverage_run *const run = reinterpret_cast<coverage_run *>(m_cache.alloc_temporary(sizeof(coverage_run) + (pcs.size() - 1) * sizeof(offs_t)));
+	if (run == nullptr)
+		block.abort();
+	run->exec = exec;
+	run->count = pcs.size();
+	std::copy(pcs.begin(), pcs.end(), run->pc);
+
+	// only call out while recording
+	UML_TEST(block, mem(&m_device.machine().debug_flags), DEBUG_FLAG_COVERAGE);     // test    [debug_flags],DEBUG_FLAG_COVERAGE
+	UML_CALLCc(block, COND_NZ, record_coverage, run);                           // callc   record_coverage,run,nz
+	return next;
+}
+
+
 //-------------------------------------------------
 //  symbol_add - add a symbol to the internal
 //  symbol table
@@ -36,6 +36,9 @@
 // opaque structure describing UML generation state
 class drcuml_state;
 
+// declared in drcfe.h
+struct opcode_desc;
+
 
 // an integer register, with low/high parts
 union drcuml_ireg
@@ -181,6 +184,9 @@ public:
 	// handle management
 	uml::code_handle *handle_alloc(char const *name);
 
+	// coverage; returns the first instruction after the run recorded
+	opcode_desc const *generate_coverage(drcuml_block &block, opcode_desc const *desc, opcode_desc const *seqlast);
+
 	// symbol management
 	void symbol_add(void *base, u32 length, char const *name);
 	char const *symbol_find(void *base, u32 *offset = nullptr);
@@ -462,8 +462,7 @@ static size_t execute_one_new(dsp56k_core* cpustate)
 {
 	// For MAME
 	cpustate->ppc = PC;
-	if (cpustate->device->machine().debug_flags & DEBUG_FLAG_CALL_HOOK) // FIXME: if this was a member, the helper would work
-		cpustate->device->debug()->instruction_hook(PC);
+	downcast<dsp56k_device *>(cpustate->device)->debugger_hook(PC);
 
 	cpustate->op = ROPCODE(PC);
 	uint16_t w0 = ROPCODE(PC);
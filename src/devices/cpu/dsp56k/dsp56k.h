@@ -215,6 +215,10 @@ public:
 
 	void dsp56156_program_map(address_map &map);
 	void dsp56156_x_data_map(address_map &map);
+
+	// the opcode handlers aren't members, so they reach the instruction hook through here
+	void debugger_hook(offs_t pc) { debugger_instruction_hook(pc); }
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -240,8 +240,7 @@ static void execute_one(dsp56k_core* cpustate)
 
 	/* For MAME */
 	cpustate->ppc = PC;
-	if (cpustate->device->machine().debug_flags & DEBUG_FLAG_CALL_HOOK) // FIXME: if this was a member, the helper would work
-		cpustate->device->debug()->instruction_hook(PC);
+	downcast<dsp56k_device *>(cpustate->device)->debugger_hook(PC);
 
 	cpustate->op = ROPCODE(PC);
 	/* The words we're going to be working with */
@@ -275,9 +275,12 @@ void hyperstone_device::code_compile_block(offs_t pc)
 				UML_MOV(block, I7, 0);
 				UML_CALLH(block, *m_interrupt_checks);
 
-				/* iterate over instructions in the sequence and compile them */
+				/* iterate over instructions in the sequence and compile them, recording coverage for each straight run */
+				const opcode_desc *coverdesc = seqhead;
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 				{
+					if (curdesc == coverdesc)
+						coverdesc = m_drcuml->generate_coverage(block, curdesc, seqlast);
 					generate_sequence_instruction(block, compiler, curdesc);
 					generate_update_cycles(block);
 				}
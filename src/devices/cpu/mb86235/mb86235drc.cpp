@@ -296,9 +296,14 @@ void mb86235_device::compile_block(offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
 
-																							/* iterate over instructions in the sequence and compile them */
+				/* iterate over instructions in the sequence and compile them, recording coverage for each straight run */
+				const opcode_desc *coverdesc = seqhead;
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					if (curdesc == coverdesc)
+						coverdesc = m_drcuml->generate_coverage(block, curdesc, seqlast);
 					generate_sequence_instruction(block, compiler, curdesc);
+				}
 
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
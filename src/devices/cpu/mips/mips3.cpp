@@ -165,6 +165,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_out_of_cycles(nullptr)
 	, m_tlb_mismatch(nullptr)
 	, m_hotspot_select(0)
+	, m_drc_breakpoints(false)
 {
 	memset(m_fpmode, 0, sizeof(m_fpmode));
 
@@ -284,6 +284,7 @@ protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
 	virtual void device_stop() override;
+	virtual void device_debug_setup() override;
 
 	// device_execute_interface overrides
 	virtual uint32_t execute_min_cycles() const override { return 1; }
@@ -444,6 +445,7 @@ private:
 		uint32_t              cycles;                     /* number of cycles to eat when hit */
 	}       m_hotspot[MIPS3_MAX_HOTSPOTS];
 	bool m_isdrc;
+	bool m_drc_breakpoints;                             /* debugger calls are compiled in at breakpoints only */
 
 
 	void generate_exception(int exception, int backup);
@@ -525,6 +527,7 @@ private:
 	void code_compile_block(uint8_t mode, offs_t pc);
 public:
 	void func_get_cycles();
+	void func_debugger_breakpoint();
 	void func_printf_exception();
 	void func_printf_debug();
 	void func_printf_probe();
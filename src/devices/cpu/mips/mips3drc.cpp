@@ -25,6 +25,7 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "emuopts.h"
 #include "mips3com.h"
 #include "mips3fe.h"
 #include "mips3dsm.h"
@@ -71,6 +72,7 @@
 
 static void cfunc_printf_exception(void *param);
 static void cfunc_get_cycles(void *param);
+static void cfunc_debugger_breakpoint(void *param);
 static void cfunc_printf_probe(void *param);
 
 
@@ -210,6 +212,22 @@ void mips3_device::mips3drc_add_hotspot(offs_t pc, uint32_t opcode, uint32_t cyc
     CACHE MANAGEMENT
 ***************************************************************************/
 
+/*-------------------------------------------------
+    device_debug_setup - with -drc_breakpoints,
+    compile debugger calls in at breakpoints and
+    recompile whenever they move
+-------------------------------------------------*/
+
+void mips3_device::device_debug_setup()
+{
+	if (!m_isdrc || !machine().options().drc_breakpoints())
+		return;
+
+	m_drc_breakpoints = true;
+	debug()->set_breakpoint_compiler([this] () { m_cache_dirty = true; abort_timeslice(); });
+}
+
+
 /*-------------------------------------------------
     code_flush_cache - flush the cache and
     regenerate static code
@@ -344,9 +362,14 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 
-				/* iterate over instructions in the sequence and compile them */
+				/* iterate over instructions in the sequence and compile them, recording coverage for each straight run */
+				const opcode_desc *coverdesc = seqhead;
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					if (curdesc == coverdesc)
+						coverdesc = m_drcuml->generate_coverage(block, curdesc, seqlast);
 					generate_sequence_instruction(block, compiler, curdesc);
+				}
 
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
@@ -432,6 +455,24 @@ static void cfunc_get_cycles(void *param)
 }
 
 
+/*-------------------------------------------------
+    cfunc_debugger_breakpoint - call the debugger
+    at a compiled breakpoint; this replaces the
+    DEBUG opcode there, so it calls the hook
+    whether or not every instruction is hooked
+-------------------------------------------------*/
+
+void mips3_device::func_debugger_breakpoint()
+{
+	debug()->instruction_hook(m_core->pc);
+}
+
+static void cfunc_debugger_breakpoint(void *param)
+{
+	((mips3_device *)param)->func_debugger_breakpoint();
+}
+
+
 /*-------------------------------------------------
     cfunc_printf_exception - log any exceptions that
     aren't interrupts
@@ -1183,7 +1224,10 @@ void mips3_device::generate_sequence_instruction(drcuml_block &block, compiler_s
 	{
 		UML_MOV(block, mem(&m_core->pc), desc->pc);                              // mov     [pc],desc->pc
 		save_fast_iregs(block);
-		UML_DEBUG(block, desc->pc);                                         // debug   desc->pc
+		if (m_drc_breakpoints && debug()->breakpoint_at(desc->pc))
+			UML_CALLC(block, cfunc_debugger_breakpoint, this);                  // callc   cfunc_debugger_breakpoint,mips3
+		else
+			UML_DEBUG(block, desc->pc);                                     // debug   desc->pc
 	}
 
 	/* if we hit an unmapped address, fatal error */
@@ -52,135 +52,9 @@ void c352_device::rom_bank_updated()
 	m_stream->update();
 }
 
-void c352_device::fetch_sample(c352_voice_t* v)
-{
-	v->last_sample = v->sample;
-
-	if(v->flags & C352_FLG_NOISE)
-	{
-		m_random = (m_random>>1) ^ ((-(m_random&1)) & 0xfff6);
-		v->sample = m_random;
-	}
-	else
-	{
-		int8_t s;
-
-		s = (int8_t)read_byte(v->pos);
-
-		if(v->flags & C352_FLG_MULAW)
-			v->sample = m_mulawtab[s&0xff];
-		else
-			v->sample = s<<8;
-
-		uint16_t pos = v->pos&0xffff;
-
-		if((v->flags & C352_FLG_LOOP) && v->flags & C352_FLG_REVERSE)
-		{
-			// backwards>forwards
-			if((v->flags & C352_FLG_LDIR) && pos == v->wave_loop)
-				v->flags &= ~C352_FLG_LDIR;
-			// forwards>backwards
-			else if(!(v->flags & C352_FLG_LDIR) && pos == v->wave_end)
-				v->flags |= C352_FLG_LDIR;
-
-			v->pos += (v->flags&C352_FLG_LDIR) ? -1 : 1;
-		}
-		else if(pos == v->wave_end)
-		{
-			if((v->flags & C352_FLG_LINK) && (v->flags & C352_FLG_LOOP))
-			{
-				v->pos = (v->wave_start<<16) | v->wave_loop;
-				v->flags |= C352_FLG_LOOPHIST;
-			}
-			else if(v->flags & C352_FLG_LOOP)
-			{
-				v->pos = (v->pos&0xff0000) | v->wave_loop;
-				v->flags |= C352_FLG_LOOPHIST;
-			}
-			else
-			{
-				v->flags |= C352_FLG_KEYOFF;
-				v->flags &= ~C352_FLG_BUSY;
-				v->sample=0;
-			}
-		}
-		else
-		{
-			v->pos += (v->flags&C352_FLG_REVERSE) ? -1 : 1;
-		}
-	}
-}
-
-void c352_device::ramp_volume(c352_voice_t* v,int ch,uint8_t val)
-{
-	int16_t vol_delta = v->curr_vol[ch] - val;
-	if(vol_delta != 0)
-		v->curr_vol[ch] += (vol_delta>0) ? -1 : 1;
-}
-
 void c352_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
 {
-	int i,j;
-	int16_t s;
-	int32_t next_counter;
-	stream_sample_t *buffer_fl = outputs[0];
-	stream_sample_t *buffer_fr = outputs[1];
-	stream_sample_t *buffer_rl = outputs[2];
-	stream_sample_t *buffer_rr = outputs[3];
-	c352_voice_t* v;
-
-	long out[4];
-
-	for(i=0;i<samples;i++)
-	{
-		out[0]=out[1]=out[2]=out[3]=0;
-
-		for(j=0;j<32;j++)
-		{
-
-			v = &m_c352_v[j];
-			s = 0;
-
-			if(v->flags & C352_FLG_BUSY)
-			{
-				next_counter = v->counter+v->freq;
-
-				if(next_counter & 0x10000)
-				{
-					fetch_sample(v);
-				}
-
-				if((next_counter^v->counter) & 0x18000)
-				{
-					ramp_volume(v,0,v->vol_f>>8);
-					ramp_volume(v,1,v->vol_f&0xff);
-					ramp_volume(v,2,v->vol_r>>8);
-					ramp_volume(v,3,v->vol_r&0xff);
-				}
-
-				v->counter = next_counter&0xffff;
-
-				s = v->sample;
-
-				// Interpolate samples
-				if((v->flags & C352_FLG_FILTER) == 0)
-					s = v->last_sample + (v->counter*(v->sample-v->last_sample)>>16);
-			}
-
-			// Left
-			out[0] += (((v->flags & C352_FLG_PHASEFL) ? -s : s) * v->curr_vol[0])>>8;
-			out[2] += (((v->flags & C352_FLG_PHASERL) ? -s : s) * v->curr_vol[2])>>8;
-
-			// Right
-			out[1] += (((v->flags & C352_FLG_PHASEFR) ? -s : s) * v->curr_vol[1])>>8;
-			out[3] += (((v->flags & C352_FLG_PHASEFR) ? -s : s) * v->curr_vol[3])>>8;
-		}
-
-		*buffer_fl++ = (int16_t) (out[0]>>3);
-		*buffer_fr++ = (int16_t) (out[1]>>3);
-		*buffer_rl++ = (int16_t) (out[2]>>3);
-		*buffer_rr++ = (int16_t) (out[3]>>3);
-	}
+	update_voices(outputs, samples);
 }
 
 uint16_t c352_device::read_reg16(unsigned long address)
@@ -225,8 +99,6 @@ void c352_device::write_reg16(unsigned long address, unsigned short val)
 		offsetof(c352_voice_t,wave_loop) / sizeof(uint16_t),
 	};
 
-	int i;
-
 	if(address < 0x100)
 	{
 		*((uint16_t*)&m_c352_v[address/8]+reg_map[address%8]) = val;
@@ -238,28 +110,7 @@ void c352_device::write_reg16(unsigned long address, unsigned short val)
 	}
 	else if(address == 0x202) // execute keyons/keyoffs
 	{
-		for(i=0;i<32;i++)
-		{
-			if(m_c352_v[i].flags & C352_FLG_KEYON)
-			{
-				m_c352_v[i].pos = (m_c352_v[i].wave_bank<<16) | m_c352_v[i].wave_start;
-
-				m_c352_v[i].sample = 0;
-				m_c352_v[i].last_sample = 0;
-				m_c352_v[i].counter = 0xffff;
-
-				m_c352_v[i].flags |= C352_FLG_BUSY;
-				m_c352_v[i].flags &= ~(C352_FLG_KEYON|C352_FLG_LOOPHIST);
-
-				m_c352_v[i].curr_vol[0] = m_c352_v[i].curr_vol[1] = 0;
-				m_c352_v[i].curr_vol[2] = m_c352_v[i].curr_vol[3] = 0;
-			}
-			if(m_c352_v[i].flags & C352_FLG_KEYOFF)
-			{
-				m_c352_v[i].flags &= ~(C352_FLG_BUSY|C352_FLG_KEYOFF);
-				m_c352_v[i].counter = 0xffff;
-			}
-		}
+		key_voices();
 	}
 }
 
@@ -280,25 +131,6 @@ void c352_device::device_start()
 
 	m_stream = machine().sound().stream_alloc(*this, 0, 4, m_sample_rate_base);
 
-	// generate mulaw table (Output similar to namco's VC emulator)
-	int j = 0;
-	for(int i=0;i<128;i++)
-	{
-		m_mulawtab[i] = j<<5;
-		if(i < 16)
-			j += 1;
-		else if(i < 24)
-			j += 2;
-		else if(i < 48)
-			j += 4;
-		else if(i < 100)
-			j += 8;
-		else
-			j += 16;
-	}
-	for(int i=0;i<128;i++)
-		m_mulawtab[i+128] = (~m_mulawtab[i])&0xffe0;
-
 	// register save state info
 	for (i = 0; i < 32; i++)
 	{
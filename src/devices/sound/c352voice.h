@@ -0,0 +1,341 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont, superctr
+/***************************************************************************
+
+    c352voice.h
+
+    Namco C352 voice stepping and mixing.
+
+    This is the part of the C352 that turns the voice registers and the
+    sample ROM into output.  It is kept apart from the device so that
+    the block update can be checked against the per-sample one without
+    a running machine.  Device is the class deriving from it, and must
+    provide read_byte(offs_t) for the sample ROM.
+
+***************************************************************************/
+
+#ifndef MAME_SOUND_C352VOICE_H
+#define MAME_SOUND_C352VOICE_H
+
+#pragma once
+
+#include "voicemix.h"
+
+#include <cstring>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> c352_voices
+
+template <class Device>
+class c352_voices
+{
+public:
+	enum {
+		C352_FLG_BUSY       = 0x8000,   // channel is busy
+		C352_FLG_KEYON      = 0x4000,   // Keyon
+		C352_FLG_KEYOFF     = 0x2000,   // Keyoff
+		C352_FLG_LOOPTRG    = 0x1000,   // Loop Trigger
+		C352_FLG_LOOPHIST   = 0x0800,   // Loop History
+		C352_FLG_FM         = 0x0400,   // Frequency Modulation
+		C352_FLG_PHASERL    = 0x0200,   // Rear Left invert phase 180 degrees
+		C352_FLG_PHASEFL    = 0x0100,   // Front Left invert phase 180 degrees
+		C352_FLG_PHASEFR    = 0x0080,   // invert phase 180 degrees (e.g. flip sign of sample)
+		C352_FLG_LDIR       = 0x0040,   // loop direction
+		C352_FLG_LINK       = 0x0020,   // "long-format" sample (can't loop, not sure what else it means)
+		C352_FLG_NOISE      = 0x0010,   // play noise instead of sample
+		C352_FLG_MULAW      = 0x0008,   // sample is mulaw instead of linear 8-bit PCM
+		C352_FLG_FILTER     = 0x0004,   // don't apply filter
+		C352_FLG_REVLOOP    = 0x0003,   // loop backwards
+		C352_FLG_LOOP       = 0x0002,   // loop forward
+		C352_FLG_REVERSE    = 0x0001    // play sample backwards
+	};
+
+	struct c352_voice_t {
+
+		uint32_t pos;
+		uint32_t counter;
+
+		int16_t sample;
+		int16_t last_sample;
+
+		uint16_t vol_f;
+		uint16_t vol_r;
+		uint8_t curr_vol[4];
+
+		uint16_t freq;
+		uint16_t flags;
+
+		uint16_t  wave_bank;
+		uint16_t wave_start;
+		uint16_t wave_end;
+		uint16_t wave_loop;
+
+	};
+
+	c352_voices();
+
+	// execute pending keyons and keyoffs
+	void key_voices();
+
+	// render a block: each playing voice over the whole block, unless the
+	// order voices are stepped in matters
+	void update_voices(stream_sample_t **outputs, int samples);
+
+	// render a block one sample at a time, stepping every voice each sample
+	void update_interleaved(stream_sample_t **outputs, int samples);
+
+protected:
+	void fetch_sample(c352_voice_t* v);
+	void ramp_volume(c352_voice_t* v,int ch,uint8_t val);
+	inline int16_t step_voice(c352_voice_t* v);
+
+	c352_voice_t m_c352_v[32];
+	voice_mixer m_mixer;
+
+	int16_t m_mulawtab[256];
+
+	uint16_t m_random;
+};
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+template <class Device>
+c352_voices<Device>::c352_voices()
+	: m_mixer(4, 5)
+	, m_random(0x1234)
+{
+	memset(m_c352_v, 0, sizeof(m_c352_v));
+
+	// generate mulaw table (Output similar to namco's VC emulator)
+	int j = 0;
+	for(int i=0;i<128;i++)
+	{
+		m_mulawtab[i] = j<<5;
+		if(i < 16)
+			j += 1;
+		else if(i < 24)
+			j += 2;
+		else if(i < 48)
+			j += 4;
+		else if(i < 100)
+			j += 8;
+		else
+			j += 16;
+	}
+	for(int i=0;i<128;i++)
+		m_mulawtab[i+128] = (~m_mulawtab[i])&0xffe0;
+}
+
+template <class Device>
+void c352_voices<Device>::key_voices()
+{
+	for(int i=0;i<32;i++)
+	{
+		if(m_c352_v[i].flags & C352_FLG_KEYON)
+		{
+			m_c352_v[i].pos = (m_c352_v[i].wave_bank<<16) | m_c352_v[i].wave_start;
+
+			m_c352_v[i].sample = 0;
+			m_c352_v[i].last_sample = 0;
+			m_c352_v[i].counter = 0xffff;
+
+			m_c352_v[i].flags |= C352_FLG_BUSY;
+			m_c352_v[i].flags &= ~(C352_FLG_KEYON|C352_FLG_LOOPHIST);
+
+			m_c352_v[i].curr_vol[0] = m_c352_v[i].curr_vol[1] = 0;
+			m_c352_v[i].curr_vol[2] = m_c352_v[i].curr_vol[3] = 0;
+		}
+		if(m_c352_v[i].flags & C352_FLG_KEYOFF)
+		{
+			m_c352_v[i].flags &= ~(C352_FLG_BUSY|C352_FLG_KEYOFF);
+			m_c352_v[i].counter = 0xffff;
+		}
+	}
+}
+
+template <class Device>
+void c352_voices<Device>::fetch_sample(c352_voice_t* v)
+{
+	v->last_sample = v->sample;
+
+	if(v->flags & C352_FLG_NOISE)
+	{
+		m_random = (m_random>>1) ^ ((-(m_random&1)) & 0xfff6);
+		v->sample = m_random;
+	}
+	else
+	{
+		int8_t s;
+
+		s = (int8_t)static_cast<Device &>(*this).read_byte(v->pos);
+
+		if(v->flags & C352_FLG_MULAW)
+			v->sample = m_mulawtab[s&0xff];
+		else
+			v->sample = s<<8;
+
+		uint16_t pos = v->pos&0xffff;
+
+		if((v->flags & C352_FLG_LOOP) && v->flags & C352_FLG_REVERSE)
+		{
+			// backwards>forwards
+			if((v->flags & C352_FLG_LDIR) && pos == v->wave_loop)
+				v->flags &= ~C352_FLG_LDIR;
+			// forwards>backwards
+			else if(!(v->flags & C352_FLG_LDIR) && pos == v->wave_end)
+				v->flags |= C352_FLG_LDIR;
+
+			v->pos += (v->flags&C352_FLG_LDIR) ? -1 : 1;
+		}
+		else if(pos == v->wave_end)
+		{
+			if((v->flags & C352_FLG_LINK) && (v->flags & C352_FLG_LOOP))
+			{
+				v->pos = (v->wave_start<<16) | v->wave_loop;
+				v->flags |= C352_FLG_LOOPHIST;
+			}
+			else if(v->flags & C352_FLG_LOOP)
+			{
+				v->pos = (v->pos&0xff0000) | v->wave_loop;
+				v->flags |= C352_FLG_LOOPHIST;
+			}
+			else
+			{
+				v->flags |= C352_FLG_KEYOFF;
+				v->flags &= ~C352_FLG_BUSY;
+				v->sample=0;
+			}
+		}
+		else
+		{
+			v->pos += (v->flags&C352_FLG_REVERSE) ? -1 : 1;
+		}
+	}
+}
+
+template <class Device>
+void c352_voices<Device>::ramp_volume(c352_voice_t* v,int ch,uint8_t val)
+{
+	int16_t vol_delta = v->curr_vol[ch] - val;
+	if(vol_delta != 0)
+		v->curr_vol[ch] += (vol_delta>0) ? -1 : 1;
+}
+
+template <class Device>
+int16_t c352_voices<Device>::step_voice(c352_voice_t* v)
+{
+	if(!(v->flags & C352_FLG_BUSY))
+		return 0;
+
+	int32_t next_counter = v->counter+v->freq;
+
+	if(next_counter & 0x10000)
+	{
+		fetch_sample(v);
+	}
+
+	if((next_counter^v->counter) & 0x18000)
+	{
+		ramp_volume(v,0,v->vol_f>>8);
+		ramp_volume(v,1,v->vol_f&0xff);
+		ramp_volume(v,2,v->vol_r>>8);
+		ramp_volume(v,3,v->vol_r&0xff);
+	}
+
+	v->counter = next_counter&0xffff;
+
+	int16_t s = v->sample;
+
+	// Interpolate samples
+	if((v->flags & C352_FLG_FILTER) == 0)
+		s = v->last_sample + (v->counter*(v->sample-v->last_sample)>>16);
+
+	return s;
+}
+
+template <class Device>
+void c352_voices<Device>::update_interleaved(stream_sample_t **outputs, int samples)
+{
+	stream_sample_t *buffer_fl = outputs[0];
+	stream_sample_t *buffer_fr = outputs[1];
+	stream_sample_t *buffer_rl = outputs[2];
+	stream_sample_t *buffer_rr = outputs[3];
+
+	long out[4];
+
+	for(int i=0;i<samples;i++)
+	{
+		out[0]=out[1]=out[2]=out[3]=0;
+
+		for(int j=0;j<32;j++)
+		{
+			c352_voice_t* v = &m_c352_v[j];
+			int16_t s = step_voice(v);
+
+			// Left
+			out[0] += (((v->flags & C352_FLG_PHASEFL) ? -s : s) * v->curr_vol[0])>>8;
+			out[2] += (((v->flags & C352_FLG_PHASERL) ? -s : s) * v->curr_vol[2])>>8;
+
+			// Right
+			out[1] += (((v->flags & C352_FLG_PHASEFR) ? -s : s) * v->curr_vol[1])>>8;
+			out[3] += (((v->flags & C352_FLG_PHASEFR) ? -s : s) * v->curr_vol[3])>>8;
+		}
+
+		*buffer_fl++ = (int16_t) (out[0]>>3);
+		*buffer_fr++ = (int16_t) (out[1]>>3);
+		*buffer_rl++ = (int16_t) (out[2]>>3);
+		*buffer_rr++ = (int16_t) (out[3]>>3);
+	}
+}
+
+template <class Device>
+void c352_voices<Device>::update_voices(stream_sample_t **outputs, int samples)
+{
+	// noise voices all advance the one shared generator, so the order
+	// voices are stepped in matters once there's more than one of them
+	int noise_voices = 0;
+	for(int j=0;j<32;j++)
+		if((m_c352_v[j].flags & (C352_FLG_BUSY|C352_FLG_NOISE)) == (C352_FLG_BUSY|C352_FLG_NOISE))
+			noise_voices++;
+	if(noise_voices > 1)
+	{
+		update_interleaved(outputs, samples);
+		return;
+	}
+
+	// otherwise run each playing voice over the whole block
+	m_mixer.begin(samples);
+	int32_t *smp = m_mixer.buffer(0);
+	int32_t *gain[4] = { m_mixer.buffer(1), m_mixer.buffer(2), m_mixer.buffer(3), m_mixer.buffer(4) };
+
+	for(int j=0;j<32;j++)
+	{
+		c352_voice_t* v = &m_c352_v[j];
+		if(!(v->flags & C352_FLG_BUSY))
+			continue;
+
+		for(int i=0;i<samples;i++)
+		{
+			smp[i] = step_voice(v);
+			gain[0][i] = (v->flags & C352_FLG_PHASEFL) ? -v->curr_vol[0] : v->curr_vol[0];
+			gain[1][i] = (v->flags & C352_FLG_PHASEFR) ? -v->curr_vol[1] : v->curr_vol[1];
+			gain[2][i] = (v->flags & C352_FLG_PHASERL) ? -v->curr_vol[2] : v->curr_vol[2];
+			gain[3][i] = (v->flags & C352_FLG_PHASEFR) ? -v->curr_vol[3] : v->curr_vol[3];
+		}
+
+		for(int ch=0;ch<4;ch++)
+			m_mixer.mix(ch, smp, gain[ch], 8);
+	}
+
+	for(int ch=0;ch<4;ch++)
+		m_mixer.write(ch, outputs[ch], 3);
+}
+
+#endif // MAME_SOUND_C352VOICE_H
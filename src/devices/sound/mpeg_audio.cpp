@@ -9,6 +9,17 @@
 #include "emu.h"
 #include "mpeg_audio.h"
 
+// The synthesis loops below are written so that every output lane
+// accumulates its terms in exactly the same order as the plain scalar
+// version, which keeps the decoded samples bit-identical whichever path
+// is used.  SSE2 is only assumed on 64-bit builds, as in rgbutil.h.
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define MPEG_AUDIO_SSE2 1
+#include <emmintrin.h>
+#else
+#define MPEG_AUDIO_SSE2 0
+#endif
+
 mpeg_audio::mpeg_audio(const void *_base, unsigned int _accepted, bool lsb_first, int _position_align)
 {
 	base = (const uint8_t *)_base;
@@ -18,7 +29,7 @@ mpeg_audio::mpeg_audio(const void *_base, unsigned int _accepted, bool lsb_first
 
 	for (int i = 0; i < 32; i++) {
 		for (int j = 0; j < 32; j++)
-			m_cos_cache[i][j] = cos(i*(2 * j + 1)*M_PI / 64);
+			m_cos_cache[j][i] = cos(i*(2 * j + 1)*M_PI / 64);
 	}
 
 	clear();
@@ -195,7 +206,7 @@ void mpeg_audio::decode_mpeg2(short *output, int &output_samples)
 
 				for(int chan=0; chan<channel_count; chan++) {
 					double resynthesis_buffer[32];
-					idct32(subbuffer[chan], audio_buffer[chan] + audio_buffer_pos[chan]);
+					idct32(subbuffer[chan], total_bands, audio_buffer[chan] + audio_buffer_pos[chan]);
 					resynthesis(audio_buffer[chan] + audio_buffer_pos[chan] + 16, resynthesis_buffer);
 					scale_and_clamp(resynthesis_buffer, output + chan, channel_count);
 					audio_buffer_pos[chan] -= 32;
@@ -671,11 +682,14 @@ void mpeg_audio::read_band_value_triplet(int chan, int band)
 	}
 	}
 
-	double scale = 1 << (band_infos[band_idx].bits - 1);
+	// scale is a power of two, so multiplying by its reciprocal is exact
+	const band_info &info = band_infos[band_idx];
+	double scale = 1 << (info.bits - 1);
+	double inv_scale = 1.0 / scale;
 
-	bdata[chan][0][band] = ((buffer[0] - scale) / scale + band_infos[band_idx].offset) * band_infos[band_idx].scale;
-	bdata[chan][1][band] = ((buffer[1] - scale) / scale + band_infos[band_idx].offset) * band_infos[band_idx].scale;
-	bdata[chan][2][band] = ((buffer[2] - scale) / scale + band_infos[band_idx].offset) * band_infos[band_idx].scale;
+	bdata[chan][0][band] = ((buffer[0] - scale) * inv_scale + info.offset) * info.scale;
+	bdata[chan][1][band] = ((buffer[1] - scale) * inv_scale + info.offset) * info.scale;
+	bdata[chan][2][band] = ((buffer[2] - scale) * inv_scale + info.offset) * info.scale;
 }
 
 void mpeg_audio::build_next_segments(int step)
@@ -724,26 +738,61 @@ void mpeg_audio::retrieve_subbuffer(int step)
 		memcpy(subbuffer[chan], bdata[chan][step], 32*sizeof(subbuffer[0][0]));
 }
 
-void mpeg_audio::idct32(const double *input, double *output)
+void mpeg_audio::idct32(const double *input, int bands, double *output)
 {
-	// Simplest idct32 ever, non-fast at all
-	for (int i = 0; i < 32; i++) {
-		double s = 0;
-		for (int j = 0; j < 32; j++)
-			s += input[j] * m_cos_cache[i][j];
-		output[i] = s;
+	// Plain matrix product, accumulated one band at a time over all 32
+	// outputs.  Bands past the allocated ones are always zero and would
+	// only add zeroes, so they're skipped.
+	double s[32];
+	for(int i=0; i<32; i++)
+		s[i] = 0;
+
+	for(int j=0; j<bands; j++) {
+		const double in = input[j];
+		const double *cosv = m_cos_cache[j];
+#if MPEG_AUDIO_SSE2
+		const __m128d vin = _mm_set1_pd(in);
+		for(int i=0; i<32; i+=2)
+			_mm_storeu_pd(s+i, _mm_add_pd(_mm_loadu_pd(s+i), _mm_mul_pd(vin, _mm_loadu_pd(cosv+i))));
+#else
+		for(int i=0; i<32; i++)
+			s[i] += in * cosv[i];
+#endif
 	}
+
+	memcpy(output, s, sizeof(s));
 }
 
 void mpeg_audio::resynthesis(const double *input, double *output)
 {
 	memset(output, 0, 32*sizeof(output[0]));
 	for(int j=0; j<64*8; j+=64) {
+		const double *in = input + j;
+		const double *filter = synthesis_filter + j;
+#if MPEG_AUDIO_SSE2
+		// Lanes i and i+1; the mirrored input is read backwards, so the
+		// pair loaded from in[31-i..32-i] is swapped into place.
+		for(int i=0; i<16; i+=2) {
+			__m128d a = _mm_mul_pd(_mm_loadu_pd(in+i), _mm_loadu_pd(filter+i));
+			__m128d m = _mm_loadu_pd(in+31-i);
+			__m128d b = _mm_mul_pd(_mm_shuffle_pd(m, m, 1), _mm_loadu_pd(filter+32+i));
+			_mm_storeu_pd(output+i, _mm_add_pd(_mm_loadu_pd(output+i), _mm_sub_pd(a, b)));
+		}
+		output[16] -= in[16]*filter[32+16];
+		for(int i=17; i<31; i+=2) {
+			__m128d m = _mm_loadu_pd(in+31-i);
+			__m128d a = _mm_mul_pd(_mm_shuffle_pd(m, m, 1), _mm_loadu_pd(filter+i));
+			__m128d b = _mm_mul_pd(_mm_loadu_pd(in+i), _mm_loadu_pd(filter+32+i));
+			_mm_storeu_pd(output+i, _mm_sub_pd(_mm_loadu_pd(output+i), _mm_add_pd(a, b)));
+		}
+		output[31] -= in[1]*filter[31] + in[31]*filter[32+31];
+#else
 		for(int i=0; i<16; i++)
-			output[i] += input[   i+j]*synthesis_filter[i+j] - input[32-i+j]*synthesis_filter[32+i+j];
-		output[16] -= input[16+j]*synthesis_filter[32+16+j];
+			output[i] += in[   i]*filter[i] - in[32-i]*filter[32+i];
+		output[16] -= in[16]*filter[32+16];
 		for(int i=17; i<32; i++)
-			output[i] -= input[32-i+j]*synthesis_filter[i+j] + input[   i+j]*synthesis_filter[32+i+j];
+			output[i] -= in[32-i]*filter[i] + in[   i]*filter[32+i];
+#endif
 	}
 }
 
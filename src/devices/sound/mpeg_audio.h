@@ -92,7 +92,7 @@ private:
 	double subbuffer[2][32];
 	double audio_buffer[2][32*32];
 	int audio_buffer_pos[2];
-	double m_cos_cache[32][32];
+	double m_cos_cache[32][32];     // [band][output], so one band scales a contiguous row
 
 	int current_pos, current_limit;
 
@@ -109,7 +109,7 @@ private:
 	void build_amplitudes();
 	void build_next_segments(int step);
 	void retrieve_subbuffer(int step);
-	void idct32(const double *input, double *output);
+	void idct32(const double *input, int bands, double *output);
 	void resynthesis(const double *input, double *output);
 	void scale_and_clamp(const double *input, short *output, int step);
 
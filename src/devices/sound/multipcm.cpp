@@ -71,9 +71,6 @@ const int32_t multipcm_device::VALUE_TO_CHANNEL[32] =
 	21,22,23,24,25,26,27, -1,
 };
 
-constexpr uint32_t multipcm_device::TL_SHIFT;
-constexpr uint32_t multipcm_device::EG_SHIFT;
-
 void multipcm_device::init_sample(sample_t *sample, uint32_t index)
 {
 	uint32_t address = index * 12;
@@ -92,55 +89,6 @@ void multipcm_device::init_sample(sample_t *sample, uint32_t index)
 	sample->m_lfo_amplitude_reg = read_byte(address + 11) & 0xf;
 }
 
-int32_t multipcm_device::envelope_generator_update(slot_t *slot)
-{
-	switch(slot->m_envelope_gen.m_state)
-	{
-		case state_t::ATTACK:
-			slot->m_envelope_gen.m_volume += slot->m_envelope_gen.m_attack_rate;
-			if (slot->m_envelope_gen.m_volume >= (0x3ff << EG_SHIFT))
-			{
-				slot->m_envelope_gen.m_state = state_t::DECAY1;
-				if (slot->m_envelope_gen.m_decay1_rate >= (0x400 << EG_SHIFT)) //Skip DECAY1, go directly to DECAY2
-				{
-					slot->m_envelope_gen.m_state = state_t::DECAY2;
-				}
-				slot->m_envelope_gen.m_volume = 0x3ff << EG_SHIFT;
-			}
-			break;
-		case state_t::DECAY1:
-			slot->m_envelope_gen.m_volume -= slot->m_envelope_gen.m_decay1_rate;
-			if (slot->m_envelope_gen.m_volume <= 0)
-			{
-				slot->m_envelope_gen.m_volume = 0;
-			}
-			if (slot->m_envelope_gen.m_volume >> EG_SHIFT <= (slot->m_envelope_gen.m_decay_level << 6))
-			{
-				slot->m_envelope_gen.m_state = state_t::DECAY2;
-			}
-			break;
-		case state_t::DECAY2:
-			slot->m_envelope_gen.m_volume -= slot->m_envelope_gen.m_decay2_rate;
-			if (slot->m_envelope_gen.m_volume <= 0)
-			{
-				slot->m_envelope_gen.m_volume = 0;
-			}
-			break;
-		case state_t::RELEASE:
-			slot->m_envelope_gen.m_volume -= slot->m_envelope_gen.m_release_rate;
-			if (slot->m_envelope_gen.m_volume <= 0)
-			{
-				slot->m_envelope_gen.m_volume = 0;
-				slot->m_playing = false;
-			}
-			break;
-		default:
-			return 1 << TL_SHIFT;
-	}
-
-	return m_linear_to_exp_volume[slot->m_envelope_gen.m_volume >> EG_SHIFT];
-}
-
 uint32_t multipcm_device::get_rate(uint32_t *steps, uint32_t rate, uint32_t val)
 {
 	int32_t r = 4 * val + rate;
@@ -188,8 +136,6 @@ void multipcm_device::envelope_generator_calc(slot_t *slot)
         LFO  SECTION
 *****************************/
 
-constexpr uint32_t multipcm_device::LFO_SHIFT;
-
 const float multipcm_device::LFO_FREQ[8] = // In Hertz
 {
 	0.168f,
@@ -289,22 +235,6 @@ uint32_t multipcm_device::value_to_fixed(const uint32_t bits, const float value)
 	return uint32_t(float_shift * value);
 }
 
-int32_t multipcm_device::pitch_lfo_step(lfo_t *lfo)
-{
-	lfo->m_phase += lfo->m_phase_step;
-	int32_t p = lfo->m_table[(lfo->m_phase >> LFO_SHIFT) & 0xff];
-	p = lfo->m_scale[p];
-	return p << (TL_SHIFT - LFO_SHIFT);
-}
-
-int32_t multipcm_device::amplitude_lfo_step(lfo_t *lfo)
-{
-	lfo->m_phase += lfo->m_phase_step;
-	int32_t p = lfo->m_table[(lfo->m_phase >> LFO_SHIFT) & 0xff];
-	p = lfo->m_scale[p];
-	return p << (TL_SHIFT - LFO_SHIFT);
-}
-
 void multipcm_device::lfo_compute_step(lfo_t *lfo, uint32_t lfo_frequency, uint32_t lfo_scale, int32_t amplitude_lfo)
 {
 	float step = (float)LFO_FREQ[lfo_frequency] * 256.0f / (float)m_rate;
@@ -452,16 +382,12 @@ multipcm_device::multipcm_device(const machine_config &mconfig, const char *tag,
 		device_sound_interface(mconfig, *this),
 		device_rom_interface(mconfig, *this, 24),
 		m_stream(nullptr),
-		m_slots(nullptr),
 		m_cur_slot(0),
 		m_address(0),
 		m_rate(0),
 		m_attack_step(nullptr),
 		m_decay_release_step(nullptr),
 		m_freq_step_table(nullptr),
-		m_left_pan_table(nullptr),
-		m_right_pan_table(nullptr),
-		m_linear_to_exp_volume(nullptr),
 		m_total_level_steps(nullptr),
 		m_pitch_scale_tables(nullptr),
 		m_amplitude_scale_tables(nullptr)
@@ -626,91 +552,13 @@ void multipcm_device::device_clock_changed()
 	}
 }
 
-//-----------------------------------------------------
-//  clamp_to_int16 - clamp a 32-bit value to 16 bits
-//-----------------------------------------------------
-
-int16_t multipcm_device::clamp_to_int16(int32_t value)
-{
-	if (value < -32768)
-	{
-		return -32768;
-	}
-	else if (value > 32767)
-	{
-		return 32767;
-	}
-	return (int16_t)value;
-}
-
 //-------------------------------------------------
 //  sound_stream_update - handle a stream update
 //-------------------------------------------------
 
 void multipcm_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int32_t samples)
 {
-	stream_sample_t  *datap[2];
-
-	datap[0] = outputs[0];
-	datap[1] = outputs[1];
-
-	memset(datap[0], 0, sizeof(*datap[0]) * samples);
-	memset(datap[1], 0, sizeof(*datap[1]) * samples);
-
-	for (int32_t i = 0; i < samples; ++i)
-	{
-		int32_t smpl = 0;
-		int32_t smpr = 0;
-		for (int32_t sl = 0; sl < 28; ++sl)
-		{
-			slot_t *slot = m_slots + sl;
-			if (slot->m_playing)
-			{
-				uint32_t vol = (slot->m_total_level >> TL_SHIFT) | (slot->m_pan << 7);
-				uint32_t adr = slot->m_offset >> TL_SHIFT;
-				uint32_t step = slot->m_step;
-				int32_t csample = (int16_t) (read_byte(slot->m_base + adr) << 8);
-				int32_t fpart = slot->m_offset & ((1 << TL_SHIFT) - 1);
-				int32_t sample = (csample * fpart + slot->m_prev_sample * ((1 << TL_SHIFT) - fpart)) >> TL_SHIFT;
-
-				if (slot->m_regs[6] & 7) // Vibrato enabled
-				{
-					step = step * pitch_lfo_step(&(slot->m_pitch_lfo));
-					step >>= TL_SHIFT;
-				}
-
-				slot->m_offset += step;
-				if (slot->m_offset >= (slot->m_sample.m_end << TL_SHIFT))
-				{
-					slot->m_offset = slot->m_sample.m_loop << TL_SHIFT;
-				}
-
-				if (adr ^ (slot->m_offset >> TL_SHIFT))
-				{
-					slot->m_prev_sample = csample;
-				}
-
-				if ((slot->m_total_level >> TL_SHIFT) != slot->m_dest_total_level)
-				{
-					slot->m_total_level += slot->m_total_level_step;
-				}
-
-				if (slot->m_regs[7] & 7) // Tremolo enabled
-				{
-					sample = sample * amplitude_lfo_step(&(slot->m_amplitude_lfo));
-					sample >>= TL_SHIFT;
-				}
-
-				sample = (sample * envelope_generator_update(slot)) >> 10;
-
-				smpl += (m_left_pan_table[vol] * sample) >> TL_SHIFT;
-				smpr += (m_right_pan_table[vol] * sample) >> TL_SHIFT;
-			}
-		}
-
-		datap[0][i] = clamp_to_int16(smpl);
-		datap[1][i] = clamp_to_int16(smpr);
-	}
+	update_slots(outputs, samples);
 }
 
 
@@ -0,0 +1,298 @@
+// license:BSD-3-Clause
+// copyright-holders:Miguel Angel Horna
+/***************************************************************************
+
+    multipcmslot.h
+
+    Yamaha YMW-258-F slot stepping and mixing.
+
+    This is the part of the MultiPCM that turns slot state and the
+    sample ROM into output, kept apart from the device so the block
+    update can be checked against stepping every slot once per sample
+    without a running machine.  Device is the class deriving from it,
+    and must provide read_byte(offs_t) for the sample ROM.  The device
+    owns the slots and the volume tables and points the members below
+    at them.
+
+***************************************************************************/
+
+#ifndef MAME_SOUND_MULTIPCMSLOT_H
+#define MAME_SOUND_MULTIPCMSLOT_H
+
+#pragma once
+
+#include "voicemix.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> multipcm_slots
+
+template <class Device>
+class multipcm_slots
+{
+public:
+	struct sample_t
+	{
+		uint32_t m_start;
+		uint32_t m_loop;
+		uint32_t m_end;
+		uint8_t m_attack_reg;
+		uint8_t m_decay1_reg;
+		uint8_t m_decay2_reg;
+		uint8_t m_decay_level;
+		uint8_t m_release_reg;
+		uint8_t m_key_rate_scale;
+		uint8_t m_lfo_vibrato_reg;
+		uint8_t m_lfo_amplitude_reg;
+	};
+
+	enum class state_t : u8
+	{
+		ATTACK,
+		DECAY1,
+		DECAY2,
+		RELEASE
+	};
+
+	struct envelope_gen_t
+	{
+		int32_t m_volume;
+		state_t m_state;
+		int32_t step;
+		//step vals
+		int32_t m_attack_rate;     // Attack
+		int32_t m_decay1_rate;    // Decay1
+		int32_t m_decay2_rate;    // Decay2
+		int32_t m_release_rate;     // Release
+		int32_t m_decay_level;     // Decay level
+	};
+
+	struct lfo_t
+	{
+		uint16_t m_phase;
+		uint32_t m_phase_step;
+		int32_t *m_table;
+		int32_t *m_scale;
+	};
+
+	struct slot_t
+	{
+		uint8_t m_slot_index;
+		uint8_t m_regs[8];
+		bool m_playing;
+		sample_t m_sample;
+		uint32_t m_base;
+		uint32_t m_offset;
+		uint32_t m_step;
+		uint32_t m_pan;
+		uint32_t m_total_level;
+		uint32_t m_dest_total_level;
+		int32_t m_total_level_step;
+		int32_t m_prev_sample;
+		envelope_gen_t m_envelope_gen;
+		lfo_t m_pitch_lfo; // Pitch lfo
+		lfo_t m_amplitude_lfo; // AM lfo
+	};
+
+	static constexpr uint32_t TL_SHIFT = 12;
+	static constexpr uint32_t EG_SHIFT = 16;
+	static constexpr uint32_t LFO_SHIFT = 8;
+
+	multipcm_slots();
+
+	// render a block, each playing slot over the whole block
+	void update_slots(stream_sample_t **outputs, int32_t samples);
+
+	// advance a playing slot by one sample; returns the sample before
+	// panning, and the pan table index it is to be panned with
+	int32_t step_slot(slot_t *slot, uint32_t &vol);
+
+protected:
+	// Internal LFO functions
+	int32_t pitch_lfo_step(lfo_t *lfo);
+	int32_t amplitude_lfo_step(lfo_t *lfo);
+
+	// Internal envelope functions
+	int32_t envelope_generator_update(slot_t *slot);
+
+	slot_t *m_slots;
+
+	int32_t *m_left_pan_table;
+	int32_t *m_right_pan_table;
+	int32_t *m_linear_to_exp_volume;
+
+	voice_mixer m_mixer;
+};
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+template <class Device> constexpr uint32_t multipcm_slots<Device>::TL_SHIFT;
+template <class Device> constexpr uint32_t multipcm_slots<Device>::EG_SHIFT;
+template <class Device> constexpr uint32_t multipcm_slots<Device>::LFO_SHIFT;
+
+template <class Device>
+multipcm_slots<Device>::multipcm_slots()
+	: m_slots(nullptr)
+	, m_left_pan_table(nullptr)
+	, m_right_pan_table(nullptr)
+	, m_linear_to_exp_volume(nullptr)
+	, m_mixer(2, 3)
+{
+}
+
+template <class Device>
+int32_t multipcm_slots<Device>::envelope_generator_update(slot_t *slot)
+{
+	switch(slot->m_envelope_gen.m_state)
+	{
+		case state_t::ATTACK:
+			slot->m_envelope_gen.m_volume += slot->m_envelope_gen.m_attack_rate;
+			if (slot->m_envelope_gen.m_volume >= (0x3ff << EG_SHIFT))
+			{
+				slot->m_envelope_gen.m_state = state_t::DECAY1;
+				if (slot->m_envelope_gen.m_decay1_rate >= (0x400 << EG_SHIFT)) //Skip DECAY1, go directly to DECAY2
+				{
+					slot->m_envelope_gen.m_state = state_t::DECAY2;
+				}
+				slot->m_envelope_gen.m_volume = 0x3ff << EG_SHIFT;
+			}
+			break;
+		case state_t::DECAY1:
+			slot->m_envelope_gen.m_volume -= slot->m_envelope_gen.m_decay1_rate;
+			if (slot->m_envelope_gen.m_volume <= 0)
+			{
+				slot->m_envelope_gen.m_volume = 0;
+			}
+			if (slot->m_envelope_gen.m_volume >> EG_SHIFT <= (slot->m_envelope_gen.m_decay_level << 6))
+			{
+				slot->m_envelope_gen.m_state = state_t::DECAY2;
+			}
+			break;
+		case state_t::DECAY2:
+			slot->m_envelope_gen.m_volume -= slot->m_envelope_gen.m_decay2_rate;
+			if (slot->m_envelope_gen.m_volume <= 0)
+			{
+				slot->m_envelope_gen.m_volume = 0;
+			}
+			break;
+		case state_t::RELEASE:
+			slot->m_envelope_gen.m_volume -= slot->m_envelope_gen.m_release_rate;
+			if (slot->m_envelope_gen.m_volume <= 0)
+			{
+				slot->m_envelope_gen.m_volume = 0;
+				slot->m_playing = false;
+			}
+			break;
+		default:
+			return 1 << TL_SHIFT;
+	}
+
+	return m_linear_to_exp_volume[slot->m_envelope_gen.m_volume >> EG_SHIFT];
+}
+
+template <class Device>
+int32_t multipcm_slots<Device>::pitch_lfo_step(lfo_t *lfo)
+{
+	lfo->m_phase += lfo->m_phase_step;
+	int32_t p = lfo->m_table[(lfo->m_phase >> LFO_SHIFT) & 0xff];
+	p = lfo->m_scale[p];
+	return p << (TL_SHIFT - LFO_SHIFT);
+}
+
+template <class Device>
+int32_t multipcm_slots<Device>::amplitude_lfo_step(lfo_t *lfo)
+{
+	lfo->m_phase += lfo->m_phase_step;
+	int32_t p = lfo->m_table[(lfo->m_phase >> LFO_SHIFT) & 0xff];
+	p = lfo->m_scale[p];
+	return p << (TL_SHIFT - LFO_SHIFT);
+}
+
+template <class Device>
+int32_t multipcm_slots<Device>::step_slot(slot_t *slot, uint32_t &vol)
+{
+	vol = (slot->m_total_level >> TL_SHIFT) | (slot->m_pan << 7);
+	uint32_t adr = slot->m_offset >> TL_SHIFT;
+	uint32_t step = slot->m_step;
+	int32_t csample = (int16_t) (static_cast<Device &>(*this).read_byte(slot->m_base + adr) << 8);
+	int32_t fpart = slot->m_offset & ((1 << TL_SHIFT) - 1);
+	int32_t sample = (csample * fpart + slot->m_prev_sample * ((1 << TL_SHIFT) - fpart)) >> TL_SHIFT;
+
+	if (slot->m_regs[6] & 7) // Vibrato enabled
+	{
+		step = step * pitch_lfo_step(&(slot->m_pitch_lfo));
+		step >>= TL_SHIFT;
+	}
+
+	slot->m_offset += step;
+	if (slot->m_offset >= (slot->m_sample.m_end << TL_SHIFT))
+	{
+		slot->m_offset = slot->m_sample.m_loop << TL_SHIFT;
+	}
+
+	if (adr ^ (slot->m_offset >> TL_SHIFT))
+	{
+		slot->m_prev_sample = csample;
+	}
+
+	if ((slot->m_total_level >> TL_SHIFT) != slot->m_dest_total_level)
+	{
+		slot->m_total_level += slot->m_total_level_step;
+	}
+
+	if (slot->m_regs[7] & 7) // Tremolo enabled
+	{
+		sample = sample * amplitude_lfo_step(&(slot->m_amplitude_lfo));
+		sample >>= TL_SHIFT;
+	}
+
+	return (sample * envelope_generator_update(slot)) >> 10;
+}
+
+template <class Device>
+void multipcm_slots<Device>::update_slots(stream_sample_t **outputs, int32_t samples)
+{
+	// slots share no state, so each playing one is run over the whole
+	// block and then mixed in
+	m_mixer.begin(samples);
+	int32_t *smp = m_mixer.buffer(0);
+	int32_t *left = m_mixer.buffer(1);
+	int32_t *right = m_mixer.buffer(2);
+
+	for (int32_t sl = 0; sl < 28; ++sl)
+	{
+		slot_t *slot = m_slots + sl;
+		if (!slot->m_playing)
+		{
+			continue;
+		}
+
+		for (int32_t i = 0; i < samples; ++i)
+		{
+			if (!slot->m_playing)
+			{
+				smp[i] = 0;
+				continue;
+			}
+
+			uint32_t vol;
+			smp[i] = step_slot(slot, vol);
+			left[i] = m_left_pan_table[vol];
+			right[i] = m_right_pan_table[vol];
+		}
+
+		m_mixer.mix(0, smp, left, TL_SHIFT);
+		m_mixer.mix(1, smp, right, TL_SHIFT);
+	}
+
+	m_mixer.write_clamped(0, outputs[0], 0);
+	m_mixer.write_clamped(1, outputs[1], 0);
+}
+
+#endif // MAME_SOUND_MULTIPCMSLOT_H
@@ -57,6 +57,12 @@ samples_device::samples_device(const machine_config &mconfig, device_type type,
 	, device_sound_interface(mconfig, *this)
 	, m_channels(0)
 	, m_names(nullptr)
+	, m_prefetch_queue(nullptr)
+	, m_cache_limit(0)
+	, m_cache_bytes(0)
+	, m_cache_peak(0)
+	, m_cache_clock(0)
+	, m_decodes(0)
 {
 }
 
@@ -83,7 +89,7 @@ void samples_device::start(uint8_t channel, uint32_t samplenum, bool loop)
 	chan.stream->update();
 
 	// update the parameters
-	sample_t &sample = m_sample[samplenum];
+	const sample_t &sample = fetch_sample(samplenum);
 	chan.source = (sample.data.size() > 0) ? &sample.data[0] : nullptr;
 	chan.source_length = sample.data.size();
 	chan.source_num = (chan.source_length > 0) ? samplenum : -1;
@@ -235,8 +241,30 @@ bool samples_device::playing(uint8_t channel) const
 
 void samples_device::device_start()
 {
-	// read audio samples
-	load_samples();
+	// read audio samples, or just find them if we're decoding on demand
+	osd_ticks_t const start = osd_ticks();
+	m_cache_limit = uint64_t(machine().options().sample_cache()) << 20;
+	if (m_cache_limit != 0)
+		locate_samples();
+	else
+		load_samples();
+
+	if (m_slot && !m_sample.empty())
+	{
+		// the prefetcher is still filling the sample data, so only the atomic total is safe to read
+		osd_printf_verbose("%s: %u samples located in %.1f ms, decoding on demand within %u KB (%u KB prefetched so far)\n",
+				tag(), unsigned(m_sample.size()), double(osd_ticks() - start) * 1000.0 / double(osd_ticks_per_second()),
+				unsigned(m_cache_limit >> 10), unsigned(m_cache_bytes >> 10));
+	}
+	else if (!m_sample.empty())
+	{
+		uint64_t bytes = 0;
+		for (const sample_t &sample : m_sample)
+			bytes += sample.data.size() * sizeof(int16_t);
+		osd_printf_verbose("%s: %u samples, %u KB decoded at startup in %.1f ms\n",
+				tag(), unsigned(m_sample.size()), unsigned(bytes >> 10),
+				double(osd_ticks() - start) * 1000.0 / double(osd_ticks_per_second()));
+	}
 
 	// allocate channels
 	m_channel.resize(m_channels);
@@ -269,6 +297,27 @@ void samples_device::device_start()
 }
 
 
+//-------------------------------------------------
+//  device_stop - finish any background decoding
+//-------------------------------------------------
+
+void samples_device::device_stop()
+{
+	if (m_prefetch_queue == nullptr)
+		return;
+
+	osd_work_queue_wait(m_prefetch_queue, osd_ticks_per_second() * 10);
+	for (uint32_t index = 0; index < m_sample.size(); index++)
+		if (m_slot[index].prefetch != nullptr)
+			osd_work_item_release(m_slot[index].prefetch);
+	osd_work_queue_free(m_prefetch_queue);
+	m_prefetch_queue = nullptr;
+
+	osd_printf_verbose("%s: %u samples decoded on demand, peak %u KB of %u KB allowed\n",
+			tag(), m_decodes, unsigned(std::max<uint64_t>(m_cache_peak, m_cache_bytes) >> 10), unsigned(m_cache_limit >> 10));
+}
+
+
 //-------------------------------------------------
 //  device_reset - handle device reset
 //-------------------------------------------------
@@ -293,7 +342,7 @@ void samples_device::device_post_load()
 		channel_t &chan = m_channel[channel];
 		if (chan.source_num >= 0 && chan.source_num < m_sample.size())
 		{
-			sample_t &sample = m_sample[chan.source_num];
+			const sample_t &sample = fetch_sample(chan.source_num);
 			chan.source = &sample.data[0];
 			chan.source_length = sample.data.size();
 			if (sample.data.empty())
@@ -590,6 +639,36 @@ bool samples_device::read_flac_sample(emu_file &file, sample_t &sample)
 }
 
 
+//-------------------------------------------------
+//  open_sample - open the FLAC or WAV file for a
+//  sample, optionally returning its name relative
+//  to the sample path
+//-------------------------------------------------
+
+osd_file::error samples_device::open_sample(emu_file &file, const char *samplename, std::string *filename)
+{
+	static const char *const extensions[] = { ".flac", ".wav" };
+	const char *const basenames[] = { machine().basename(), samples_iterator(*this).altbasename() };
+
+	// attempt to open as FLAC first, then WAV
+	osd_file::error filerr = osd_file::error::NOT_FOUND;
+	for (const char *extension : extensions)
+		for (const char *basename : basenames)
+		{
+			if (basename == nullptr)
+				continue;
+			filerr = file.open(basename, PATH_SEPARATOR, samplename, extension);
+			if (filerr == osd_file::error::NONE)
+			{
+				if (filename != nullptr)
+					*filename = std::string(basename).append(PATH_SEPARATOR).append(samplename).append(extension);
+				return filerr;
+			}
+		}
+	return filerr;
+}
+
+
 //-------------------------------------------------
 //  load_samples - load all the samples in our
 //  attached interface
@@ -604,9 +683,7 @@ bool samples_device::load_samples()
 		return false;
 
 	// iterate over ourself
-	const char *basename = machine().basename();
 	samples_iterator iter(*this);
-	const char *altbasename = iter.altbasename();
 
 	// pre-size the array
 	m_sample.resize(iter.count());
@@ -615,17 +692,8 @@ bool samples_device::load_samples()
 	int index = 0;
 	for (const char *samplename = iter.first(); samplename != nullptr; index++, samplename = iter.next())
 	{
-		// attempt to open as FLAC first
 		emu_file file(machine().options().sample_path(), OPEN_FLAG_READ);
-		osd_file::error filerr = file.open(basename, PATH_SEPARATOR, samplename, ".flac");
-		if (filerr != osd_file::error::NONE && altbasename != nullptr)
-			filerr = file.open(altbasename, PATH_SEPARATOR, samplename, ".flac");
-
-		// if not, try as WAV
-		if (filerr != osd_file::error::NONE)
-			filerr = file.open(basename, PATH_SEPARATOR, samplename, ".wav");
-		if (filerr != osd_file::error::NONE && altbasename != nullptr)
-			filerr = file.open(altbasename, PATH_SEPARATOR, samplename, ".wav");
+		osd_file::error filerr = open_sample(file, samplename);
 
 		// if opened, read it
 		if (filerr == osd_file::error::NONE)
@@ -638,3 +706,167 @@ bool samples_device::load_samples()
 	}
 	return ok;
 }
+
+
+//-------------------------------------------------
+//  locate_samples - find all the samples in our
+//  attached interface without decoding them, and
+//  start decoding them in the background
+//  Returns true when all samples were found, else false
+//-------------------------------------------------
+
+bool samples_device::locate_samples()
+{
+	bool ok = true;
+	// if the user doesn't want to use samples, bail
+	if (!machine().options().samples())
+		return false;
+
+	// iterate over ourself
+	samples_iterator iter(*this);
+
+	// pre-size the arrays
+	int const count = iter.count();
+	m_sample.resize(count);
+	m_slot = std::make_unique<sample_slot[]>(count);
+
+	// find the samples
+	int index = 0;
+	for (const char *samplename = iter.first(); samplename != nullptr; index++, samplename = iter.next())
+	{
+		sample_slot &slot = m_slot[index];
+		slot.device = this;
+		slot.index = index;
+		slot.state = SAMPLE_UNLOADED;
+		slot.last_used = 0;
+		slot.prefetch = nullptr;
+
+		emu_file file(machine().options().sample_path(), OPEN_FLAG_READ);
+		osd_file::error filerr = open_sample(file, samplename, &slot.filename);
+		if (filerr == osd_file::error::NOT_FOUND)
+		{
+			logerror("%s: Sample '%s' NOT FOUND\n", tag(), samplename);
+			ok = false;
+		}
+	}
+
+	// decode as much of the set as fits in the background, in order
+	m_prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_prefetch_queue != nullptr)
+		for (index = 0; index < count; index++)
+			if (!m_slot[index].filename.empty())
+				m_slot[index].prefetch = osd_work_item_queue(m_prefetch_queue, prefetch_sample, &m_slot[index], 0);
+	return ok;
+}
+
+
+//-------------------------------------------------
+//  decode_sample - decode a located sample; the
+//  caller must own the slot in SAMPLE_LOADING
+//-------------------------------------------------
+
+void samples_device::decode_sample(sample_slot &slot)
+{
+	sample_t &sample = m_sample[slot.index];
+	if (!slot.filename.empty())
+	{
+		emu_file file(machine().options().sample_path(), OPEN_FLAG_READ);
+		if (file.open(slot.filename) == osd_file::error::NONE)
+			read_sample(file, sample);
+	}
+	m_cache_bytes += sample.data.size() * sizeof(int16_t);
+	slot.state = SAMPLE_READY;
+}
+
+
+//-------------------------------------------------
+//  prefetch_sample - work callback to decode a
+//  sample ahead of its first use
+//-------------------------------------------------
+
+void *samples_device::prefetch_sample(void *param, int threadid)
+{
+	sample_slot &slot = *reinterpret_cast<sample_slot *>(param);
+	samples_device &device = *slot.device;
+
+	// stop filling once the budget is used up; the rest decode on demand
+	if (device.m_cache_bytes >= device.m_cache_limit)
+		return nullptr;
+
+	int expected = SAMPLE_UNLOADED;
+	if (slot.state.compare_exchange_strong(expected, SAMPLE_LOADING))
+		device.decode_sample(slot);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  fetch_sample - return a sample, decoding it
+//  first if needed
+//-------------------------------------------------
+
+const samples_device::sample_t &samples_device::fetch_sample(uint32_t samplenum)
+{
+	if (!m_slot)
+		return m_sample[samplenum];
+
+	sample_slot &slot = m_slot[samplenum];
+	int state = SAMPLE_UNLOADED;
+	if (slot.state.compare_exchange_strong(state, SAMPLE_LOADING))
+	{
+		// not decoded yet and nobody is working on it
+		decode_sample(slot);
+		m_decodes++;
+	}
+	else if (state == SAMPLE_LOADING)
+	{
+		// the prefetcher has it; wait for it to finish
+		while (slot.state == SAMPLE_LOADING)
+			osd_work_item_wait(slot.prefetch, osd_ticks_per_second());
+	}
+
+	slot.last_used = ++m_cache_clock;
+	m_cache_peak = std::max<uint64_t>(m_cache_peak, m_cache_bytes);
+	evict_samples(samplenum);
+	return m_sample[samplenum];
+}
+
+
+//-------------------------------------------------
+//  evict_samples - drop least recently used
+//  samples until we're within budget
+//-------------------------------------------------
+
+void samples_device::evict_samples(uint32_t keep)
+{
+	while (m_cache_bytes > m_cache_limit)
+	{
+		// find the oldest decoded sample that isn't playing
+		int victim = -1;
+		uint64_t oldest = ~uint64_t(0);
+		for (uint32_t index = 0; index < m_sample.size(); index++)
+		{
+			sample_slot &slot = m_slot[index];
+			if (index == keep || slot.state != SAMPLE_READY || m_sample[index].data.empty() || slot.last_used >= oldest)
+				continue;
+
+			bool playing = false;
+			for (const channel_t &chan : m_channel)
+				if (chan.source_num == int32_t(index))
+					playing = true;
+			if (!playing)
+			{
+				victim = index;
+				oldest = slot.last_used;
+			}
+		}
+		if (victim < 0)
+			break;
+
+		// release its data; it will be decoded again if started
+		std::vector<int16_t> &data = m_sample[victim].data;
+		m_cache_bytes -= data.size() * sizeof(int16_t);
+		std::vector<int16_t>().swap(data);
+		m_slot[victim].state = SAMPLE_UNLOADED;
+	}
+}
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -94,6 +97,7 @@ protected:
 
 	// device-level overrides
 	virtual void device_start() override;
+	virtual void device_stop() override;
 	virtual void device_reset() override;
 	virtual void device_post_load() override;
 
@@ -115,10 +119,34 @@ protected:
 		bool            paused;
 	};
 
+	// on-demand decoding state for one sample
+	enum
+	{
+		SAMPLE_UNLOADED,
+		SAMPLE_LOADING,
+		SAMPLE_READY
+	};
+
+	struct sample_slot
+	{
+		samples_device *    device;
+		uint32_t            index;
+		std::string         filename;       // file to decode from, empty if not found
+		std::atomic<int>    state;
+		uint64_t            last_used;
+		osd_work_item *     prefetch;
+	};
+
 	// internal helpers
 	static bool read_wav_sample(emu_file &file, sample_t &sample);
 	static bool read_flac_sample(emu_file &file, sample_t &sample);
+	osd_file::error open_sample(emu_file &file, const char *samplename, std::string *filename = nullptr);
 	bool load_samples();
+	bool locate_samples();
+	void decode_sample(sample_slot &slot);
+	const sample_t &fetch_sample(uint32_t samplenum);
+	void evict_samples(uint32_t keep);
+	static void *prefetch_sample(void *param, int threadid);
 
 	start_cb_delegate m_samples_start_cb; // optional callback
 
@@ -126,6 +154,15 @@ protected:
 	std::vector<channel_t>    m_channel;
 	std::vector<sample_t>     m_sample;
 
+	// on-demand decoding
+	std::unique_ptr<sample_slot[]> m_slot;      // per-sample state, null when everything is decoded up front
+	osd_work_queue *          m_prefetch_queue;
+	uint64_t                  m_cache_limit;    // bytes of decoded data to keep around
+	std::atomic<uint64_t>     m_cache_bytes;
+	uint64_t                  m_cache_peak;
+	uint64_t                  m_cache_clock;
+	uint32_t                  m_decodes;
+
 	// internal constants
 	static constexpr uint8_t FRAC_BITS = 24;
 	static constexpr uint32_t FRAC_ONE = 1 << FRAC_BITS;
@@ -0,0 +1,92 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont, superctr
+/***************************************************************************
+
+    voicemix.cpp
+
+    Block-based voice mixing helper for multi-voice PCM devices.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "voicemix.h"
+
+
+//-------------------------------------------------
+//  voice_mixer - constructor
+//-------------------------------------------------
+
+voice_mixer::voice_mixer(int outputs, int buffers)
+	: m_outputs(outputs)
+	, m_buffer_count(buffers)
+	, m_samples(0)
+	, m_stride(0)
+{
+}
+
+
+//-------------------------------------------------
+//  begin - size the buffers for a block and clear
+//  the accumulators
+//-------------------------------------------------
+
+void voice_mixer::begin(int samples)
+{
+	// grow the buffers in steps, they're reused across updates
+	if (samples > m_stride)
+	{
+		m_stride = (samples + 255) & ~255;
+		m_accum.resize(m_outputs * m_stride);
+		m_buffers.resize(m_buffer_count * m_stride);
+	}
+	m_samples = samples;
+
+	for (int output = 0; output < m_outputs; output++)
+		std::fill_n(accumulator(output), samples, 0);
+}
+
+
+//-------------------------------------------------
+//  mix - add a rendered voice to an output with a
+//  per-sample or constant gain
+//-------------------------------------------------
+
+void voice_mixer::mix(int output, const int32_t *source, const int32_t *gain, int shift)
+{
+	int32_t *const accum = accumulator(output);
+	for (int i = 0; i < m_samples; i++)
+		accum[i] += (source[i] * gain[i]) >> shift;
+}
+
+void voice_mixer::mix(int output, const int32_t *source, int32_t gain, int shift)
+{
+	int32_t *const accum = accumulator(output);
+	for (int i = 0; i < m_samples; i++)
+		accum[i] += (source[i] * gain) >> shift;
+}
+
+
+//-------------------------------------------------
+//  write - scale an accumulator down and store it
+//  as 16-bit samples, wrapping on overflow
+//-------------------------------------------------
+
+void voice_mixer::write(int output, stream_sample_t *dest, int shift)
+{
+	const int32_t *const accum = accumulator(output);
+	for (int i = 0; i < m_samples; i++)
+		dest[i] = int16_t(accum[i] >> shift);
+}
+
+
+//-------------------------------------------------
+//  write_clamped - scale an accumulator down and
+//  store it as 16-bit samples, saturating
+//-------------------------------------------------
+
+void voice_mixer::write_clamped(int output, stream_sample_t *dest, int shift)
+{
+	const int32_t *const accum = accumulator(output);
+	for (int i = 0; i < m_samples; i++)
+		dest[i] = std::max(-32768, std::min(32767, accum[i] >> shift));
+}
@@ -0,0 +1,66 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont, superctr
+/***************************************************************************
+
+    voicemix.h
+
+    Block-based voice mixing helper for multi-voice PCM devices.
+
+    Instead of stepping every voice once per output sample, a device
+    renders one voice at a time over the whole update into a set of
+    per-sample scratch buffers (sample value, gain per output), then
+    mixes that voice into per-output accumulators.  Idle voices cost
+    nothing, the per-voice state stays in registers for the whole
+    block, and the mixing loops work on plain arrays the compiler can
+    vectorise.
+
+    All arithmetic is integer and matches what the devices did per
+    sample, so results are sample-exact provided voices don't share
+    state that depends on the order they're stepped in.
+
+***************************************************************************/
+
+#ifndef MAME_SOUND_VOICEMIX_H
+#define MAME_SOUND_VOICEMIX_H
+
+#pragma once
+
+#include <vector>
+
+
+// ======================> voice_mixer
+
+class voice_mixer
+{
+public:
+	// construction/destruction
+	voice_mixer(int outputs, int buffers);
+
+	// start a block; clears the accumulators
+	void begin(int samples);
+
+	// accessors
+	int samples() const { return m_samples; }
+	int32_t *buffer(int index) { return &m_buffers[index * m_stride]; }
+	int32_t *accumulator(int output) { return &m_accum[output * m_stride]; }
+
+	// mixing: accum += (source * gain) >> shift
+	void mix(int output, const int32_t *source, const int32_t *gain, int shift);
+	void mix(int output, const int32_t *source, int32_t gain, int shift);
+
+	// output: dest = int16_t(accum >> shift), wrapping or saturating
+	void write(int output, stream_sample_t *dest, int shift);
+	void write_clamped(int output, stream_sample_t *dest, int shift);
+
+private:
+	// internal state
+	int                   m_outputs;
+	int                   m_buffer_count;
+	int                   m_samples;
+	int                   m_stride;
+	std::vector<int32_t>  m_accum;
+	std::vector<int32_t>  m_buffers;
+};
+
+
+#endif // MAME_SOUND_VOICEMIX_H
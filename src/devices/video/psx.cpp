@@ -36,6 +36,15 @@ void psxgpu_device::device_start()
 {
 	m_vblank_handler.resolve_safe();
 
+	m_render_queue = osd_work_queue_alloc( WORK_QUEUE_FLAG_HIGH_FREQ );
+	m_render_batch_index = 0;
+	for( render_batch &batch : m_render_batch )
+	{
+		batch.gpu = this;
+		batch.item = nullptr;
+		batch.commands.reserve( RENDER_BATCH_SIZE );
+	}
+
 	if (type() == CXD8538Q)
 	{
 		psx_gpu_init( 1 );
@@ -46,8 +55,15 @@ void psxgpu_device::device_start()
 	}
 }
 
+void psxgpu_device::device_stop()
+{
+	render_sync();
+	osd_work_queue_free( m_render_queue );
+}
+
 void psxgpu_device::device_reset()
 {
+	render_sync();
 	gpu_reset();
 }
 
@@ -568,7 +584,7 @@ void psxgpu_device::psx_gpu_init( int n_gputype )
 	}
 
 	// icky!!!
-	machine().save().save_memory( this, "globals", nullptr, 0, "m_packet", (uint8_t *)&m_packet, 1, sizeof( m_packet ) );
+	machine().save().save_memory( this, "globals", nullptr, 0, "m_packet", (uint8_t *)&m_command, 1, sizeof( m_command ) );
 
 	save_pointer(NAME(p_vram.get()), width * height );
 	save_item(NAME(n_gpu_buffer_offset));
@@ -602,7 +618,9 @@ void psxgpu_device::psx_gpu_init( int n_gputype )
 	save_item(NAME(n_iy));
 	save_item(NAME(n_ti));
 
-	machine().save().register_postload( save_prepost_delegate( FUNC( psxgpu_device::updatevisiblearea ), this ) );
+	machine().save().register_presave( save_prepost_delegate( FUNC( psxgpu_device::render_sync ), this ) );
+	machine().save().register_preload( save_prepost_delegate( FUNC( psxgpu_device::render_discard ), this ) );
+	machine().save().register_postload( save_prepost_delegate( FUNC( psxgpu_device::postload ), this ) );
 }
 
 uint32_t psxgpu_device::update_screen(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect)
@@ -630,6 +648,8 @@ uint32_t psxgpu_device::update_screen(screen_device &screen, bitmap_ind16 &bitma
 	}
 #endif
 
+	render_sync();
+
 	if( ( n_gpustatus & ( 1 << 0x17 ) ) != 0 )
 	{
 		/* todo: only draw to necessary area */
@@ -775,12 +795,22 @@ f  e| d  c| b| a  9| 8  7| 6  5| 4| 3  2  1  0
     |iy|ix|ty|     |   tp|  abr|ty|         tx
 */
 
-void psxgpu_device::decode_tpage( uint32_t tpage )
+void psxgpu_device::update_tpage_status( uint32_t tpage )
 {
 	if( m_n_gputype == 2 )
 	{
 		n_gpustatus = ( n_gpustatus & 0xfffff800 ) | ( tpage & 0x7ff );
+	}
+	else
+	{
+		n_gpustatus = ( n_gpustatus & 0xffffe000 ) | ( tpage & 0x1fff );
+	}
+}
 
+void psxgpu_device::decode_tpage( uint32_t tpage )
+{
+	if( m_n_gputype == 2 )
+	{
 		m_n_tx = ( tpage & 0x0f ) << 6;
 		m_n_ty = ( ( tpage & 0x10 ) << 4 ) | ( ( tpage & 0x800 ) >> 2 );
 		n_abr = ( tpage & 0x60 ) >> 5;
@@ -799,8 +829,6 @@ void psxgpu_device::decode_tpage( uint32_t tpage )
 	}
 	else
 	{
-		n_gpustatus = ( n_gpustatus & 0xffffe000 ) | ( tpage & 0x1fff );
-
 		m_n_tx = ( tpage & 0x0f ) << 6;
 		m_n_ty = ( ( tpage & 0x60 ) << 3 );
 		n_abr = ( tpage & 0x180 ) >> 7;
@@ -3035,6 +3063,281 @@ void psxgpu_device::MoveImage()
 	}
 }
 
+void psxgpu_device::execute_command( const PACKET &packet )
+{
+	m_packet = packet;
+
+	switch( m_packet.n_entry[ 0 ] >> 24 )
+	{
+	case 0x02:
+		FrameBufferRectangleDraw();
+		break;
+	case 0x20:
+	case 0x21:
+	case 0x22:
+	case 0x23:
+		FlatPolygon( 3 );
+		break;
+	case 0x24:
+	case 0x25:
+	case 0x26:
+	case 0x27:
+		FlatTexturedPolygon( 3 );
+		break;
+	case 0x28:
+	case 0x29:
+	case 0x2a:
+	case 0x2b:
+		FlatPolygon( 4 );
+		break;
+	case 0x2c:
+	case 0x2d:
+	case 0x2e:
+	case 0x2f:
+		FlatTexturedPolygon( 4 );
+		break;
+	case 0x30:
+	case 0x31:
+	case 0x32:
+	case 0x33:
+		GouraudPolygon( 3 );
+		break;
+	case 0x34:
+	case 0x35:
+	case 0x36:
+	case 0x37:
+		GouraudTexturedPolygon( 3 );
+		break;
+	case 0x38:
+	case 0x39:
+	case 0x3a:
+	case 0x3b:
+		GouraudPolygon( 4 );
+		break;
+	case 0x3c:
+	case 0x3d:
+	case 0x3e:
+	case 0x3f:
+		GouraudTexturedPolygon( 4 );
+		break;
+	case 0x40:
+	case 0x41:
+	case 0x42:
+	case 0x48:
+	case 0x4a:
+	case 0x4c:
+	case 0x4e:
+		MonochromeLine();
+		break;
+	case 0x50:
+	case 0x51:
+	case 0x52:
+	case 0x53:
+	case 0x58:
+	case 0x5a:
+	case 0x5c:
+	case 0x5e:
+		GouraudLine();
+		break;
+	case 0x60:
+	case 0x61:
+	case 0x62:
+	case 0x63:
+		FlatRectangle();
+		break;
+	case 0x64:
+	case 0x65:
+	case 0x66:
+	case 0x67:
+		FlatTexturedRectangle();
+		break;
+	case 0x68:
+	case 0x6a:
+		Dot();
+		break;
+	case 0x70:
+	case 0x71:
+		FlatRectangle8x8();
+		break;
+	case 0x74:
+	case 0x75:
+	case 0x76:
+	case 0x77:
+		Sprite8x8();
+		break;
+	case 0x78:
+	case 0x79:
+		FlatRectangle16x16();
+		break;
+	case 0x7c:
+	case 0x7d:
+	case 0x7e:
+	case 0x7f:
+		Sprite16x16();
+		break;
+	case 0x80:
+		MoveImage();
+		break;
+	case 0xe1:
+		decode_tpage( m_packet.n_entry[ 0 ] & 0xffffff );
+		break;
+	case 0xe2:
+		n_twy = ( ( ( m_packet.n_entry[ 0 ] >> 15 ) & 0x1f ) << 3 );
+		n_twx = ( ( ( m_packet.n_entry[ 0 ] >> 10 ) & 0x1f ) << 3 );
+		n_twh = 255 - ( ( ( m_packet.n_entry[ 0 ] >> 5 ) & 0x1f ) << 3 );
+		n_tww = 255 - ( ( m_packet.n_entry[ 0 ] & 0x1f ) << 3 );
+		break;
+	case 0xe3:
+		n_drawarea_x1 = m_packet.n_entry[ 0 ] & 1023;
+		if( m_n_gputype == 2 )
+		{
+			n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
+		}
+		else
+		{
+			n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
+		}
+		break;
+	case 0xe4:
+		n_drawarea_x2 = m_packet.n_entry[ 0 ] & 1023;
+		if( m_n_gputype == 2 )
+		{
+			n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
+		}
+		else
+		{
+			n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
+		}
+		break;
+	case 0xe5:
+		n_drawoffset_x = SINT11( m_packet.n_entry[ 0 ] & 2047 );
+		if( m_n_gputype == 2 )
+		{
+			n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 11 ) & 2047 );
+		}
+		else
+		{
+			n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 12 ) & 2047 );
+		}
+		break;
+	}
+}
+
+/*
+    Drawing commands and the state they depend on are collected into
+    batches which are rasterized in order on a worker thread, so the CPU
+    can carry on while the GPU draws.  Anything that looks at VRAM or the
+    drawing state from the CPU side has to call render_sync() first.
+*/
+
+void *psxgpu_device::render_batch_callback( void *param, int threadid )
+{
+	render_batch *batch = (render_batch *)param;
+
+	for( const PACKET &packet : batch->commands )
+	{
+		batch->gpu->execute_command( packet );
+	}
+	return nullptr;
+}
+
+void psxgpu_device::queue_command()
+{
+#if PSXGPU_DEBUG_VIEWER
+	execute_command( m_command );
+#else
+	render_batch &batch = m_render_batch[ m_render_batch_index ];
+
+	batch.commands.push_back( m_command );
+	if( batch.commands.size() >= RENDER_BATCH_SIZE )
+	{
+		render_submit();
+	}
+#endif
+}
+
+void psxgpu_device::render_submit()
+{
+	render_batch &batch = m_render_batch[ m_render_batch_index ];
+
+	if( batch.commands.empty() )
+	{
+		return;
+	}
+
+	batch.item = osd_work_item_queue( m_render_queue, render_batch_callback, &batch, 0 );
+	m_render_batch_index = ( m_render_batch_index + 1 ) % RENDER_BATCHES;
+
+	// wait for the oldest batch so its buffer can be refilled
+	render_batch &next = m_render_batch[ m_render_batch_index ];
+	if( next.item != nullptr )
+	{
+		osd_work_item_wait( next.item, osd_ticks_per_second() * 100 );
+		osd_work_item_release( next.item );
+		next.item = nullptr;
+		next.commands.clear();
+	}
+}
+
+void psxgpu_device::render_sync()
+{
+	for( render_batch &batch : m_render_batch )
+	{
+		if( batch.item != nullptr )
+		{
+			osd_work_item_wait( batch.item, osd_ticks_per_second() * 100 );
+			osd_work_item_release( batch.item );
+			batch.item = nullptr;
+			batch.commands.clear();
+		}
+	}
+
+	// nothing was submitted if everything still fits in the current batch,
+	// so just run it here rather than round-tripping through the worker
+	render_batch &batch = m_render_batch[ m_render_batch_index ];
+	for( const PACKET &packet : batch.commands )
+	{
+		execute_command( packet );
+	}
+	batch.commands.clear();
+}
+
+/*
+    A state load replaces VRAM and the drawing state wholesale, so nothing
+    queued before it may draw afterwards: wait for whatever the worker has
+    already been handed, then drop every batch without running it.
+*/
+
+void psxgpu_device::render_discard()
+{
+	for( render_batch &batch : m_render_batch )
+	{
+		if( batch.item != nullptr )
+		{
+			osd_work_item_wait( batch.item, osd_ticks_per_second() * 100 );
+			osd_work_item_release( batch.item );
+			batch.item = nullptr;
+		}
+		batch.commands.clear();
+	}
+	m_render_batch_index = 0;
+}
+
+void psxgpu_device::postload()
+{
+	// render_discard ran before the state was read, so nothing can be
+	// left to draw over the loaded VRAM
+	for( const render_batch &batch : m_render_batch )
+	{
+		if( batch.item != nullptr || !batch.commands.empty() )
+		{
+			fatalerror( "%s: drawing was queued while a state was loading\n", tag() );
+		}
+	}
+
+	updatevisiblearea();
+}
+
 void psxgpu_device::dma_write( uint32_t *p_n_psxram, uint32_t n_address, int32_t n_size )
 {
 	gpu_write( &p_n_psxram[ n_address / 4 ], n_size );
@@ -3047,8 +3350,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 		uint32_t data = *( p_ram );
 
 		verboselog( *this, 2, "PSX Packet #%u %08x\n", n_gpu_buffer_offset, data );
-		m_packet.n_entry[ n_gpu_buffer_offset ] = data;
-		switch( m_packet.n_entry[ 0 ] >> 24 )
+		m_command.n_entry[ n_gpu_buffer_offset ] = data;
+		switch( m_command.n_entry[ 0 ] >> 24 )
 		{
 		case 0x00:
 			verboselog( *this, 1, "not handled: GPU Command 0x00: (%08x)\n", data );
@@ -3063,9 +3366,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: frame buffer rectangle %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 1 ] & 0xffff, m_packet.n_entry[ 1 ] >> 16, m_packet.n_entry[ 2 ] & 0xffff, m_packet.n_entry[ 2 ] >> 16 );
-				FrameBufferRectangleDraw();
+				verboselog( *this, 1, "%02x: frame buffer rectangle %u,%u %u,%u\n", m_command.n_entry[ 0 ] >> 24,
+					m_command.n_entry[ 1 ] & 0xffff, m_command.n_entry[ 1 ] >> 16, m_command.n_entry[ 2 ] & 0xffff, m_command.n_entry[ 2 ] >> 16 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3079,8 +3382,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatPolygon( 3 );
+				verboselog( *this, 1, "%02x: monochrome 3 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3094,8 +3397,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: textured 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatTexturedPolygon( 3 );
+				verboselog( *this, 1, "%02x: textured 3 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				update_tpage_status( m_command.FlatTexturedPolygon.vertex[ 1 ].n_texture.w.h );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3109,8 +3413,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatPolygon( 4 );
+				verboselog( *this, 1, "%02x: monochrome 4 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3124,8 +3428,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: textured 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				FlatTexturedPolygon( 4 );
+				verboselog( *this, 1, "%02x: textured 4 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				update_tpage_status( m_command.FlatTexturedPolygon.vertex[ 1 ].n_texture.w.h );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3139,8 +3444,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudPolygon( 3 );
+				verboselog( *this, 1, "%02x: gouraud 3 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3154,8 +3459,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud textured 3 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudTexturedPolygon( 3 );
+				verboselog( *this, 1, "%02x: gouraud textured 3 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				update_tpage_status( m_command.GouraudTexturedPolygon.vertex[ 1 ].n_texture.w.h );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3169,8 +3475,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudPolygon( 4 );
+				verboselog( *this, 1, "%02x: gouraud 4 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3184,8 +3490,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud textured 4 point polygon\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudTexturedPolygon( 4 );
+				verboselog( *this, 1, "%02x: gouraud textured 4 point polygon\n", m_command.n_entry[ 0 ] >> 24 );
+				update_tpage_status( m_command.GouraudTexturedPolygon.vertex[ 1 ].n_texture.w.h );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3198,8 +3505,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome line\n", m_packet.n_entry[ 0 ] >> 24 );
-				MonochromeLine();
+				verboselog( *this, 1, "%02x: monochrome line\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3213,12 +3520,12 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: monochrome polyline\n", m_packet.n_entry[ 0 ] >> 24 );
-				MonochromeLine();
-				if( ( m_packet.n_entry[ 3 ] & 0xf000f000 ) != 0x50005000 )
+				verboselog( *this, 1, "%02x: monochrome polyline\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
+				if( ( m_command.n_entry[ 3 ] & 0xf000f000 ) != 0x50005000 )
 				{
-					m_packet.n_entry[ 1 ] = m_packet.n_entry[ 2 ];
-					m_packet.n_entry[ 2 ] = m_packet.n_entry[ 3 ];
+					m_command.n_entry[ 1 ] = m_command.n_entry[ 2 ];
+					m_command.n_entry[ 2 ] = m_command.n_entry[ 3 ];
 					n_gpu_buffer_offset = 3;
 				}
 				else
@@ -3237,8 +3544,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud line\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudLine();
+				verboselog( *this, 1, "%02x: gouraud line\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3247,20 +3554,20 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 		case 0x5c:
 		case 0x5e:
 			if( n_gpu_buffer_offset < 5 &&
-				( n_gpu_buffer_offset != 4 || ( m_packet.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 ) )
+				( n_gpu_buffer_offset != 4 || ( m_command.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 ) )
 			{
 				n_gpu_buffer_offset++;
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: gouraud polyline\n", m_packet.n_entry[ 0 ] >> 24 );
-				GouraudLine();
-				if( ( m_packet.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 )
+				verboselog( *this, 1, "%02x: gouraud polyline\n", m_command.n_entry[ 0 ] >> 24 );
+				queue_command();
+				if( ( m_command.n_entry[ 4 ] & 0xf000f000 ) != 0x50005000 )
 				{
-					m_packet.n_entry[ 0 ] = ( m_packet.n_entry[ 0 ] & 0xff000000 ) | ( m_packet.n_entry[ 2 ] & 0x00ffffff );
-					m_packet.n_entry[ 1 ] = m_packet.n_entry[ 3 ];
-					m_packet.n_entry[ 2 ] = m_packet.n_entry[ 4 ];
-					m_packet.n_entry[ 3 ] = m_packet.n_entry[ 5 ];
+					m_command.n_entry[ 0 ] = ( m_command.n_entry[ 0 ] & 0xff000000 ) | ( m_command.n_entry[ 2 ] & 0x00ffffff );
+					m_command.n_entry[ 1 ] = m_command.n_entry[ 3 ];
+					m_command.n_entry[ 2 ] = m_command.n_entry[ 4 ];
+					m_command.n_entry[ 3 ] = m_command.n_entry[ 5 ];
 					n_gpu_buffer_offset = 4;
 				}
 				else
@@ -3280,10 +3587,10 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog( *this, 1, "%02x: rectangle %d,%d %d,%d\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					(int16_t)( m_packet.n_entry[ 2 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 2 ] >> 16 ) );
-				FlatRectangle();
+					m_command.n_entry[ 0 ] >> 24,
+					(int16_t)( m_command.n_entry[ 1 ] & 0xffff ), (int16_t)( m_command.n_entry[ 1 ] >> 16 ),
+					(int16_t)( m_command.n_entry[ 2 ] & 0xffff ), (int16_t)( m_command.n_entry[ 2 ] >> 16 ) );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3298,11 +3605,11 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog( *this, 1, "%02x: sprite %d,%d %u,%u %08x, %08x\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					m_packet.n_entry[ 3 ] & 0xffff, m_packet.n_entry[ 3 ] >> 16,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 2 ] );
-				FlatTexturedRectangle();
+					m_command.n_entry[ 0 ] >> 24,
+					(int16_t)( m_command.n_entry[ 1 ] & 0xffff ), (int16_t)( m_command.n_entry[ 1 ] >> 16 ),
+					m_command.n_entry[ 3 ] & 0xffff, m_command.n_entry[ 3 ] >> 16,
+					m_command.n_entry[ 0 ], m_command.n_entry[ 2 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3315,10 +3622,10 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				verboselog( *this, 1, "%02x: dot %d,%d %08x\n",
-					m_packet.n_entry[ 0 ] >> 24,
-					(int16_t)( m_packet.n_entry[ 1 ] & 0xffff ), (int16_t)( m_packet.n_entry[ 1 ] >> 16 ),
-					m_packet.n_entry[ 0 ] & 0xffffff );
-				Dot();
+					m_command.n_entry[ 0 ] >> 24,
+					(int16_t)( m_command.n_entry[ 1 ] & 0xffff ), (int16_t)( m_command.n_entry[ 1 ] >> 16 ),
+					m_command.n_entry[ 0 ] & 0xffffff );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3331,9 +3638,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ] );
-				FlatRectangle8x8();
+				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_command.n_entry[ 0 ] >> 24,
+					m_command.n_entry[ 0 ], m_command.n_entry[ 1 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3347,9 +3654,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 8x8 sprite %08x %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ], m_packet.n_entry[ 2 ] );
-				Sprite8x8();
+				verboselog( *this, 1, "%02x: 8x8 sprite %08x %08x %08x\n", m_command.n_entry[ 0 ] >> 24,
+					m_command.n_entry[ 0 ], m_command.n_entry[ 1 ], m_command.n_entry[ 2 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3362,9 +3669,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ] );
-				FlatRectangle16x16();
+				verboselog( *this, 1, "%02x: 16x16 rectangle %08x %08x\n", m_command.n_entry[ 0 ] >> 24,
+					m_command.n_entry[ 0 ], m_command.n_entry[ 1 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3378,9 +3685,9 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: 16x16 sprite %08x %08x %08x\n", m_packet.n_entry[ 0 ] >> 24,
-					m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ], m_packet.n_entry[ 2 ] );
-				Sprite16x16();
+				verboselog( *this, 1, "%02x: 16x16 sprite %08x %08x %08x\n", m_command.n_entry[ 0 ] >> 24,
+					m_command.n_entry[ 0 ], m_command.n_entry[ 1 ], m_command.n_entry[ 2 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3391,8 +3698,8 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "move image in frame buffer %08x %08x %08x %08x\n", m_packet.n_entry[ 0 ], m_packet.n_entry[ 1 ], m_packet.n_entry[ 2 ], m_packet.n_entry[ 3 ] );
-				MoveImage();
+				verboselog( *this, 1, "move image in frame buffer %08x %08x %08x %08x\n", m_command.n_entry[ 0 ], m_command.n_entry[ 1 ], m_command.n_entry[ 2 ], m_command.n_entry[ 3 ] );
+				queue_command();
 				n_gpu_buffer_offset = 0;
 			}
 			break;
@@ -3404,27 +3711,28 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			else
 			{
 				uint32_t n_pixel;
+				render_sync();
 				for( n_pixel = 0; n_pixel < 2; n_pixel++ )
 				{
 					uint16_t *p_vram;
 
 					verboselog( *this, 2, "send image to framebuffer ( pixel %u,%u = %u )\n",
-						( n_vramx + m_packet.n_entry[ 1 ] ) & 1023,
-						( n_vramy + ( m_packet.n_entry[ 1 ] >> 16 ) ) & 1023,
+						( n_vramx + m_command.n_entry[ 1 ] ) & 1023,
+						( n_vramy + ( m_command.n_entry[ 1 ] >> 16 ) ) & 1023,
 						data & 0xffff );
 
-					p_vram = p_p_vram[ ( n_vramy + ( m_packet.n_entry[ 1 ] >> 16 ) ) & 1023 ] + ( ( n_vramx + m_packet.n_entry[ 1 ] ) & 1023 );
+					p_vram = p_p_vram[ ( n_vramy + ( m_command.n_entry[ 1 ] >> 16 ) ) & 1023 ] + ( ( n_vramx + m_command.n_entry[ 1 ] ) & 1023 );
 					WRITE_PIXEL( data & 0xffff );
 					n_vramx++;
-					if( n_vramx >= ( m_packet.n_entry[ 2 ] & 0xffff ) )
+					if( n_vramx >= ( m_command.n_entry[ 2 ] & 0xffff ) )
 					{
 						n_vramx = 0;
 						n_vramy++;
-						if( n_vramy >= ( m_packet.n_entry[ 2 ] >> 16 ) )
+						if( n_vramy >= ( m_command.n_entry[ 2 ] >> 16 ) )
 						{
-							verboselog( *this, 1, "%02x: send image to framebuffer %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
-								m_packet.n_entry[ 1 ] & 0xffff, ( m_packet.n_entry[ 1 ] >> 16 ),
-								m_packet.n_entry[ 2 ] & 0xffff, ( m_packet.n_entry[ 2 ] >> 16 ) );
+							verboselog( *this, 1, "%02x: send image to framebuffer %u,%u %u,%u\n", m_command.n_entry[ 0 ] >> 24,
+								m_command.n_entry[ 1 ] & 0xffff, ( m_command.n_entry[ 1 ] >> 16 ),
+								m_command.n_entry[ 2 ] & 0xffff, ( m_command.n_entry[ 2 ] >> 16 ) );
 							n_gpu_buffer_offset = 0;
 							n_vramx = 0;
 							n_vramy = 0;
@@ -3442,79 +3750,39 @@ void psxgpu_device::gpu_write( uint32_t *p_ram, int32_t n_size )
 			}
 			else
 			{
-				verboselog( *this, 1, "%02x: copy image from frame buffer\n", m_packet.n_entry[ 0 ] >> 24 );
+				verboselog( *this, 1, "%02x: copy image from frame buffer\n", m_command.n_entry[ 0 ] >> 24 );
 				n_gpustatus |= ( 1L << 0x1b );
 			}
 			break;
 		case 0xe1:
-			verboselog( *this, 1, "%02x: draw mode %06x\n", m_packet.n_entry[ 0 ] >> 24,
-				m_packet.n_entry[ 0 ] & 0xffffff );
-			decode_tpage( m_packet.n_entry[ 0 ] & 0xffffff );
+			verboselog( *this, 1, "%02x: draw mode %06x\n", m_command.n_entry[ 0 ] >> 24,
+				m_command.n_entry[ 0 ] & 0xffffff );
+			update_tpage_status( m_command.n_entry[ 0 ] & 0xffffff );
+			queue_command();
 			break;
 		case 0xe2:
-			n_twy = ( ( ( m_packet.n_entry[ 0 ] >> 15 ) & 0x1f ) << 3 );
-			n_twx = ( ( ( m_packet.n_entry[ 0 ] >> 10 ) & 0x1f ) << 3 );
-			n_twh = 255 - ( ( ( m_packet.n_entry[ 0 ] >> 5 ) & 0x1f ) << 3 );
-			n_tww = 255 - ( ( m_packet.n_entry[ 0 ] & 0x1f ) << 3 );
-			verboselog( *this, 1, "%02x: texture window %u,%u %u,%u\n", m_packet.n_entry[ 0 ] >> 24,
-				n_twx, n_twy, n_tww, n_twh );
-			break;
 		case 0xe3:
-			n_drawarea_x1 = m_packet.n_entry[ 0 ] & 1023;
-			if( m_n_gputype == 2 )
-			{
-				n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
-			}
-			else
-			{
-				n_drawarea_y1 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
-			}
-			verboselog( *this, 1, "%02x: drawing area top left %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
-				n_drawarea_x1, n_drawarea_y1 );
-			break;
 		case 0xe4:
-			n_drawarea_x2 = m_packet.n_entry[ 0 ] & 1023;
-			if( m_n_gputype == 2 )
-			{
-				n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 10 ) & 1023;
-			}
-			else
-			{
-				n_drawarea_y2 = ( m_packet.n_entry[ 0 ] >> 12 ) & 1023;
-			}
-			verboselog( *this, 1, "%02x: drawing area bottom right %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
-				n_drawarea_x2, n_drawarea_y2 );
-			break;
 		case 0xe5:
-			n_drawoffset_x = SINT11( m_packet.n_entry[ 0 ] & 2047 );
-			if( m_n_gputype == 2 )
-			{
-				n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 11 ) & 2047 );
-			}
-			else
-			{
-				n_drawoffset_y = SINT11( ( m_packet.n_entry[ 0 ] >> 12 ) & 2047 );
-			}
-			verboselog( *this, 1, "%02x: drawing offset %d,%d\n", m_packet.n_entry[ 0 ] >> 24,
-				n_drawoffset_x, n_drawoffset_y );
+			queue_command();
 			break;
 		case 0xe6:
 			n_gpustatus &= ~( 3L << 0xb );
 			n_gpustatus |= ( data & 0x03 ) << 0xb;
-			if( ( m_packet.n_entry[ 0 ] & 3 ) != 0 )
+			if( ( m_command.n_entry[ 0 ] & 3 ) != 0 )
 			{
-				verboselog( *this, 1, "not handled: mask setting %d\n", m_packet.n_entry[ 0 ] & 3 );
+				verboselog( *this, 1, "not handled: mask setting %d\n", m_command.n_entry[ 0 ] & 3 );
 			}
 			else
 			{
-				verboselog( *this, 1, "mask setting %d\n", m_packet.n_entry[ 0 ] & 3 );
+				verboselog( *this, 1, "mask setting %d\n", m_command.n_entry[ 0 ] & 3 );
 			}
 			break;
 		default:
 #if defined( MAME_DEBUG )
-			popmessage( "unknown GPU packet %08x", m_packet.n_entry[ 0 ] );
+			popmessage( "unknown GPU packet %08x", m_command.n_entry[ 0 ] );
 #endif
-			verboselog( *this, 0, "unknown GPU packet %08x (%08x)\n", m_packet.n_entry[ 0 ], data );
+			verboselog( *this, 0, "unknown GPU packet %08x (%08x)\n", m_command.n_entry[ 0 ], data );
 #if ( STOP_ON_ERROR )
 			n_gpu_buffer_offset = 1;
 #endif
@@ -3536,6 +3804,7 @@ WRITE32_MEMBER( psxgpu_device::write )
 		switch( data >> 24 )
 		{
 		case 0x00:
+			render_sync();
 			gpu_reset();
 			break;
 		case 0x01:
@@ -3601,6 +3870,7 @@ WRITE32_MEMBER( psxgpu_device::write )
 			n_lightgun_y = 0;
 			break;
 		case 0x10:
+			render_sync();
 			switch( data & 0xff )
 			{
 			case 0x03:
@@ -3675,6 +3945,11 @@ void psxgpu_device::dma_read( uint32_t *p_n_psxram, uint32_t n_address, int32_t
 
 void psxgpu_device::gpu_read( uint32_t *p_ram, int32_t n_size )
 {
+	if( ( n_gpustatus & ( 1L << 0x1b ) ) != 0 )
+	{
+		render_sync();
+	}
+
 	while( n_size > 0 )
 	{
 		if( ( n_gpustatus & ( 1L << 0x1b ) ) != 0 )
@@ -3687,13 +3962,13 @@ void psxgpu_device::gpu_read( uint32_t *p_ram, int32_t n_size )
 			for( n_pixel = 0; n_pixel < 2; n_pixel++ )
 			{
 				data.w.l = data.w.h;
-				data.w.h = *( p_p_vram[ ( n_vramy + ( m_packet.n_entry[ 1 ] >> 16 ) ) & 0x3ff ] + ( ( n_vramx + ( m_packet.n_entry[ 1 ] & 0xffff ) ) & 0x3ff ) );
+				data.w.h = *( p_p_vram[ ( n_vramy + ( m_command.n_entry[ 1 ] >> 16 ) ) & 0x3ff ] + ( ( n_vramx + ( m_command.n_entry[ 1 ] & 0xffff ) ) & 0x3ff ) );
 				n_vramx++;
-				if( n_vramx >= ( m_packet.n_entry[ 2 ] & 0xffff ) )
+				if( n_vramx >= ( m_command.n_entry[ 2 ] & 0xffff ) )
 				{
 					n_vramx = 0;
 					n_vramy++;
-					if( n_vramy >= ( m_packet.n_entry[ 2 ] >> 16 ) )
+					if( n_vramy >= ( m_command.n_entry[ 2 ] >> 16 ) )
 					{
 						verboselog( *this, 1, "copy image from frame buffer end\n" );
 						n_gpustatus &= ~( 1L << 0x1b );
@@ -3752,6 +4027,9 @@ void psxgpu_device::vblank(screen_device &screen, bool vblank_state)
 
 		n_gpustatus ^= ( 1L << 31 );
 		m_vblank_handler(1);
+
+		// start drawing whatever is left of the frame
+		render_submit();
 	}
 }
 
@@ -71,6 +71,7 @@ protected:
 	psxgpu_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock);
 
 	virtual void device_start() override;
+	virtual void device_stop() override;
 	virtual void device_reset() override;
 	virtual void device_add_mconfig(machine_config &config) override;
 
@@ -78,6 +79,8 @@ protected:
 
 private:
 	static constexpr unsigned DEBUG_COORDS = 10;
+	static constexpr unsigned RENDER_BATCH_SIZE = 64;
+	static constexpr unsigned RENDER_BATCHES = 4;
 
 	struct psx_gpu_debug
 	{
@@ -208,7 +211,15 @@ private:
 		} Dot;
 	};
 
+	struct render_batch
+	{
+		psxgpu_device *gpu;
+		std::vector<PACKET> commands;
+		osd_work_item *item;
+	};
+
 	void updatevisiblearea();
+	void update_tpage_status( uint32_t tpage );
 	void decode_tpage( uint32_t tpage );
 	void FlatPolygon( int n_points );
 	void FlatTexturedPolygon( int n_points );
@@ -229,6 +240,13 @@ private:
 	void gpu_reset();
 	void gpu_read( uint32_t *p_ram, int32_t n_size );
 	void gpu_write( uint32_t *p_ram, int32_t n_size );
+	void execute_command( const PACKET &packet );
+	void queue_command();
+	void render_submit();
+	void render_sync();
+	void render_discard();
+	void postload();
+	static void *render_batch_callback( void *param, int threadid );
 
 	int32_t m_n_tx;
 	int32_t m_n_ty;
@@ -268,6 +286,11 @@ private:
 	uint32_t n_screenheight;
 
 	PACKET m_packet;
+	PACKET m_command;
+
+	osd_work_queue *m_render_queue;
+	render_batch m_render_batch[ RENDER_BATCHES ];
+	int m_render_batch_index;
 
 	uint16_t *p_p_vram[ 1024 ];
 
@@ -0,0 +1,171 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    texcache.cpp
+
+    Decoded texture cache with write-tracked invalidation.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "texcache.h"
+
+
+//-------------------------------------------------
+//  texture_cache - constructor
+//-------------------------------------------------
+
+texture_cache::texture_cache(u32 space_size, int page_shift, int max_entries)
+	: m_page_stamp(((space_size - 1) >> page_shift) + 1, 0)
+	, m_space_size(space_size)
+	, m_page_shift(page_shift)
+	, m_max_entries(max_entries)
+	, m_stamp(0)
+	, m_clock(0)
+	, m_hits(0)
+	, m_misses(0)
+	, m_partial(0)
+{
+	assert(max_entries > 0);
+	m_entries.reserve(max_entries);
+}
+
+
+//-------------------------------------------------
+//  invalidate - note a write to the source space;
+//  entries decoded from any page it touches are
+//  re-decoded on their next lookup
+//-------------------------------------------------
+
+void texture_cache::invalidate(u32 start, u32 length)
+{
+	if (length == 0 || start >= m_space_size)
+		return;
+
+	const u32 end = std::min(start + length, m_space_size) - 1;
+	m_stamp++;
+	for (u32 page = start >> m_page_shift; page <= (end >> m_page_shift); page++)
+		m_page_stamp[page] = m_stamp;
+}
+
+
+//-------------------------------------------------
+//  flush - drop every entry
+//-------------------------------------------------
+
+void texture_cache::flush()
+{
+	m_entries.clear();
+}
+
+
+//-------------------------------------------------
+//  find - return the entry for a key, current or
+//  not, or nullptr if there is none
+//-------------------------------------------------
+
+texture_cache::entry *texture_cache::find(u32 address, u32 format, u32 palette)
+{
+	auto const found = m_entries.find(key{ address, format, palette });
+	if (found == m_entries.end())
+		return nullptr;
+
+	found->second.last_used = ++m_clock;
+	return &found->second;
+}
+
+
+//-------------------------------------------------
+//  allocate - set up an entry for decoding, reusing
+//  a stale one for the same key or evicting the
+//  least recently used one if the cache is full
+//-------------------------------------------------
+
+texture_cache::entry *texture_cache::allocate(entry *tex, u32 address, u32 format, u32 palette, u32 texels, const range &data, const range &pal)
+{
+	m_misses++;
+
+	if (tex == nullptr)
+	{
+		if (m_entries.size() >= size_t(m_max_entries))
+		{
+			auto victim = m_entries.begin();
+			for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+				if (it->second.last_used < victim->second.last_used)
+					victim = it;
+			m_entries.erase(victim);
+		}
+
+		tex = &m_entries[key{ address, format, palette }];
+		tex->last_used = ++m_clock;
+	}
+
+	tex->data = data;
+	tex->pal = pal;
+	tex->stamp = m_stamp;
+	tex->texels.resize(texels);
+	return tex;
+}
+
+
+//-------------------------------------------------
+//  is_current - true if nothing an entry was
+//  decoded from has been written since
+//-------------------------------------------------
+
+bool texture_cache::is_current(const entry &tex) const
+{
+	// nothing at all written since the decode
+	if (tex.stamp == m_stamp)
+		return true;
+
+	return range_current(tex.data, tex.stamp) && range_current(tex.pal, tex.stamp);
+}
+
+bool texture_cache::range_current(const range &r, u64 stamp) const
+{
+	if (r.length == 0 || r.start >= m_space_size)
+		return true;
+
+	const u32 end = std::min(r.start + r.length, m_space_size) - 1;
+	for (u32 page = r.start >> m_page_shift; page <= (end >> m_page_shift); page++)
+		if (m_page_stamp[page] > stamp)
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  next_written - find the next run of pages in
+//  an entry's texel range written since it was
+//  decoded, as byte offsets into the range, at or
+//  after the given offset
+//-------------------------------------------------
+
+bool texture_cache::next_written(const entry &tex, u32 offset, u32 &first, u32 &count) const
+{
+	const u32 length = std::min(tex.data.length, m_space_size - std::min(tex.data.start, m_space_size));
+	while (offset < length)
+	{
+		const u32 page = (tex.data.start + offset) >> m_page_shift;
+		const u32 page_end = std::min(((page + 1) << m_page_shift) - tex.data.start, length);
+		if (m_page_stamp[page] <= tex.stamp)
+		{
+			offset = page_end;
+			continue;
+		}
+
+		// extend the run over the written pages that follow
+		first = offset;
+		offset = page_end;
+		while (offset < length && m_page_stamp[(tex.data.start + offset) >> m_page_shift] > tex.stamp)
+		{
+			const u32 next = (tex.data.start + offset) >> m_page_shift;
+			offset = std::min(((next + 1) << m_page_shift) - tex.data.start, length);
+		}
+		count = offset - first;
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,153 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    texcache.h
+
+    Decoded texture cache with write-tracked invalidation.
+
+    Renderers that fetch texels from emulated texture memory usually pay
+    for a format decode (palette lookup, 16-to-32 bit expansion, ...) on
+    every texel, even though the same texture is drawn many times between
+    uploads.  This cache keeps textures decoded to 32-bit ARGB, keyed by
+    (address, format, palette), so repeat draws only index an array.
+
+    The owner reports writes to texture memory with invalidate().  The
+    source space is split into pages, each carrying the stamp of the last
+    write that touched it; an entry is valid as long as no page in its
+    texel or palette range has been written since it was decoded.  Stale
+    entries are re-decoded on the next lookup rather than when written.
+    Where texels map linearly onto the source, get_pages() redoes only
+    the texels of the pages written since, so a small upload into a big
+    texture memory doesn't cost a decode of all of it.
+
+    The cache isn't thread-safe.  Pointers it returns stay valid until
+    the entry is re-decoded, evicted or flushed; the least recently used
+    entry is evicted first, so the entry returned by the previous lookup
+    survives the next one as long as the cache holds at least two.
+
+***************************************************************************/
+
+#ifndef MAME_VIDEO_TEXCACHE_H
+#define MAME_VIDEO_TEXCACHE_H
+
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+
+class texture_cache
+{
+public:
+	// a span of the source space an entry was decoded from
+	struct range
+	{
+		u32 start;
+		u32 length;
+	};
+
+	// construction
+	texture_cache(u32 space_size, int page_shift, int max_entries);
+
+	// look up a decoded texture, decoding it on a miss; decode is
+	// called as decode(u32 *dest) and must fill `texels` words
+	template <typename Decoder>
+	const u32 *get(u32 address, u32 format, u32 palette, u32 texels, const range &data, const range &pal, Decoder &&decode)
+	{
+		entry *tex = find(address, format, palette);
+		if (tex != nullptr && is_current(*tex))
+		{
+			m_hits++;
+			return &tex->texels[0];
+		}
+
+		tex = allocate(tex, address, format, palette, texels, data, pal);
+		decode(&tex->texels[0]);
+		return &tex->texels[0];
+	}
+
+	// as get(), for textures whose texel n is decoded from the source at
+	// data.start + (n << texel_shift) and from the palette alone; decode
+	// is called as decode(u32 *dest, u32 first, u32 count) and must fill
+	// dest[first] up to dest[first + count - 1], and is only called for
+	// the texels of written pages unless the palette was written too
+	template <typename Decoder>
+	const u32 *get_pages(u32 address, u32 format, u32 palette, u32 texels, const range &data, const range &pal, int texel_shift, Decoder &&decode)
+	{
+		entry *tex = find(address, format, palette);
+		if (tex != nullptr && is_current(*tex))
+		{
+			m_hits++;
+			return &tex->texels[0];
+		}
+
+		if (tex != nullptr && tex->texels.size() == texels && tex->data.start == data.start && tex->data.length == data.length && tex->pal.start == pal.start && tex->pal.length == pal.length && range_current(pal, tex->stamp))
+		{
+			m_partial++;
+			u32 first, count;
+			for (u32 offset = 0; next_written(*tex, offset, first, count); offset = first + count)
+				decode(&tex->texels[0], first >> texel_shift, std::min(((first + count - 1) >> texel_shift) + 1, texels) - (first >> texel_shift));
+			tex->stamp = m_stamp;
+			return &tex->texels[0];
+		}
+
+		tex = allocate(tex, address, format, palette, texels, data, pal);
+		decode(&tex->texels[0], 0, texels);
+		return &tex->texels[0];
+	}
+
+	// write tracking
+	void invalidate(u32 start, u32 length);
+	void flush();
+
+	// statistics
+	u64 hits() const { return m_hits; }
+	u64 misses() const { return m_misses; }
+	u64 partial_decodes() const { return m_partial; }
+	int entries() const { return int(m_entries.size()); }
+
+private:
+	struct key
+	{
+		u32 address;
+		u32 format;
+		u32 palette;
+
+		bool operator==(const key &rhs) const { return address == rhs.address && format == rhs.format && palette == rhs.palette; }
+	};
+
+	struct key_hash
+	{
+		size_t operator()(const key &k) const { return (size_t(k.address) * 0x9e3779b1U) ^ (size_t(k.format) << 16) ^ k.palette; }
+	};
+
+	struct entry
+	{
+		range data;             // texel source range
+		range pal;              // palette source range (length 0 if none)
+		u64 stamp;              // write stamp at decode time
+		u64 last_used;          // LRU clock at last lookup
+		std::vector<u32> texels;
+	};
+
+	entry *find(u32 address, u32 format, u32 palette);
+	entry *allocate(entry *tex, u32 address, u32 format, u32 palette, u32 texels, const range &data, const range &pal);
+	bool is_current(const entry &tex) const;
+	bool range_current(const range &r, u64 stamp) const;
+	bool next_written(const entry &tex, u32 offset, u32 &first, u32 &count) const;
+
+	std::unordered_map<key, entry, key_hash> m_entries;
+	std::vector<u64> m_page_stamp;  // stamp of the last write to each page
+	u32 m_space_size;
+	int m_page_shift;
+	int m_max_entries;
+	u64 m_stamp;                    // stamp of the most recent write
+	u64 m_clock;                    // LRU clock
+	u64 m_hits;
+	u64 m_misses;
+	u64 m_partial;
+};
+
+#endif // MAME_VIDEO_TEXCACHE_H
@@ -0,0 +1,209 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    covrecord.cpp
+
+    Memory and code coverage recording.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "covrecord.h"
+#include "emuopts.h"
+
+#include <algorithm>
+
+
+//**************************************************************************
+//  COVERAGE RECORDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  coverage_recorder - constructor
+//-------------------------------------------------
+
+coverage_recorder::coverage_recorder(running_machine &machine)
+	: m_machine(machine)
+{
+	// with -coverage, record every CPU from the start and save on exit
+	if (machine.options().coverage()[0] != 0)
+	{
+		for (device_execute_interface &exec : execute_interface_iterator(machine.root_device()))
+			enable(exec.device(), true);
+		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&coverage_recorder::exit, this));
+	}
+}
+
+
+//-------------------------------------------------
+//  ~coverage_recorder - destructor
+//-------------------------------------------------
+
+coverage_recorder::~coverage_recorder()
+{
+}
+
+
+//-------------------------------------------------
+//  enabled - return whether a device is being
+//  recorded
+//-------------------------------------------------
+
+bool coverage_recorder::enabled(device_t &device) const
+{
+	device_coverage const *const cov = find(device);
+	return cov != nullptr && cov->enabled;
+}
+
+
+//-------------------------------------------------
+//  maps - return the maps of every space of a
+//  device, for saving
+//-------------------------------------------------
+
+std::vector<const util::coverage_map *> coverage_recorder::maps(device_t &device) const
+{
+	std::vector<const util::coverage_map *> result;
+	device_coverage const *const cov = find(device);
+	if (cov != nullptr)
+		for (const std::unique_ptr<util::coverage_map> &map : cov->maps)
+			if (map)
+				result.push_back(map.get());
+	return result;
+}
+
+
+//-------------------------------------------------
+//  enable - start or stop recording a device;
+//  what was recorded is kept until cleared
+//-------------------------------------------------
+
+void coverage_recorder::enable(device_t &device, bool enable)
+{
+	device_memory_interface *memory;
+	if (!device.interface(memory))
+		return;
+	device_coverage &cov = find_or_create(device);
+
+	// one map per space, sized by its byte address mask
+	if (cov.maps.empty())
+	{
+		cov.maps.resize(memory->max_space_count());
+		for (int spacenum = 0; spacenum < int(cov.maps.size()); spacenum++)
+			if (memory->has_space(spacenum))
+			{
+				address_space &space = memory->space(spacenum);
+				cov.maps[spacenum] = std::make_unique<util::coverage_map>(space.name(), space.addrmask());
+			}
+	}
+
+	// reads and writes are recorded by the memory system
+	for (int spacenum = 0; spacenum < int(cov.maps.size()); spacenum++)
+		if (cov.maps[spacenum])
+			memory->space(spacenum).set_coverage(enable ? cov.maps[spacenum].get() : nullptr);
+
+	// executed addresses by the instruction hook and recompiled code
+	device_execute_interface *exec;
+	if (device.interface(exec) && int(cov.maps.size()) > AS_PROGRAM && cov.maps[AS_PROGRAM])
+		exec->set_exec_coverage(enable ? cov.maps[AS_PROGRAM].get() : nullptr);
+
+	cov.enabled = enable;
+	update_flags();
+}
+
+
+//-------------------------------------------------
+//  clear - forget what was recorded for a device
+//-------------------------------------------------
+
+void coverage_recorder::clear(device_t &device)
+{
+	device_coverage *const cov = find(device);
+	if (cov != nullptr)
+		for (std::unique_ptr<util::coverage_map> &map : cov->maps)
+			if (map)
+				map->clear();
+}
+
+
+//-------------------------------------------------
+//  save - write the maps of a device to a file
+//-------------------------------------------------
+
+util::coverage_error coverage_recorder::save(device_t &device, const std::string &filename) const
+{
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) != osd_file::error::NONE)
+		return util::coverage_error::FILE_ERROR;
+	return util::coverage_map::save(*file, device.tag(), maps(device));
+}
+
+
+//-------------------------------------------------
+//  find - return the recorded state of a device,
+//  if any
+//-------------------------------------------------
+
+coverage_recorder::device_coverage *coverage_recorder::find(device_t &device) const
+{
+	for (const std::unique_ptr<device_coverage> &cov : m_devices)
+		if (&cov->device == &device)
+			return cov.get();
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  find_or_create - return the recorded state of
+//  a device, adding it the first time
+//-------------------------------------------------
+
+coverage_recorder::device_coverage &coverage_recorder::find_or_create(device_t &device)
+{
+	device_coverage *const cov = find(device);
+	if (cov != nullptr)
+		return *cov;
+	m_devices.push_back(std::make_unique<device_coverage>(device));
+	return *m_devices.back();
+}
+
+
+//-------------------------------------------------
+//  update_flags - tell CPU cores whether anything
+//  is being recorded
+//-------------------------------------------------
+
+void coverage_recorder::update_flags()
+{
+	bool const any = std::any_of(m_devices.begin(), m_devices.end(), [] (const std::unique_ptr<device_coverage> &cov) { return cov->enabled; });
+	if (any)
+		m_machine.debug_flags |= DEBUG_FLAG_COVERAGE | DEBUG_FLAG_CALL_HOOK;
+	else
+	{
+		// with the debugger, it works out for itself whether the hook is still needed
+		m_machine.debug_flags &= ~DEBUG_FLAG_COVERAGE;
+		if ((m_machine.debug_flags & DEBUG_FLAG_ENABLED) == 0)
+			m_machine.debug_flags &= ~DEBUG_FLAG_CALL_HOOK;
+	}
+}
+
+
+//-------------------------------------------------
+//  exit - save the coverage of every CPU for
+//  -coverage, one file per CPU
+//-------------------------------------------------
+
+void coverage_recorder::exit()
+{
+	std::string const prefix(m_machine.options().coverage());
+	for (const std::unique_ptr<device_coverage> &cov : m_devices)
+	{
+		// tags use colons, which not every file system allows
+		std::string tag(cov->device.tag() + 1);
+		std::replace(tag.begin(), tag.end(), ':', '.');
+		std::string const filename(string_format("%s.%s.cov", prefix, tag));
+		if (save(cov->device, filename) != util::coverage_error::NONE)
+			osd_printf_error("Error writing coverage file '%s'\n", filename.c_str());
+	}
+}
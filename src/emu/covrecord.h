@@ -0,0 +1,73 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    covrecord.h
+
+    Memory and code coverage recording.
+
+    Reads and writes are recorded by the memory system, which routes a
+    recorded space through its watchpoint handler.  Executed addresses
+    come from the instruction hook on interpreting cores, and from a
+    call at the start of every straight run of recompiled code on DRC
+    cores.  None of this needs the debugger, which only provides the
+    commands to turn recording on and off at runtime.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_COVRECORD_H
+#define MAME_EMU_COVRECORD_H
+
+#pragma once
+
+#include "coverage.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> coverage_recorder
+
+class coverage_recorder
+{
+public:
+	// construction/destruction
+	coverage_recorder(running_machine &machine);
+	~coverage_recorder();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	bool enabled(device_t &device) const;
+	std::vector<const util::coverage_map *> maps(device_t &device) const;
+
+	// recording control
+	void enable(device_t &device, bool enable);
+	void clear(device_t &device);
+
+	// saving
+	util::coverage_error save(device_t &device, const std::string &filename) const;
+
+private:
+	// recorded state of one device
+	struct device_coverage
+	{
+		device_coverage(device_t &dev) : device(dev), enabled(false) { }
+
+		device_t &                                      device;     // device being recorded
+		std::vector<std::unique_ptr<util::coverage_map>> maps;      // per address space, null for missing spaces
+		bool                                            enabled;    // currently recording?
+	};
+
+	// internal helpers
+	device_coverage *find(device_t &device) const;
+	device_coverage &find_or_create(device_t &device);
+	void update_flags();
+	void exit();
+
+	// internal state
+	running_machine &                               m_machine;  // reference to our machine
+	std::vector<std::unique_ptr<device_coverage>>   m_devices;  // devices recorded so far
+};
+
+#endif // MAME_EMU_COVRECORD_H
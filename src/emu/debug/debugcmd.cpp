@@ -95,6 +95,20 @@ u64 debugger_commands::cheat_read_extended(const cheat_system *cheatsys, address
 	return cheat_sign_extend(cheatsys, cheat_byte_swap(cheatsys, m_cpu.read_memory(space, address, cheatsys->width, true)));
 }
 
+/*-------------------------------------------------
+    cheat_extract_extended - assemble a value from
+    memory copied out with read_block, the same
+    way cheat_read_extended would have read it
+-------------------------------------------------*/
+
+u64 debugger_commands::cheat_extract_extended(const cheat_system *cheatsys, address_space &space, const u8 *data)
+{
+	u64 value = 0;
+	for (int i = 0; i < cheatsys->width; i++)
+		value |= u64(data[i]) << (8 * ((space.endianness() == ENDIANNESS_LITTLE) ? i : (cheatsys->width - 1 - i)));
+	return cheat_sign_extend(cheatsys, cheat_byte_swap(cheatsys, value));
+}
+
 debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu, debugger_console& console)
 	: m_machine(machine)
 	, m_cpu(cpu)
@@ -262,6 +276,8 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("trackpc",   CMDFLAG_NONE, 0, 0, 3, std::bind(&debugger_commands::execute_trackpc, this, _1, _2));
 
 	m_console.register_command("trackmem",  CMDFLAG_NONE, 0, 0, 3, std::bind(&debugger_commands::execute_trackmem, this, _1, _2));
+	m_console.register_command("coverage",  CMDFLAG_NONE, 0, 0, 3, std::bind(&debugger_commands::execute_coverage, this, _1, _2));
+	m_console.register_command("coversave", CMDFLAG_NONE, 0, 1, 2, std::bind(&debugger_commands::execute_coversave, this, _1, _2));
 	m_console.register_command("pcatmemp",  CMDFLAG_NONE, AS_PROGRAM, 1, 2, std::bind(&debugger_commands::execute_pcatmem, this, _1, _2));
 	m_console.register_command("pcatmemd",  CMDFLAG_NONE, AS_DATA,    1, 2, std::bind(&debugger_commands::execute_pcatmem, this, _1, _2));
 	m_console.register_command("pcatmemi",  CMDFLAG_NONE, AS_IO,      1, 2, std::bind(&debugger_commands::execute_pcatmem, this, _1, _2));
@@ -2246,19 +2262,30 @@ void debugger_commands::execute_cheatinit(int ref, const std::vector<std::string
 		m_cheat.cheatmap.resize(m_cheat.cheatmap.size() + real_length);
 	}
 
-	/* initialize cheatmap in the selected space */
+	/* initialize cheatmap in the selected space; byte-addressed spaces copy each region out in one go */
+	std::vector<u8> buffer;
 	for (i = 0; i < region_count; i++)
 		if (!cheat_region[i].disabled)
+		{
+			bool const bulk = space->addr_shift() == 0 && cheat_region[i].endoffset >= cheat_region[i].offset;
+			if (bulk)
+			{
+				buffer.resize(cheat_region[i].endoffset - cheat_region[i].offset + m_cheat.width);
+				m_cpu.read_block(*space, cheat_region[i].offset, buffer.size(), &buffer[0], true);
+			}
 			for (curaddr = cheat_region[i].offset; curaddr <= cheat_region[i].endoffset; curaddr += m_cheat.width)
 				if (cheat_address_is_valid(*space, curaddr))
 				{
-					m_cheat.cheatmap[active_cheat].previous_value = cheat_read_extended(&m_cheat, *space, curaddr);
+					m_cheat.cheatmap[active_cheat].previous_value = bulk
+							? cheat_extract_extended(&m_cheat, *space, &buffer[curaddr - cheat_region[i].offset])
+							: cheat_read_extended(&m_cheat, *space, curaddr);
 					m_cheat.cheatmap[active_cheat].first_value = m_cheat.cheatmap[active_cheat].previous_value;
 					m_cheat.cheatmap[active_cheat].offset = curaddr;
 					m_cheat.cheatmap[active_cheat].state = 1;
 					m_cheat.cheatmap[active_cheat].undo = 0;
 					active_cheat++;
 				}
+		}
 
 	/* give a detailed init message to avoid searches being mistakingly carried out on the wrong CPU */
 	device_t *cpu = nullptr;
@@ -2339,103 +2366,168 @@ void debugger_commands::execute_cheatnext(int ref, const std::vector<std::string
 
 	m_cheat.undo++;
 
-	/* execute the search */
-	for (cheatindex = 0; cheatindex < m_cheat.cheatmap.size(); cheatindex += 1)
-		if (m_cheat.cheatmap[cheatindex].state == 1)
+	/* decide whether one candidate is dropped */
+	auto const disable = [this, condition, comp_value] (u64 cheat_value, u64 comp_byte)
+	{
+		bool disable_byte = false;
+
+		switch (condition)
 		{
-			u64 cheat_value = cheat_read_extended(&m_cheat, *space, m_cheat.cheatmap[cheatindex].offset);
-			u64 comp_byte = (ref == 0) ? m_cheat.cheatmap[cheatindex].previous_value : m_cheat.cheatmap[cheatindex].first_value;
-			u8 disable_byte = false;
+			case CHEAT_ALL:
+				break;
 
-			switch (condition)
-			{
-				case CHEAT_ALL:
-					break;
+			case CHEAT_EQUAL:
+				disable_byte = (cheat_value != comp_byte);
+				break;
 
-				case CHEAT_EQUAL:
-					disable_byte = (cheat_value != comp_byte);
-					break;
+			case CHEAT_NOTEQUAL:
+				disable_byte = (cheat_value == comp_byte);
+				break;
 
-				case CHEAT_NOTEQUAL:
-					disable_byte = (cheat_value == comp_byte);
-					break;
+			case CHEAT_EQUALTO:
+				disable_byte = (cheat_value != comp_value);
+				break;
 
-				case CHEAT_EQUALTO:
-					disable_byte = (cheat_value != comp_value);
-					break;
+			case CHEAT_NOTEQUALTO:
+				disable_byte = (cheat_value == comp_value);
+				break;
 
-				case CHEAT_NOTEQUALTO:
-					disable_byte = (cheat_value == comp_value);
-					break;
+			case CHEAT_DECREASE:
+				if (m_cheat.signed_cheat)
+					disable_byte = (s64(cheat_value) >= s64(comp_byte));
+				else
+					disable_byte = (u64(cheat_value) >= u64(comp_byte));
+				break;
 
-				case CHEAT_DECREASE:
-					if (m_cheat.signed_cheat)
-						disable_byte = (s64(cheat_value) >= s64(comp_byte));
-					else
-						disable_byte = (u64(cheat_value) >= u64(comp_byte));
-					break;
+			case CHEAT_INCREASE:
+				if (m_cheat.signed_cheat)
+					disable_byte = (s64(cheat_value) <= s64(comp_byte));
+				else
+					disable_byte = (u64(cheat_value) <= u64(comp_byte));
+				break;
 
-				case CHEAT_INCREASE:
-					if (m_cheat.signed_cheat)
-						disable_byte = (s64(cheat_value) <= s64(comp_byte));
-					else
-						disable_byte = (u64(cheat_value) <= u64(comp_byte));
-					break;
+			case CHEAT_DECREASE_OR_EQUAL:
+				if (m_cheat.signed_cheat)
+					disable_byte = (s64(cheat_value) > s64(comp_byte));
+				else
+					disable_byte = (u64(cheat_value) > u64(comp_byte));
+				break;
 
-				case CHEAT_DECREASE_OR_EQUAL:
-					if (m_cheat.signed_cheat)
-						disable_byte = (s64(cheat_value) > s64(comp_byte));
-					else
-						disable_byte = (u64(cheat_value) > u64(comp_byte));
-					break;
+			case CHEAT_INCREASE_OR_EQUAL:
+				if (m_cheat.signed_cheat)
+					disable_byte = (s64(cheat_value) < s64(comp_byte));
+				else
+					disable_byte = (u64(cheat_value) < u64(comp_byte));
+				break;
 
-				case CHEAT_INCREASE_OR_EQUAL:
-					if (m_cheat.signed_cheat)
-						disable_byte = (s64(cheat_value) < s64(comp_byte));
-					else
-						disable_byte = (u64(cheat_value) < u64(comp_byte));
-					break;
+			case CHEAT_DECREASEOF:
+				disable_byte = (cheat_value != comp_byte - comp_value);
+				break;
 
-				case CHEAT_DECREASEOF:
-					disable_byte = (cheat_value != comp_byte - comp_value);
-					break;
+			case CHEAT_INCREASEOF:
+				disable_byte = (cheat_value != comp_byte + comp_value);
+				break;
 
-				case CHEAT_INCREASEOF:
+			case CHEAT_SMALLEROF:
+				if (m_cheat.signed_cheat)
+					disable_byte = (s64(cheat_value) >= s64(comp_value));
+				else
+					disable_byte = (u64(cheat_value) >= u64(comp_value));
+				break;
+
+			case CHEAT_GREATEROF:
+				if (m_cheat.signed_cheat)
+					disable_byte = (s64(cheat_value) <= s64(comp_value));
+				else
+					disable_byte = (u64(cheat_value) <= u64(comp_value));
+				break;
+			case CHEAT_CHANGEDBY:
+				if (cheat_value > comp_byte)
 					disable_byte = (cheat_value != comp_byte + comp_value);
-					break;
+				else
+					disable_byte = (cheat_value != comp_byte - comp_value);
+				break;
+		}
 
-				case CHEAT_SMALLEROF:
-					if (m_cheat.signed_cheat)
-						disable_byte = (s64(cheat_value) >= s64(comp_value));
-					else
-						disable_byte = (u64(cheat_value) >= u64(comp_value));
-					break;
+		return disable_byte;
+	};
+	auto const update = [this, &disable, ref] (cheat_map &entry, u64 cheat_value) -> bool
+	{
+		u64 comp_byte = (ref == 0) ? entry.previous_value : entry.first_value;
+		bool const disable_byte = disable(cheat_value, comp_byte);
+		if (disable_byte)
+		{
+			entry.state = 0;
+			entry.undo = m_cheat.undo;
+		}
 
-				case CHEAT_GREATEROF:
-					if (m_cheat.signed_cheat)
-						disable_byte = (s64(cheat_value) <= s64(comp_value));
-					else
-						disable_byte = (u64(cheat_value) <= u64(comp_value));
-					break;
-				case CHEAT_CHANGEDBY:
-					if (cheat_value > comp_byte)
-						disable_byte = (cheat_value != comp_byte + comp_value);
-					else
-						disable_byte = (cheat_value != comp_byte - comp_value);
-					break;
-			}
+		/* update previous value */
+		entry.previous_value = cheat_value;
+		return !disable_byte;
+	};
 
-			if (disable_byte)
+	/* byte-addressed spaces copy out runs of nearby candidates and test the runs in parallel */
+	if (space->addr_shift() == 0)
+	{
+		struct cheat_run
+		{
+			u64     first, last;    // candidate indices
+			offs_t  address;
+			u32     length;
+			size_t  buffer;         // offset of the run's memory in the buffer
+		};
+		constexpr u32 RUN_LIMIT = 0x10000;
+
+		std::vector<cheat_run> runs;
+		for (cheatindex = 0; cheatindex < m_cheat.cheatmap.size(); cheatindex++)
+			if (m_cheat.cheatmap[cheatindex].state == 1)
 			{
-				m_cheat.cheatmap[cheatindex].state = 0;
-				m_cheat.cheatmap[cheatindex].undo = m_cheat.undo;
+				offs_t const address = m_cheat.cheatmap[cheatindex].offset;
+				if (!runs.empty() && address >= runs.back().address && address - runs.back().address + m_cheat.width <= RUN_LIMIT)
+				{
+					runs.back().last = cheatindex;
+					runs.back().length = std::max<u32>(runs.back().length, address - runs.back().address + m_cheat.width);
+				}
+				else
+					runs.push_back({ cheatindex, cheatindex, address, m_cheat.width, 0 });
 			}
-			else
-				active_cheat++;
 
-			/* update previous value */
-			m_cheat.cheatmap[cheatindex].previous_value = cheat_value;
+		size_t total = 0;
+		for (cheat_run &run : runs)
+		{
+			run.buffer = total;
+			total += run.length;
 		}
+		std::vector<u8> buffer(total);
+		for (cheat_run &run : runs)
+			m_cpu.read_block(*space, run.address, run.length, &buffer[run.buffer], true);
+
+		/* every candidate belongs to one run, so slices never share an entry */
+		std::vector<u32> counts(runs.size(), 0);
+		m_search.parallel_for(runs.size(), 4, [&] (size_t begin, size_t end)
+		{
+			for (size_t r = begin; r < end; r++)
+			{
+				const cheat_run &run = runs[r];
+				for (u64 index = run.first; index <= run.last; index++)
+				{
+					cheat_map &entry = m_cheat.cheatmap[index];
+					if (entry.state == 1 && update(entry, cheat_extract_extended(&m_cheat, *space, &buffer[run.buffer + entry.offset - run.address])))
+						counts[r]++;
+				}
+			}
+		});
+		for (u32 count : counts)
+			active_cheat += count;
+	}
+
+	/* otherwise read candidates one at a time */
+	else
+	{
+		for (cheatindex = 0; cheatindex < m_cheat.cheatmap.size(); cheatindex += 1)
+			if (m_cheat.cheatmap[cheatindex].state == 1 && update(m_cheat.cheatmap[cheatindex], cheat_read_extended(&m_cheat, *space, m_cheat.cheatmap[cheatindex].offset)))
+				active_cheat++;
+	}
 
 	if (active_cheat <= 5)
 		execute_cheatlist(0, std::vector<std::string>());
@@ -2621,31 +2713,61 @@ void debugger_commands::execute_find(int ref, const std::vector<std::string> &pa
 		}
 	}
 
-	/* now search */
-	for (u64 i = offset; i <= endoffset; i += data_size[0])
+	/* byte-addressed spaces are copied out in windows and searched in bulk */
+	if (space->addr_shift() == 0)
 	{
-		int suboffset = 0;
-		int match = 1;
+		memory_search::pattern pattern;
+		for (j = 0; j < data_count; j++)
+		{
+			if (data_size[j] & 0x10)
+				pattern.add_wildcard(data_size[j] & 0x0f);
+			else
+				pattern.add(data_to_find[j], data_size[j], space->endianness());
+		}
 
-		/* find the entire string */
-		for (j = 0; j < data_count && match; j++)
+		constexpr u64 WINDOW = 16 * 1024 * 1024;
+		std::vector<u8> buffer;
+		std::vector<size_t> results;
+		for (u64 base = offset; base <= endoffset; base += WINDOW)
 		{
-			switch (data_size[j])
-			{
-				case 1: match = (u8(m_cpu.read_byte(*space, space->byte_to_address(i + suboffset), true)) == u8(data_to_find[j]));    break;
-				case 2: match = (u16(m_cpu.read_word(*space, space->byte_to_address(i + suboffset), true)) == u16(data_to_find[j]));  break;
-				case 4: match = (u32(m_cpu.read_dword(*space, space->byte_to_address(i + suboffset), true)) == u32(data_to_find[j])); break;
-				case 8: match = (u64(m_cpu.read_qword(*space, space->byte_to_address(i + suboffset), true)) == u64(data_to_find[j])); break;
-				default:    /* all other cases are wildcards */     break;
-			}
-			suboffset += data_size[j] & 0x0f;
+			u64 const positions = std::min<u64>(WINDOW, endoffset - base + 1);
+			buffer.resize(positions + pattern.length() - 1);
+			m_cpu.read_block(*space, base, buffer.size(), &buffer[0], true);
+			m_search.find(&buffer[0], positions, data_size[0] & 0x0f, pattern, results);
+			for (size_t position : results)
+				m_console.printf("Found at %0*X\n", space->addrchars(), u32(space->byte_to_address(base + position)));
+			found += results.size();
 		}
+	}
 
-		/* did we find it? */
-		if (match)
+	/* otherwise search an element at a time */
+	else
+	{
+		for (u64 i = offset; i <= endoffset; i += data_size[0])
 		{
-			found++;
-			m_console.printf("Found at %0*X\n", space->addrchars(), u32(space->byte_to_address(i)));
+			int suboffset = 0;
+			int match = 1;
+
+			/* find the entire string */
+			for (j = 0; j < data_count && match; j++)
+			{
+				switch (data_size[j])
+				{
+					case 1: match = (u8(m_cpu.read_byte(*space, space->byte_to_address(i + suboffset), true)) == u8(data_to_find[j]));    break;
+					case 2: match = (u16(m_cpu.read_word(*space, space->byte_to_address(i + suboffset), true)) == u16(data_to_find[j]));  break;
+					case 4: match = (u32(m_cpu.read_dword(*space, space->byte_to_address(i + suboffset), true)) == u32(data_to_find[j])); break;
+					case 8: match = (u64(m_cpu.read_qword(*space, space->byte_to_address(i + suboffset), true)) == u64(data_to_find[j])); break;
+					default:    /* all other cases are wildcards */     break;
+				}
+				suboffset += data_size[j] & 0x0f;
+			}
+
+			/* did we find it? */
+			if (match)
+			{
+				found++;
+				m_console.printf("Found at %0*X\n", space->addrchars(), u32(space->byte_to_address(i)));
+			}
 		}
 	}
 
@@ -2978,6 +3100,75 @@ void debugger_commands::execute_trackmem(int ref, const std::vector<std::string>
 }
 
 
+/*-------------------------------------------------
+    execute_coverage - execute the coverage command
+-------------------------------------------------*/
+
+void debugger_commands::execute_coverage(int ref, const std::vector<std::string> &params)
+{
+	// gather the on/off switch (if present)
+	bool turnOn = true;
+	if (params.size() > 0 && !validate_boolean_parameter(params[0], turnOn))
+		return;
+
+	// gather the cpu id (if present)
+	device_t *cpu = nullptr;
+	if (!validate_cpu_parameter((params.size() > 1) ? params[1].c_str() : nullptr, cpu))
+		return;
+
+	// should we clear the existing data?
+	bool clear = false;
+	if (params.size() > 2 && !validate_boolean_parameter(params[2], clear))
+		return;
+
+	coverage_recorder &coverage = m_machine.coverage();
+	if (clear)
+		coverage.clear(*cpu);
+	coverage.enable(*cpu, turnOn);
+	if (turnOn)
+	{
+		m_console.printf("Coverage recording enabled on CPU '%s'\n", cpu->tag());
+		return;
+	}
+
+	// summarize what was recorded
+	m_console.printf("Coverage recording disabled on CPU '%s'\n", cpu->tag());
+	for (const util::coverage_map *map : coverage.maps(*cpu))
+		m_console.printf("  %s: %u read, %u written, %u executed\n", map->name().c_str(),
+				u32(map->touched_count(util::coverage_map::READ)),
+				u32(map->touched_count(util::coverage_map::WRITE)),
+				u32(map->touched_count(util::coverage_map::EXEC)));
+}
+
+
+/*-------------------------------------------------
+    execute_coversave - execute the coversave
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_coversave(int ref, const std::vector<std::string> &params)
+{
+	// gather the cpu id (if present)
+	device_t *cpu = nullptr;
+	if (!validate_cpu_parameter((params.size() > 1) ? params[1].c_str() : nullptr, cpu))
+		return;
+
+	coverage_recorder &coverage = m_machine.coverage();
+	if (coverage.maps(*cpu).empty())
+	{
+		m_console.printf("No coverage recorded on CPU '%s'\n", cpu->tag());
+		return;
+	}
+
+	if (coverage.save(*cpu, params[0]) != util::coverage_error::NONE)
+	{
+		m_console.printf("Error writing file '%s'\n", params[0].c_str());
+		return;
+	}
+	m_console.printf("Coverage for CPU '%s' saved to '%s'\n", cpu->tag(), params[0].c_str());
+}
+
+
 /*-------------------------------------------------
     execute_pcatmem - execute the pcatmem command
 -------------------------------------------------*/
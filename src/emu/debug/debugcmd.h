@@ -15,6 +15,7 @@
 
 #include "debugcpu.h"
 #include "debugcon.h"
+#include "memsearch.h"
 
 
 class debugger_commands
@@ -80,6 +81,7 @@ private:
 	u64 cheat_sign_extend(const cheat_system *cheatsys, u64 value);
 	u64 cheat_byte_swap(const cheat_system *cheatsys, u64 value);
 	u64 cheat_read_extended(const cheat_system *cheatsys, address_space &space, offs_t address);
+	u64 cheat_extract_extended(const cheat_system *cheatsys, address_space &space, const u8 *data);
 
 	u64 execute_min(symbol_table &table, int params, const u64 *param);
 	u64 execute_max(symbol_table &table, int params, const u64 *param);
@@ -149,6 +151,8 @@ private:
 	void execute_history(int ref, const std::vector<std::string> &params);
 	void execute_trackpc(int ref, const std::vector<std::string> &params);
 	void execute_trackmem(int ref, const std::vector<std::string> &params);
+	void execute_coverage(int ref, const std::vector<std::string> &params);
+	void execute_coversave(int ref, const std::vector<std::string> &params);
 	void execute_pcatmem(int ref, const std::vector<std::string> &params);
 	void execute_snap(int ref, const std::vector<std::string> &params);
 	void execute_source(int ref, const std::vector<std::string> &params);
@@ -169,6 +173,7 @@ private:
 
 	std::unique_ptr<global_entry []> m_global_array;
 	cheat_system m_cheat;
+	memory_search m_search;
 
 	static const size_t MAX_GLOBALS;
 };
@@ -451,6 +451,81 @@ u64 debugger_cpu::read_memory(address_space &space, offs_t address, int size, bo
 }
 
 
+/*-------------------------------------------------
+    read_block - copy a range of byte addresses
+    into a buffer; RAM and ROM are copied straight
+    from their backing memory, with the address
+    space accessors only used for everything else
+-------------------------------------------------*/
+
+void debugger_cpu::read_block(address_space &space, offs_t address, u32 length, u8 *dest, bool apply_translation)
+{
+	// word-addressed spaces don't map one byte to one address
+	if (space.addr_shift() != 0)
+	{
+		for (u32 i = 0; i < length; i++)
+			dest[i] = read_byte(space, space.byte_to_address(address + i), apply_translation);
+		return;
+	}
+
+	// translation and handlers can change at any bus word (MMU page sizes
+	// vary, and taps or overlays can cover a few bytes of a bank), so each
+	// word is translated and looked up, and only the copy is batched
+	device_memory_interface &memory = space.device().memory();
+	offs_t const lowmask = space.data_width() / 8 - 1;
+	offs_t const swap = ((space.endianness() == ENDIANNESS_LITTLE) ? BYTE8_XOR_LE(0) : BYTE8_XOR_BE(0)) & lowmask;
+
+	const u8 *run_base = nullptr;       // backing memory of the current run's first byte
+	u32 run_start = 0;                  // offset in dest of the current run
+	offs_t run_offset = 0;              // offset of the first byte within its bus word
+	auto const flush = [&] (u32 end)
+	{
+		if (run_base == nullptr)
+			return;
+		if (swap == 0)
+			memcpy(dest + run_start, run_base, end - run_start);
+		else
+		{
+			const u8 *const word = run_base - run_offset;
+			for (u32 i = 0; i < end - run_start; i++)
+				dest[run_start + i] = word[(run_offset + i) ^ swap];
+		}
+		run_base = nullptr;
+	};
+
+	for (u32 done = 0; done < length; )
+	{
+		u32 const count = std::min<u32>(length - done, lowmask + 1 - ((address + done) & lowmask));
+
+		offs_t physical = (address + done) & space.logaddrmask();
+		const u8 *base = nullptr;
+		if (!apply_translation || memory.translate(space.spacenum(), TRANSLATE_READ_DEBUG, physical))
+		{
+			base = (const u8 *)space.get_read_ptr(physical & ~lowmask);
+			if (base != nullptr)
+				base += physical & lowmask;
+		}
+
+		// extend the run while the backing memory stays contiguous
+		if (run_base != nullptr && base != run_base + (done - run_start))
+			flush(done);
+		if (base == nullptr)
+		{
+			for (u32 i = 0; i < count; i++)
+				dest[done + i] = read_byte(space, address + done + i, apply_translation);
+		}
+		else if (run_base == nullptr)
+		{
+			run_base = base;
+			run_start = done;
+			run_offset = physical & lowmask;
+		}
+		done += count;
+	}
+	flush(length);
+}
+
+
 /*-------------------------------------------------
     write_byte - write a byte to the specified
     memory space
@@ -2516,10 +2591,14 @@ void device_debug::compute_debug_flags()
 	running_machine &machine = m_device.machine();
 	debugger_cpu& debugcpu = machine.debugger().cpu();
 
-	// clear out global flags by default, keep DEBUG_FLAG_OSD_ENABLED
-	machine.debug_flags &= DEBUG_FLAG_OSD_ENABLED;
+	// clear out global flags by default, keep DEBUG_FLAG_OSD_ENABLED and DEBUG_FLAG_COVERAGE
+	machine.debug_flags &= DEBUG_FLAG_OSD_ENABLED | DEBUG_FLAG_COVERAGE;
 	machine.debug_flags |= DEBUG_FLAG_ENABLED;
 
+	// coverage recording is fed by the hook whatever the debugger is doing
+	if (machine.debug_flags & DEBUG_FLAG_COVERAGE)
+		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
+
 	// if we are ignoring this CPU, or if events are pending, we're done
 	if ((m_flags & DEBUG_FLAG_OBSERVING) == 0 || machine.scheduled_event_pending() || machine.save_or_load_pending())
 		return;
@@ -2529,8 +2608,17 @@ void device_debug::compute_debug_flags()
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
 
 	// if we're tracking history, or we're hooked, or stepping, or stopping at a breakpoint
-	// make sure we call the hook
-	if ((m_flags & (DEBUG_FLAG_HISTORY | DEBUG_FLAG_HOOKED | DEBUG_FLAG_STEPPING_ANY | DEBUG_FLAG_STOP_PC | DEBUG_FLAG_LIVE_BP)) != 0)
+	// make sure we call the hook; a core that compiles breakpoints calls it itself
+	// at breakpoint addresses, giving up per-instruction history, unless registerpoints
+	// need checking on every instruction
+	u32 hookflags = DEBUG_FLAG_HOOKED | DEBUG_FLAG_STEPPING_ANY | DEBUG_FLAG_STOP_PC;
+	bool compiled = bool(m_bpcompiler);
+	for (registerpoint *rp = m_rplist; rp != nullptr && compiled; rp = rp->m_next)
+		if (rp->m_enabled)
+			compiled = false;
+	if (!compiled)
+		hookflags |= DEBUG_FLAG_HISTORY | DEBUG_FLAG_LIVE_BP;
+	if ((m_flags & hookflags) != 0)
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
 
 	// also call if we are tracing
@@ -2587,14 +2675,15 @@ void device_debug::prepare_for_step_overout(offs_t pc)
 
 void device_debug::breakpoint_update_flags()
 {
-	// see if there are any enabled breakpoints
+	// see if there are any enabled breakpoints, and index them all by address
+	std::unordered_set<offs_t> addresses;
 	m_flags &= ~DEBUG_FLAG_LIVE_BP;
 	for (breakpoint *bp = m_bplist; bp != nullptr; bp = bp->m_next)
+	{
+		addresses.insert(bp->m_address);
 		if (bp->m_enabled)
-		{
 			m_flags |= DEBUG_FLAG_LIVE_BP;
-			break;
-		}
+	}
 
 	if ( ! ( m_flags & DEBUG_FLAG_LIVE_BP ) )
 	{
@@ -2608,12 +2697,34 @@ void device_debug::breakpoint_update_flags()
 		}
 	}
 
+	// let a compiling core know if the addresses moved
+	if (addresses != m_bpaddrs)
+	{
+		m_bpaddrs = std::move(addresses);
+		if (m_bpcompiler)
+			m_bpcompiler();
+	}
+
 	// push the flags out globally
 	if (m_device.machine().debugger().cpu().live_cpu() != nullptr)
 		m_device.machine().debugger().cpu().live_cpu()->debug()->compute_debug_flags();
 }
 
 
+//-------------------------------------------------
+//  set_breakpoint_compiler - register a DRC core
+//  that calls instruction_hook() itself at
+//  breakpoint addresses
+//-------------------------------------------------
+
+void device_debug::set_breakpoint_compiler(std::function<void ()> &&changed)
+{
+	m_bpcompiler = std::move(changed);
+	if (m_bpcompiler)
+		m_bpcompiler();
+}
+
+
 //-------------------------------------------------
 //  breakpoint_check - check the breakpoints for
 //  a given device
@@ -2624,21 +2735,22 @@ void device_debug::breakpoint_check(offs_t pc)
 	debugger_cpu& debugcpu = m_device.machine().debugger().cpu();
 
 	// see if we match
-	for (breakpoint *bp = m_bplist; bp != nullptr; bp = bp->m_next)
-		if (bp->hit(pc))
-		{
-			// halt in the debugger by default
-			debugcpu.set_execution_stopped();
+	if (breakpoint_at(pc))
+		for (breakpoint *bp = m_bplist; bp != nullptr; bp = bp->m_next)
+			if (bp->hit(pc))
+			{
+				// halt in the debugger by default
+				debugcpu.set_execution_stopped();
 
-			// if we hit, evaluate the action
-			if (!bp->m_action.empty())
-				m_device.machine().debugger().console().execute_command(bp->m_action, false);
+				// if we hit, evaluate the action
+				if (!bp->m_action.empty())
+					m_device.machine().debugger().console().execute_command(bp->m_action, false);
 
-			// print a notification, unless the action made us go again
-			if (debugcpu.is_stopped())
-				m_device.machine().debugger().console().printf("Stopped at breakpoint %X\n", bp->m_index);
-			break;
-		}
+				// print a notification, unless the action made us go again
+				if (debugcpu.is_stopped())
+					m_device.machine().debugger().console().printf("Stopped at breakpoint %X\n", bp->m_index);
+				break;
+			}
 
 	// see if we have any matching registerpoints
 	for (registerpoint *rp = m_rplist; rp != nullptr; rp = rp->m_next)
@@ -2672,26 +2784,30 @@ void device_debug::breakpoint_check(offs_t pc)
 
 void device_debug::watchpoint_update_flags(address_space &space)
 {
-	// if hotspots are enabled, turn on all reads
-	bool enableread = false;
-	if (!m_hotspots.empty())
-		enableread = true;
+	int const spacenum = space.spacenum();
+	if (spacenum >= int(m_wpintervals.size()))
+		m_wpintervals.resize(spacenum + 1);
 
-	// see if there are any enabled breakpoints
-	bool enablewrite = false;
-	if (space.spacenum() < int(m_wplist.size()))
-		for (watchpoint *wp = m_wplist[space.spacenum()]; wp != nullptr; wp = wp->m_next)
-			if (wp->m_enabled)
-			{
-				if (wp->m_type & WATCHPOINT_READ)
-					enableread = true;
-				if (wp->m_type & WATCHPOINT_WRITE)
-					enablewrite = true;
-			}
+	// gather the ranges covered by enabled watchpoints
+	std::vector<std::pair<offs_t, offs_t>> readranges, writeranges;
+	watchpoint *list = (spacenum < int(m_wplist.size())) ? m_wplist[spacenum] : nullptr;
+	for (watchpoint *wp = list; wp != nullptr; wp = wp->m_next)
+		if (wp->m_enabled && wp->m_length != 0)
+		{
+			offs_t const end = (wp->m_address + wp->m_length - 1 < wp->m_address) ? ~offs_t(0) : wp->m_address + wp->m_length - 1;
+			if (wp->m_type & WATCHPOINT_READ)
+				readranges.emplace_back(wp->m_address, end);
+			if (wp->m_type & WATCHPOINT_WRITE)
+				writeranges.emplace_back(wp->m_address, end);
+		}
+	m_wpintervals[spacenum].rebuild(list);
 
-	// push the flags out globally
-	space.enable_read_watchpoints(enableread);
-	space.enable_write_watchpoints(enablewrite);
+	// push the ranges out; hotspots need to see every read
+	if (!m_hotspots.empty())
+		space.enable_read_watchpoints(true);
+	else
+		space.watch_read_ranges(readranges);
+	space.watch_write_ranges(writeranges);
 }
 
 
@@ -2702,10 +2818,10 @@ void device_debug::watchpoint_update_flags(address_space &space)
 
 void device_debug::watchpoint_check(address_space& space, int type, offs_t address, u64 value_to_write, u64 mem_mask)
 {
-	m_device.machine().debugger().cpu().watchpoint_check(space, type, address, value_to_write, mem_mask, m_wplist);
+	m_device.machine().debugger().cpu().watchpoint_check(space, type, address, value_to_write, mem_mask, m_wpintervals);
 }
 
-void debugger_cpu::watchpoint_check(address_space& space, int type, offs_t address, u64 value_to_write, u64 mem_mask, std::vector<device_debug::watchpoint *> &wplist)
+void debugger_cpu::watchpoint_check(address_space& space, int type, offs_t address, u64 value_to_write, u64 mem_mask, const std::vector<device_debug::watchpoint_index> &wpintervals)
 {
 	// if we're within debugger code, don't stop
 	if (m_within_instruction_hook || m_machine.side_effects_disabled())
@@ -2757,43 +2873,44 @@ void debugger_cpu::watchpoint_check(address_space& space, int type, offs_t addre
 	if (type & WATCHPOINT_WRITE)
 		m_wpdata = value_to_write;
 
-	// see if we match
-	if (space.spacenum() < int(wplist.size()))
-		for (device_debug::watchpoint *wp = wplist[space.spacenum()]; wp != nullptr; wp = wp->next())
-			if (wp->hit(type, address, size))
-			{
-				// halt in the debugger by default
-				m_execution_state = exec_state::STOPPED;
+	// see if we match; the first hit in list order wins, as with a linear scan
+	device_debug::watchpoint_index const *const index = (space.spacenum() < int(wpintervals.size())) ? &wpintervals[space.spacenum()] : nullptr;
+	int order = -1;
+	for (device_debug::watchpoint *wp = index ? index->next(address, size, order) : nullptr; wp != nullptr; wp = index->next(address, size, order))
+		if (wp->hit(type, address, size))
+		{
+			// halt in the debugger by default
+			m_execution_state = exec_state::STOPPED;
 
-				// if we hit, evaluate the action
-				if (!wp->action().empty())
-					m_machine.debugger().console().execute_command(wp->action(), false);
+			// if we hit, evaluate the action
+			if (!wp->action().empty())
+				m_machine.debugger().console().execute_command(wp->action(), false);
 
-				// print a notification, unless the action made us go again
-				if (m_execution_state == exec_state::STOPPED)
+			// print a notification, unless the action made us go again
+			if (m_execution_state == exec_state::STOPPED)
+			{
+				static const char *const sizes[] =
+				{
+					"0bytes", "byte", "word", "3bytes", "dword", "5bytes", "6bytes", "7bytes", "qword"
+				};
+				offs_t pc = space.device().safe_pcbase();
+				std::string buffer;
+
+				if (type & WATCHPOINT_WRITE)
 				{
-					static const char *const sizes[] =
-					{
-						"0bytes", "byte", "word", "3bytes", "dword", "5bytes", "6bytes", "7bytes", "qword"
-					};
-					offs_t pc = space.device().safe_pcbase();
-					std::string buffer;
-
-					if (type & WATCHPOINT_WRITE)
-					{
-						buffer = string_format("Stopped at watchpoint %X writing %s to %08X (PC=%X)", wp->index(), sizes[size], address, pc);
-						if (value_to_write >> 32)
-							buffer.append(string_format(" (data=%X%08X)", u32(value_to_write >> 32), u32(value_to_write)));
-						else
-							buffer.append(string_format(" (data=%X)", u32(value_to_write)));
-					}
+					buffer = string_format("Stopped at watchpoint %X writing %s to %08X (PC=%X)", wp->index(), sizes[size], address, pc);
+					if (value_to_write >> 32)
+						buffer.append(string_format(" (data=%X%08X)", u32(value_to_write >> 32), u32(value_to_write)));
 					else
-						buffer = string_format("Stopped at watchpoint %X reading %s from %08X (PC=%X)", wp->index(), sizes[size], address, pc);
-					m_machine.debugger().console().printf("%s\n", buffer.c_str());
-					space.device().debug()->compute_debug_flags();
+						buffer.append(string_format(" (data=%X)", u32(value_to_write)));
 				}
-				break;
+				else
+					buffer = string_format("Stopped at watchpoint %X reading %s from %08X (PC=%X)", wp->index(), sizes[size], address, pc);
+				m_machine.debugger().console().printf("%s\n", buffer.c_str());
+				space.device().debug()->compute_debug_flags();
 			}
+			break;
+		}
 
 	m_within_instruction_hook = false;
 }
@@ -3041,6 +3158,61 @@ bool device_debug::watchpoint::hit(int type, offs_t address, int size)
 
 
 
+//-------------------------------------------------
+//  rebuild - index every watchpoint in a list by
+//  the range it covers; disabled ones are left
+//  for hit() to reject
+//-------------------------------------------------
+
+void device_debug::watchpoint_index::rebuild(watchpoint *list)
+{
+	m_entries.clear();
+	int order = 0;
+	for (watchpoint *wp = list; wp != nullptr; wp = wp->next(), order++)
+	{
+		if (wp->length() == 0)
+			continue;
+		offs_t const end = wp->address() + wp->length() - 1;
+		m_entries.push_back({ wp->address(), (end < wp->address()) ? ~offs_t(0) : end, 0, order, wp });
+	}
+
+	std::sort(m_entries.begin(), m_entries.end(), [] (const entry &a, const entry &b) { return a.m_start < b.m_start; });
+	offs_t max_end = 0;
+	for (entry &e : m_entries)
+		e.m_max_end = max_end = std::max(max_end, e.m_end);
+}
+
+
+//-------------------------------------------------
+//  next - return the first watchpoint in list
+//  order after the given position whose range
+//  overlaps an access of size bytes; start with
+//  order at -1
+//-------------------------------------------------
+
+device_debug::watchpoint *device_debug::watchpoint_index::next(offs_t address, offs_t size, int &order) const
+{
+	offs_t const last = address + std::max<offs_t>(size, 1) - 1;
+
+	// walk back from the last range starting within the access while
+	// an earlier range could still reach it; accesses rarely overlap
+	// more than one watchpoint, so walking again for each is cheap
+	const entry *found = nullptr;
+	auto it = std::upper_bound(m_entries.begin(), m_entries.end(), last, [] (offs_t value, const entry &e) { return value < e.m_start; });
+	while (it != m_entries.begin() && (it - 1)->m_max_end >= address)
+	{
+		--it;
+		if (it->m_end >= address && it->m_order > order && (found == nullptr || it->m_order < found->m_order))
+			found = &*it;
+	}
+
+	if (found == nullptr)
+		return nullptr;
+	order = found->m_order;
+	return found->m_watchpoint;
+}
+
+
 //**************************************************************************
 //  DEBUG REGISTERPOINT
 //**************************************************************************
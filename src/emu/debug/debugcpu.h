@@ -16,6 +16,7 @@
 #include "express.h"
 
 #include <set>
+#include <unordered_set>
 
 
 //**************************************************************************
@@ -133,6 +134,30 @@ public:
 		std::string          m_action;                   // action
 	};
 
+	// interval index over the watchpoints of one address space
+	class watchpoint_index
+	{
+	public:
+		// rebuild from a watchpoint list
+		void rebuild(watchpoint *list);
+
+		// return the first watchpoint in list order after position order
+		// that may overlap an access, updating order to its position
+		watchpoint *next(offs_t address, offs_t size, int &order) const;
+
+	private:
+		struct entry
+		{
+			offs_t          m_start;                    // first byte watched
+			offs_t          m_end;                      // last byte watched
+			offs_t          m_max_end;                  // highest m_end up to and including this entry
+			int             m_order;                    // position in the watchpoint list
+			watchpoint *    m_watchpoint;
+		};
+
+		std::vector<entry>  m_entries;                  // sorted by start address
+	};
+
 	// registerpoint class
 	class registerpoint
 	{
@@ -219,6 +244,13 @@ public:
 	void breakpoint_clear_all();
 	bool breakpoint_enable(int index, bool enable = true);
 	void breakpoint_enable_all(bool enable = true);
+	bool breakpoint_at(offs_t address) const { return m_bpaddrs.find(address) != m_bpaddrs.end(); }
+
+	// DRC cores that compile a call to instruction_hook() at each address
+	// where breakpoint_at() is true register here, and are told when those
+	// addresses change; while only breakpoints are live the debugger then
+	// no longer asks for the hook on every instruction
+	void set_breakpoint_compiler(std::function<void ()> &&changed);
 
 	// watchpoints
 	int watchpoint_space_count() const { return m_wplist.size(); }
@@ -332,7 +364,10 @@ private:
 
 	// breakpoints and watchpoints
 	breakpoint *            m_bplist;                   // list of breakpoints
+	std::unordered_set<offs_t> m_bpaddrs;               // addresses with a breakpoint, enabled or not
+	std::function<void ()>  m_bpcompiler;               // told when m_bpaddrs changes, if breakpoints are compiled
 	std::vector<watchpoint *> m_wplist;                 // watchpoint lists for each address space
+	std::vector<watchpoint_index> m_wpintervals;        // watchpoint interval index for each address space
 	registerpoint *         m_rplist;                   // list of registerpoints
 
 	// tracing
@@ -530,6 +565,9 @@ public:
 	/* return 1,2,4 or 8 bytes from the specified memory space */
 	u64 read_memory(address_space &space, offs_t address, int size, bool apply_translation);
 
+	/* copy a range of byte addresses from the specified memory space */
+	void read_block(address_space &space, offs_t address, u32 length, u8 *dest, bool apply_translation);
+
 	/* write a byte to the specified memory space */
 	void write_byte(address_space &space, offs_t address, u8 data, bool apply_translation);
 
@@ -575,7 +613,7 @@ public:
 	void ensure_comments_loaded();
 	void reset_transient_flags();
 	void process_source_file();
-	void watchpoint_check(address_space& space, int type, offs_t address, u64 value_to_write, u64 mem_mask, std::vector<device_debug::watchpoint *> &wplist);
+	void watchpoint_check(address_space& space, int type, offs_t address, u64 value_to_write, u64 mem_mask, const std::vector<device_debug::watchpoint_index> &wpintervals);
 
 private:
 	static const size_t NUM_TEMP_VARIABLES;
@@ -90,6 +90,8 @@ static const help_item static_help_list[] =
 		"  history [<CPU>,<length>] -- outputs a brief history of visited opcodes\n"
 		"  trackpc [<bool>,<CPU>,<bool>] -- visually track visited opcodes [boolean to turn on and off, for the given CPU, clear]\n"
 		"  trackmem [<bool>,<bool>] -- record which PC writes to each memory address [boolean to turn on and off, clear]\n"
+		"  coverage [<bool>,<CPU>,<bool>] -- record read, written and executed addresses [boolean to turn on and off, for the given CPU, clear]\n"
+		"  coversave <filename>[,<CPU>] -- save recorded coverage to a binary file\n"
 		"  pcatmemp <address>[,<CPU>] -- query which PC wrote to a given program memory address for the current CPU\n"
 		"  pcatmemd <address>[,<CPU>] -- query which PC wrote to a given data memory address for the current CPU\n"
 		"  pcatmemi <address>[,<CPU>] -- query which PC wrote to a given I/O memory address for the current CPU\n"
@@ -426,6 +428,45 @@ static const help_item static_help_list[] =
 		"trackpc 1, 0, 1\n"
 		"  Continue tracking pc on CPU 0, but clear existing track info.\n"
 	},
+	{
+		"coverage",
+		"\n"
+		"  coverage [<bool>,<CPU>,<bool>]\n"
+		"\n"
+		"The coverage command records which addresses in each of a CPU's address spaces are read, "
+		"written and executed, along with hit counts per 16 addresses for heatmaps.  The first boolean "
+		"argument toggles recording on and off; turning it off prints a summary.  The second argument "
+		"is a CPU selector; if no CPU is specified, the current CPU is automatically selected.  The "
+		"third argument is a boolean denoting if the existing data should be cleared or not.  Use "
+		"coversave to write the data to a file, and covtool to render or compare saved files.  Reads and "
+		"writes are recorded by the memory system, which sends every access in the CPU's spaces down its "
+		"watchpoint path while recording is on.  Executed addresses come from the instruction hook, or on "
+		"recompiling cores from a call at the start of each straight run of compiled code; accesses made "
+		"through direct pointers (such as DRC fast RAM) are not seen.  The -coverage option records every "
+		"CPU from startup without the debugger.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"coverage 1\n"
+		"  Begin recording coverage on the current CPU.\n"
+		"\n"
+		"coverage 1,audiocpu,1\n"
+		"  Record coverage on the audiocpu device, dropping anything recorded before.\n"
+	},
+	{
+		"coversave",
+		"\n"
+		"  coversave <filename>[,<CPU>]\n"
+		"\n"
+		"The coversave command writes the coverage recorded with the coverage command to <filename>.  "
+		"If no CPU is specified, the current CPU is automatically selected.  Recording continues "
+		"unaffected.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"coversave run1.cov\n"
+		"  Save the current CPU's coverage to run1.cov.\n"
+	},
 	{
 		"trackmem",
 		"\n"
@@ -177,8 +177,11 @@ void debug_view_breakpoints::view_click(const int button, const debug_view_xy& p
 		if ((bpIndex >= m_buffer.size()) || (bpIndex < 0))
 			return;
 
-		// Enable / disable
-		m_buffer[bpIndex]->setEnabled(!m_buffer[bpIndex]->enabled());
+		// Enable / disable through the owner so its flags follow
+		device_debug::breakpoint &bp = *m_buffer[bpIndex];
+		for (device_t &device : device_iterator(machine().root_device()))
+			if (device.debug() != nullptr && device.debug()->breakpoint_enable(bp.index(), !bp.enabled()))
+				break;
 
 		machine().debug_view().update_all(DVT_DISASSEMBLY);
 	}
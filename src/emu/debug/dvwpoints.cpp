@@ -202,8 +202,11 @@ void debug_view_watchpoints::view_click(const int button, const debug_view_xy& p
 		if ((wpIndex >= m_buffer.size()) || (wpIndex < 0))
 			return;
 
-		// Enable / disable
-		m_buffer[wpIndex]->setEnabled(!m_buffer[wpIndex]->enabled());
+		// Enable / disable through the owner so the watched pages follow
+		device_debug::watchpoint &wp = *m_buffer[wpIndex];
+		for (device_t &device : device_iterator(machine().root_device()))
+			if (device.debug() != nullptr && device.debug()->watchpoint_enable(wp.index(), !wp.enabled()))
+				break;
 	}
 
 	begin_update();
@@ -27,6 +27,20 @@
     0x000e       ,
     0x000f       func()
 
+****************************************************************************
+
+    Execution
+    =========
+    Parsing produces a postfix token list, which is then compiled to a
+    flat program: constants are folded, symbols backed by a variable are
+    read straight from it, and operand types are checked once instead of
+    on every execution.  Operands are still read when an operator
+    consumes them, in the same order as the token interpreter, so reads
+    with side effects behave identically.  Expressions that would fail
+    while executing (e.g. an assignment to a non-lvalue) are not
+    compiled; they run through the token interpreter, which reports the
+    error as before.
+
 ***************************************************************************/
 
 #include "emu.h"
@@ -98,7 +112,11 @@ enum
 	TVL_ASSIGNBOR,
 	TVL_COMMA,
 	TVL_MEMORYAT,
-	TVL_EXECUTEFUNC
+	TVL_EXECUTEFUNC,
+
+	// compiled program operands
+	XOP_CONSTANT,
+	XOP_SYMBOL
 };
 
 
@@ -121,11 +139,17 @@ public:
 	virtual u64 value() const override;
 	virtual void set_value(u64 newvalue) override;
 
+	// direct access for compiled expressions
+	u64 *pointer() const { return m_pointer; }
+	bool is_constant() const { return m_constant; }
+
 private:
 	// internal state
 	symbol_table::getter_func   m_getter;
 	symbol_table::setter_func   m_setter;
 	u64                         m_value;
+	u64 *                       m_pointer;      // variable behind the getter/setter, if there is one
+	bool                        m_constant;     // value never changes
 };
 
 
@@ -237,7 +261,9 @@ integer_symbol_entry::integer_symbol_entry(symbol_table &table, const char *name
 				: ptr
 				? symbol_table::setter_func([ptr] (symbol_table &table, u64 value) { *ptr = value; })
 				: symbol_table::setter_func([this] (symbol_table &table, u64 value) { m_value = value; })),
-		m_value(0)
+		m_value(0),
+		m_pointer(ptr ? ptr : &m_value),
+		m_constant(false)
 {
 }
 
@@ -246,7 +272,9 @@ integer_symbol_entry::integer_symbol_entry(symbol_table &table, const char *name
 	: symbol_entry(table, SMT_INTEGER, name, ""),
 		m_getter([this] (symbol_table &table) { return m_value; }),
 		m_setter(nullptr),
-		m_value(constval)
+		m_value(constval),
+		m_pointer(&m_value),
+		m_constant(true)
 {
 }
 
@@ -255,7 +283,9 @@ integer_symbol_entry::integer_symbol_entry(symbol_table &table, const char *name
 	: symbol_entry(table, SMT_INTEGER, name, format),
 		m_getter(getter),
 		m_setter(setter),
-		m_value(0)
+		m_value(0),
+		m_pointer(nullptr),
+		m_constant(false)
 {
 }
 
@@ -562,12 +592,16 @@ void parsed_expression::parse(const char *expression)
 	m_original_string.assign(expression);
 	m_tokenlist.reset();
 	m_stringlist.reset();
+	m_program.clear();
 
 	// first parse the tokens into the token array in order
 	parse_string_into_tokens();
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// lower the postfix tokens to a program
+	compile();
 }
 
 
@@ -577,10 +611,15 @@ void parsed_expression::parse(const char *expression)
 
 void parsed_expression::copy(const parsed_expression &src)
 {
+	// re-parse rather than copying tokens, which point at the source's strings
+	std::string const expression(src.m_original_string);
 	m_symtable = src.m_symtable;
-	m_original_string.assign(src.m_original_string);
-	if (!m_original_string.empty())
-		parse_string_into_tokens();
+	m_original_string.assign(expression);
+	m_tokenlist.reset();
+	m_stringlist.reset();
+	m_program.clear();
+	if (!expression.empty())
+		parse(expression.c_str());
 }
 
 
@@ -1669,6 +1708,522 @@ u64 parsed_expression::execute_tokens()
 }
 
 
+//-------------------------------------------------
+//  compile - lower the postfix token list to a
+//  program, leaving m_program empty if executing
+//  the tokens would raise an error
+//-------------------------------------------------
+
+void parsed_expression::compile()
+{
+	// what the token interpreter would hold in each stack slot
+	enum operand_kind
+	{
+		NUMBER,
+		SYMBOL,
+		MEMORY
+	};
+	struct operand
+	{
+		operand_kind    kind;
+		symbol_entry *  symbol;
+		int             offset;     // token offset, as the interpreter tracks it
+		int             constant;   // index of the instruction pushing a constant, or -1
+	};
+
+	operand stack[MAX_STACK_DEPTH];
+	int depth = 0;
+	int result_offset = 0;
+	bool failed = false;
+
+	auto push = [&] (operand_kind kind, symbol_entry *symbol, int offset, int constant)
+	{
+		if (depth >= MAX_STACK_DEPTH)
+			failed = true;
+		else
+			stack[depth++] = operand{ kind, symbol, offset, constant };
+	};
+	auto pop_rval = [&] () -> operand
+	{
+		if (depth == 0 || (stack[depth - 1].kind == SYMBOL && stack[depth - 1].symbol->is_function()))
+		{
+			failed = true;
+			return operand{ NUMBER, nullptr, 0, -1 };
+		}
+		operand result = stack[--depth];
+		result.kind = NUMBER;
+		return result;
+	};
+	auto pop_lval = [&] () -> operand
+	{
+		if (depth == 0 || stack[depth - 1].kind == NUMBER || (stack[depth - 1].kind == SYMBOL && !stack[depth - 1].symbol->is_lval()))
+		{
+			failed = true;
+			return operand{ NUMBER, nullptr, 0, -1 };
+		}
+		return stack[--depth];
+	};
+	auto emit = [this] (u8 opcode, int offset) -> instruction &
+	{
+		m_program.push_back(instruction{ opcode, false, 0, EXPSPACE_INVALID, offset, 0, nullptr, nullptr, nullptr });
+		return m_program.back();
+	};
+	auto emit_constant = [&] (u64 value, int offset)
+	{
+		emit(XOP_CONSTANT, offset).value = value;
+		push(NUMBER, nullptr, offset, int(m_program.size() - 1));
+	};
+
+	m_program.clear();
+	for (parse_token &token : m_tokenlist)
+	{
+		// numbers are constants
+		if (token.is_number())
+			emit_constant(token.value(), token.offset());
+
+		// functions stay on the stack only until their call; constant symbols are folded
+		else if (token.is_symbol())
+		{
+			symbol_entry *symbol = token.symbol();
+			integer_symbol_entry *integer = symbol->is_function() ? nullptr : downcast<integer_symbol_entry *>(symbol);
+			if (integer == nullptr)
+				push(SYMBOL, symbol, token.offset(), -1);
+			else if (integer->is_constant())
+				emit_constant(integer->value(), token.offset());
+			else
+			{
+				instruction &inst = emit(XOP_SYMBOL, token.offset());
+				inst.symbol = symbol;
+				inst.pointer = integer->pointer();
+				push(SYMBOL, symbol, token.offset(), -1);
+			}
+		}
+
+		// strings can't be consumed by anything, and memory tokens only exist while executing
+		else if (!token.is_operator())
+			failed = true;
+
+		else
+		{
+			u8 const optype = token.optype();
+			switch (optype)
+			{
+				case TVL_PREINCREMENT:
+				case TVL_PREDECREMENT:
+				case TVL_POSTINCREMENT:
+				case TVL_POSTDECREMENT:
+				{
+					operand const t1 = pop_lval();
+					emit(optype, t1.offset);
+					result_offset = t1.offset;
+					push(NUMBER, nullptr, t1.offset, -1);
+					break;
+				}
+
+				case TVL_COMPLEMENT:
+				case TVL_NOT:
+				case TVL_UPLUS:
+				case TVL_UMINUS:
+				{
+					operand const t1 = pop_rval();
+					result_offset = t1.offset;
+					if (t1.constant >= 0 && t1.constant == int(m_program.size() - 1))
+					{
+						u64 const value = m_program.back().value;
+						m_program.pop_back();
+						switch (optype)
+						{
+							case TVL_COMPLEMENT:    emit_constant(!value, t1.offset);   break;
+							case TVL_NOT:           emit_constant(~value, t1.offset);   break;
+							case TVL_UPLUS:         emit_constant(value, t1.offset);    break;
+							case TVL_UMINUS:        emit_constant(-value, t1.offset);   break;
+						}
+					}
+					else
+					{
+						emit(optype, t1.offset);
+						push(NUMBER, nullptr, t1.offset, -1);
+					}
+					break;
+				}
+
+				case TVL_MULTIPLY:
+				case TVL_DIVIDE:
+				case TVL_MODULO:
+				case TVL_ADD:
+				case TVL_SUBTRACT:
+				case TVL_LSHIFT:
+				case TVL_RSHIFT:
+				case TVL_LESS:
+				case TVL_LESSOREQUAL:
+				case TVL_GREATER:
+				case TVL_GREATEROREQUAL:
+				case TVL_EQUAL:
+				case TVL_NOTEQUAL:
+				case TVL_BAND:
+				case TVL_BXOR:
+				case TVL_BOR:
+				case TVL_LAND:
+				case TVL_LOR:
+				{
+					operand const t2 = pop_rval();
+					operand const t1 = pop_rval();
+					int const offset = std::min(t1.offset, t2.offset);
+					result_offset = offset;
+
+					// fold two constants pushed by the last two instructions, leaving division by zero to fail at run time
+					bool const divide = (optype == TVL_DIVIDE || optype == TVL_MODULO);
+					if (t1.constant >= 0 && t1.constant == int(m_program.size() - 2) && t2.constant == int(m_program.size() - 1) &&
+							!(divide && m_program.back().value == 0))
+					{
+						u64 const b = m_program.back().value;
+						m_program.pop_back();
+						u64 const a = m_program.back().value;
+						m_program.pop_back();
+						u64 value = 0;
+						switch (optype)
+						{
+							case TVL_MULTIPLY:          value = a * b;      break;
+							case TVL_DIVIDE:            value = a / b;      break;
+							case TVL_MODULO:            value = a % b;      break;
+							case TVL_ADD:               value = a + b;      break;
+							case TVL_SUBTRACT:          value = a - b;      break;
+							case TVL_LSHIFT:            value = a << b;     break;
+							case TVL_RSHIFT:            value = a >> b;     break;
+							case TVL_LESS:              value = a < b;      break;
+							case TVL_LESSOREQUAL:       value = a <= b;     break;
+							case TVL_GREATER:           value = a > b;      break;
+							case TVL_GREATEROREQUAL:    value = a >= b;     break;
+							case TVL_EQUAL:             value = a == b;     break;
+							case TVL_NOTEQUAL:          value = a != b;     break;
+							case TVL_BAND:              value = a & b;      break;
+							case TVL_BXOR:              value = a ^ b;      break;
+							case TVL_BOR:               value = a | b;      break;
+							case TVL_LAND:              value = a && b;     break;
+							case TVL_LOR:               value = a || b;     break;
+						}
+						emit_constant(value, offset);
+					}
+					else
+					{
+						emit(optype, divide ? t2.offset : offset);
+						push(NUMBER, nullptr, offset, -1);
+					}
+					break;
+				}
+
+				case TVL_ASSIGN:
+				{
+					operand const t2 = pop_rval();
+					pop_lval();
+					emit(optype, t2.offset);
+					result_offset = t2.offset;
+					push(NUMBER, nullptr, t2.offset, -1);
+					break;
+				}
+
+				case TVL_ASSIGNMULTIPLY:
+				case TVL_ASSIGNDIVIDE:
+				case TVL_ASSIGNMODULO:
+				case TVL_ASSIGNADD:
+				case TVL_ASSIGNSUBTRACT:
+				case TVL_ASSIGNLSHIFT:
+				case TVL_ASSIGNRSHIFT:
+				case TVL_ASSIGNBAND:
+				case TVL_ASSIGNBXOR:
+				case TVL_ASSIGNBOR:
+				{
+					operand const t2 = pop_rval();
+					operand const t1 = pop_lval();
+					int const offset = std::min(t1.offset, t2.offset);
+					emit(optype, t2.offset);
+					result_offset = offset;
+					push(NUMBER, nullptr, offset, -1);
+					break;
+				}
+
+				case TVL_COMMA:
+					if (!token.is_function_separator())
+					{
+						operand const t2 = pop_rval();
+						operand const t1 = pop_rval();
+						if (t1.constant >= 0 && t1.constant == int(m_program.size() - 2) && t2.constant == int(m_program.size() - 1))
+						{
+							u64 const value = m_program.back().value;
+							m_program.pop_back();
+							m_program.pop_back();
+							emit_constant(value, t2.offset);
+						}
+						else
+						{
+							emit(optype, t2.offset);
+							push(NUMBER, nullptr, t2.offset, -1);
+						}
+					}
+					break;
+
+				case TVL_MEMORYAT:
+				{
+					pop_rval();
+					instruction &inst = emit(optype, result_offset);
+					inst.disable_se = token.memory_side_effects();
+					inst.size = 1 << token.memory_size();
+					inst.space = token.memory_space();
+					inst.name = token.memory_source();
+					push(MEMORY, nullptr, result_offset, -1);
+					break;
+				}
+
+				case TVL_EXECUTEFUNC:
+				{
+					// parameters are everything above the function symbol
+					int paramcount = 0;
+					symbol_entry *function = nullptr;
+					while (!failed && function == nullptr)
+					{
+						if (depth == 0 || paramcount == MAX_FUNCTION_PARAMS)
+							failed = true;
+						else if (stack[depth - 1].kind == SYMBOL && stack[depth - 1].symbol->is_function())
+							function = stack[--depth].symbol;
+						else
+						{
+							pop_rval();
+							paramcount++;
+						}
+					}
+					instruction &inst = emit(optype, token.offset());
+					inst.value = paramcount;
+					inst.symbol = function;
+					push(NUMBER, nullptr, token.offset(), -1);
+					break;
+				}
+
+				default:
+					failed = true;
+					break;
+			}
+		}
+
+		if (failed)
+			break;
+	}
+
+	// the interpreter requires exactly one rval to be left
+	if (!failed)
+	{
+		pop_rval();
+		if (depth != 0)
+			failed = true;
+	}
+
+	if (failed)
+		m_program.clear();
+}
+
+
+//-------------------------------------------------
+//  read_entry - return the value of a stack entry,
+//  reading its symbol or memory if it has one
+//-------------------------------------------------
+
+inline u64 parsed_expression::read_entry(const stack_entry &entry)
+{
+	const instruction *const lval = entry.lval;
+	if (lval == nullptr)
+		return entry.value;
+
+	if (lval->opcode == XOP_SYMBOL)
+		return (lval->pointer != nullptr) ? *lval->pointer : lval->symbol->value();
+
+	if (m_symtable != nullptr)
+		return m_symtable->memory_value(lval->name, lval->space, u32(entry.value), lval->size, lval->disable_se);
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  write_entry - set the symbol or memory a stack
+//  entry refers to
+//-------------------------------------------------
+
+inline void parsed_expression::write_entry(const stack_entry &entry, u64 value)
+{
+	const instruction *const lval = entry.lval;
+	if (lval->opcode == XOP_SYMBOL)
+	{
+		if (lval->pointer != nullptr)
+			*lval->pointer = value;
+		else
+			lval->symbol->set_value(value);
+	}
+	else if (m_symtable != nullptr)
+		m_symtable->set_memory_value(lval->name, lval->space, u32(entry.value), lval->size, value, lval->disable_se);
+}
+
+
+//-------------------------------------------------
+//  execute_program - execute the compiled form of
+//  the expression
+//-------------------------------------------------
+
+u64 parsed_expression::execute_program()
+{
+	stack_entry stack[MAX_STACK_DEPTH];
+	int sp = 0;
+
+	// operands are popped right first, as the token interpreter does
+	for (const instruction &inst : m_program)
+	{
+		switch (inst.opcode)
+		{
+			case XOP_CONSTANT:
+				stack[sp++] = stack_entry{ inst.value, nullptr };
+				break;
+
+			case XOP_SYMBOL:
+				stack[sp++] = stack_entry{ 0, &inst };
+				break;
+
+			case TVL_PREINCREMENT:
+			case TVL_PREDECREMENT:
+			case TVL_POSTINCREMENT:
+			case TVL_POSTDECREMENT:
+			{
+				stack_entry const t1 = stack[sp - 1];
+				u64 const value = read_entry(t1);
+				u64 const newvalue = (inst.opcode == TVL_PREINCREMENT || inst.opcode == TVL_POSTINCREMENT) ? value + 1 : value - 1;
+				stack[sp - 1] = stack_entry{ (inst.opcode == TVL_PREINCREMENT || inst.opcode == TVL_PREDECREMENT) ? newvalue : value, nullptr };
+				write_entry(t1, newvalue);
+				break;
+			}
+
+			case TVL_COMPLEMENT:    stack[sp - 1] = stack_entry{ !read_entry(stack[sp - 1]), nullptr }; break;
+			case TVL_NOT:           stack[sp - 1] = stack_entry{ ~read_entry(stack[sp - 1]), nullptr }; break;
+			case TVL_UPLUS:         stack[sp - 1] = stack_entry{ read_entry(stack[sp - 1]), nullptr };  break;
+			case TVL_UMINUS:        stack[sp - 1] = stack_entry{ -read_entry(stack[sp - 1]), nullptr }; break;
+
+			case TVL_MULTIPLY:
+			case TVL_DIVIDE:
+			case TVL_MODULO:
+			case TVL_ADD:
+			case TVL_SUBTRACT:
+			case TVL_LSHIFT:
+			case TVL_RSHIFT:
+			case TVL_LESS:
+			case TVL_LESSOREQUAL:
+			case TVL_GREATER:
+			case TVL_GREATEROREQUAL:
+			case TVL_EQUAL:
+			case TVL_NOTEQUAL:
+			case TVL_BAND:
+			case TVL_BXOR:
+			case TVL_BOR:
+			case TVL_LAND:
+			case TVL_LOR:
+			case TVL_COMMA:
+			{
+				u64 const b = read_entry(stack[--sp]);
+				u64 const a = read_entry(stack[sp - 1]);
+				u64 value;
+				switch (inst.opcode)
+				{
+					case TVL_MULTIPLY:          value = a * b;      break;
+					case TVL_DIVIDE:
+						if (b == 0)
+							throw expression_error(expression_error::DIVIDE_BY_ZERO, inst.offset);
+						value = a / b;
+						break;
+					case TVL_MODULO:
+						if (b == 0)
+							throw expression_error(expression_error::DIVIDE_BY_ZERO, inst.offset);
+						value = a % b;
+						break;
+					case TVL_ADD:               value = a + b;      break;
+					case TVL_SUBTRACT:          value = a - b;      break;
+					case TVL_LSHIFT:            value = a << b;     break;
+					case TVL_RSHIFT:            value = a >> b;     break;
+					case TVL_LESS:              value = a < b;      break;
+					case TVL_LESSOREQUAL:       value = a <= b;     break;
+					case TVL_GREATER:           value = a > b;      break;
+					case TVL_GREATEROREQUAL:    value = a >= b;     break;
+					case TVL_EQUAL:             value = a == b;     break;
+					case TVL_NOTEQUAL:          value = a != b;     break;
+					case TVL_BAND:              value = a & b;      break;
+					case TVL_BXOR:              value = a ^ b;      break;
+					case TVL_BOR:               value = a | b;      break;
+					case TVL_LAND:              value = a && b;     break;
+					case TVL_LOR:               value = a || b;     break;
+					default:                    value = b;          break;  // TVL_COMMA
+				}
+				stack[sp - 1] = stack_entry{ value, nullptr };
+				break;
+			}
+
+			case TVL_ASSIGN:
+			{
+				u64 const value = read_entry(stack[--sp]);
+				stack_entry const t1 = stack[sp - 1];
+				stack[sp - 1] = stack_entry{ value, nullptr };
+				write_entry(t1, value);
+				break;
+			}
+
+			case TVL_ASSIGNMULTIPLY:
+			case TVL_ASSIGNDIVIDE:
+			case TVL_ASSIGNMODULO:
+			case TVL_ASSIGNADD:
+			case TVL_ASSIGNSUBTRACT:
+			case TVL_ASSIGNLSHIFT:
+			case TVL_ASSIGNRSHIFT:
+			case TVL_ASSIGNBAND:
+			case TVL_ASSIGNBXOR:
+			case TVL_ASSIGNBOR:
+			{
+				u64 const b = read_entry(stack[--sp]);
+				stack_entry const t1 = stack[sp - 1];
+				if (b == 0 && (inst.opcode == TVL_ASSIGNDIVIDE || inst.opcode == TVL_ASSIGNMODULO))
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, inst.offset);
+				u64 const a = read_entry(t1);
+				u64 value;
+				switch (inst.opcode)
+				{
+					case TVL_ASSIGNMULTIPLY:    value = a * b;      break;
+					case TVL_ASSIGNDIVIDE:      value = a / b;      break;
+					case TVL_ASSIGNMODULO:      value = a % b;      break;
+					case TVL_ASSIGNADD:         value = a + b;      break;
+					case TVL_ASSIGNSUBTRACT:    value = a - b;      break;
+					case TVL_ASSIGNLSHIFT:      value = a << b;     break;
+					case TVL_ASSIGNRSHIFT:      value = a >> b;     break;
+					case TVL_ASSIGNBAND:        value = a & b;      break;
+					case TVL_ASSIGNBXOR:        value = a ^ b;      break;
+					default:                    value = a | b;      break;  // TVL_ASSIGNBOR
+				}
+				stack[sp - 1] = stack_entry{ value, nullptr };
+				write_entry(t1, value);
+				break;
+			}
+
+			case TVL_MEMORYAT:
+				stack[sp - 1] = stack_entry{ u32(read_entry(stack[sp - 1])), &inst };
+				break;
+
+			case TVL_EXECUTEFUNC:
+			{
+				u64 funcparams[MAX_FUNCTION_PARAMS];
+				int const paramcount = int(inst.value);
+				for (int param = paramcount - 1; param >= 0; param--)
+					funcparams[param] = read_entry(stack[--sp]);
+				stack[sp++] = stack_entry{ downcast<function_symbol_entry *>(inst.symbol)->execute(paramcount, funcparams), nullptr };
+				break;
+			}
+		}
+	}
+
+	// compile() guarantees a single value is left
+	return read_entry(stack[0]);
+}
+
+
 
 //**************************************************************************
 //  PARSE TOKEN
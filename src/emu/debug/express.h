@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -230,7 +231,8 @@ public:
 
 	// execution
 	void parse(const char *string);
-	u64 execute() { return execute_tokens(); }
+	u64 execute() { return m_program.empty() ? execute_tokens() : execute_program(); }
+	u64 execute_interpreted() { return execute_tokens(); }
 
 private:
 	// a single token
@@ -294,6 +296,7 @@ private:
 		expression_space memory_space() const { assert(m_type == OPERATOR || m_type == MEMORY); return expression_space((m_flags & TIN_MEMORY_SPACE_MASK) >> TIN_MEMORY_SPACE_SHIFT); }
 		int memory_size() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_MEMORY_SIZE_MASK) >> TIN_MEMORY_SIZE_SHIFT; }
 		bool memory_side_effects() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_SIDE_EFFECT_MASK) >> TIN_SIDE_EFFECT_SHIFT; }
+		const char *memory_source() const { assert(m_type == OPERATOR || m_type == MEMORY); return m_string; }
 
 		// setters
 		parse_token &set_offset(int offset) { m_offset = offset; return *this; }
@@ -349,6 +352,28 @@ private:
 		std::string         m_string;                   // copy of the string
 	};
 
+	// a single step of the compiled form of an expression
+	struct instruction
+	{
+		u8                  opcode;         // TVL_* operator or XOP_* operand
+		bool                disable_se;     // memory access without side effects
+		u8                  size;           // memory access size in bytes
+		expression_space    space;          // memory space
+		int                 offset;         // offset reported on errors
+		u64                 value;          // constant value or parameter count
+		u64 *               pointer;        // storage of a pointer-backed symbol
+		symbol_entry *      symbol;         // symbol or function
+		const char *        name;           // memory name
+	};
+
+	// a value on the execution stack; lval points at the instruction
+	// describing the symbol or memory it is read from when consumed
+	struct stack_entry
+	{
+		u64                 value;          // number, or memory address
+		const instruction * lval;           // symbol/memory reference, or nullptr
+	};
+
 	// internal helpers
 	void copy(const parsed_expression &src);
 	void print_tokens(FILE *out);
@@ -372,6 +397,12 @@ private:
 	u64 execute_tokens();
 	void execute_function(parse_token &token);
 
+	// compiled execution helpers
+	void compile();
+	u64 execute_program();
+	u64 read_entry(const stack_entry &entry);
+	void write_entry(const stack_entry &entry, u64 value);
+
 	// constants
 	static const int MAX_FUNCTION_PARAMS = 16;
 	static const int MAX_STACK_DEPTH = 16;
@@ -381,6 +412,7 @@ private:
 	std::string         m_original_string;              // original string (prior to parsing)
 	simple_list<parse_token> m_tokenlist;               // token list
 	simple_list<expression_string> m_stringlist;        // string list
+	std::vector<instruction> m_program;                 // compiled token list (empty to interpret)
 	int                 m_token_stack_ptr;              // stack pointer (used during execution)
 	parse_token         m_token_stack[MAX_STACK_DEPTH]; // token stack (used during execution)
 };
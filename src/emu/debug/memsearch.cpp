@@ -0,0 +1,183 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/*********************************************************************
+
+    memsearch.cpp
+
+    Bulk memory search for the debugger.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "memsearch.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// positions searched per slice; big enough that queueing costs nothing
+constexpr size_t FIND_GRAIN = 256 * 1024;
+
+
+
+//**************************************************************************
+//  SEARCH PATTERN
+//**************************************************************************
+
+//-------------------------------------------------
+//  add - append a value laid out the way the
+//  address space would return it
+//-------------------------------------------------
+
+void memory_search::pattern::add(u64 value, int size, endianness_t endian)
+{
+	for (int i = 0; i < size; i++)
+	{
+		int const shift = 8 * ((endian == ENDIANNESS_LITTLE) ? i : (size - 1 - i));
+		m_bytes.push_back(u8(value >> shift));
+		m_mask.push_back(0xff);
+	}
+}
+
+
+//-------------------------------------------------
+//  add_wildcard - append bytes that match
+//  anything
+//-------------------------------------------------
+
+void memory_search::pattern::add_wildcard(int size)
+{
+	m_bytes.insert(m_bytes.end(), size, 0);
+	m_mask.insert(m_mask.end(), size, 0);
+}
+
+
+//-------------------------------------------------
+//  matches - compare the pattern against memory
+//-------------------------------------------------
+
+bool memory_search::pattern::matches(const u8 *data) const
+{
+	for (size_t i = 0; i < m_bytes.size(); i++)
+		if ((data[i] & m_mask[i]) != m_bytes[i])
+			return false;
+	return true;
+}
+
+
+
+//**************************************************************************
+//  MEMORY SEARCH
+//**************************************************************************
+
+//-------------------------------------------------
+//  memory_search - constructor
+//-------------------------------------------------
+
+memory_search::memory_search()
+	: m_queue(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  ~memory_search - destructor
+//-------------------------------------------------
+
+memory_search::~memory_search()
+{
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  find - find all matches of a pattern
+//-------------------------------------------------
+
+void memory_search::find(const u8 *data, size_t positions, size_t step, const pattern &pat, std::vector<size_t> &results)
+{
+	results.clear();
+	if (positions == 0 || pat.length() == 0)
+		return;
+
+	// anchor on the first byte that is not a wildcard
+	auto const anchor = std::find(pat.m_mask.begin(), pat.m_mask.end(), 0xff);
+	size_t const anchoroffs = anchor - pat.m_mask.begin();
+	bool const wildcard = (anchor == pat.m_mask.end());
+	u8 const anchorbyte = wildcard ? 0 : pat.m_bytes[anchoroffs];
+
+	// each slice collects its own matches, concatenated in order afterwards
+	size_t const slices = (positions + FIND_GRAIN - 1) / FIND_GRAIN;
+	std::vector<std::vector<size_t>> found(slices);
+	parallel_for(positions, FIND_GRAIN, [&] (size_t begin, size_t end)
+	{
+		std::vector<size_t> &result = found[begin / FIND_GRAIN];
+		size_t pos = (begin + step - 1) / step * step;
+		while (pos < end)
+		{
+			// let memchr skip ahead to the next candidate
+			if (!wildcard)
+			{
+				const u8 *const start = data + pos + anchoroffs;
+				const u8 *const hit = (const u8 *)memchr(start, anchorbyte, end - pos);
+				if (hit == nullptr)
+					break;
+				pos += hit - start;
+				if (pos % step != 0)
+				{
+					pos = (pos / step + 1) * step;
+					continue;
+				}
+			}
+			if (pat.matches(data + pos))
+				result.push_back(pos);
+			pos += step;
+		}
+	});
+
+	for (auto &result : found)
+		results.insert(results.end(), result.begin(), result.end());
+}
+
+
+//-------------------------------------------------
+//  parallel_for - run a function over slices of
+//  a range on the work queue
+//-------------------------------------------------
+
+void memory_search::parallel_for(size_t count, size_t grain, const std::function<void (size_t, size_t)> &func)
+{
+	if (count <= grain)
+	{
+		if (count != 0)
+			func(0, count);
+		return;
+	}
+
+	if (m_queue == nullptr)
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	std::vector<slice> slices;
+	for (size_t begin = 0; begin < count; begin += grain)
+		slices.push_back({ &func, begin, std::min(begin + grain, count) });
+
+	osd_work_item_queue_multiple(m_queue, slice_callback, slices.size(), &slices[0], sizeof(slices[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(m_queue, osd_ticks_per_second() * 3600);
+}
+
+
+//-------------------------------------------------
+//  slice_callback - run one slice on a worker
+//-------------------------------------------------
+
+void *memory_search::slice_callback(void *param, int threadid)
+{
+	slice const &s = *reinterpret_cast<slice const *>(param);
+	(*s.func)(s.begin, s.end);
+	return nullptr;
+}
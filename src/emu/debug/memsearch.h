@@ -0,0 +1,80 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/*********************************************************************
+
+    memsearch.h
+
+    Bulk memory search for the debugger.
+
+    Searches run over memory that has already been copied out of an
+    address space in large blocks, so matching never goes back
+    through the address space accessors.  Large searches are split
+    into slices that run in parallel on a work queue.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_DEBUG_MEMSEARCH_H
+#define MAME_EMU_DEBUG_MEMSEARCH_H
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+
+struct osd_work_queue;
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> memory_search
+
+class memory_search
+{
+public:
+	// a byte sequence with wildcards
+	class pattern
+	{
+		friend class memory_search;
+
+	public:
+		// construction
+		void add(u64 value, int size, endianness_t endian);
+		void add_wildcard(int size);
+
+		// getters
+		u32 length() const { return m_bytes.size(); }
+		bool matches(const u8 *data) const;
+
+	private:
+		std::vector<u8>     m_bytes;                // bytes to match
+		std::vector<u8>     m_mask;                 // 0xff where the byte matters, 0 for wildcards
+	};
+
+	// construction/destruction
+	memory_search();
+	~memory_search();
+
+	// find every position that is a multiple of step below positions; data must
+	// hold positions + pattern length - 1 bytes
+	void find(const u8 *data, size_t positions, size_t step, const pattern &pat, std::vector<size_t> &results);
+
+	// call func(begin, end) over slices of [0, count) in parallel; counts up to
+	// grain run inline on the calling thread
+	void parallel_for(size_t count, size_t grain, const std::function<void (size_t, size_t)> &func);
+
+private:
+	struct slice
+	{
+		const std::function<void (size_t, size_t)> *func;
+		size_t          begin;
+		size_t          end;
+	};
+
+	static void *slice_callback(void *param, int threadid);
+
+	osd_work_queue *    m_queue;                // allocated on the first parallel search
+};
+
+#endif // MAME_EMU_DEBUG_MEMSEARCH_H
@@ -54,6 +54,7 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	, m_icountptr(nullptr)
 	, m_cycles_running(0)
 	, m_cycles_stolen(0)
+	, m_exec_coverage(nullptr)
 	, m_suspend(0)
 	, m_nextsuspend(0)
 	, m_eatcycles(0)
@@ -14,6 +14,8 @@
 
 #include "debug/debugcpu.h"
 
+#include "coverage.h"
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -190,6 +192,11 @@ public:
 	// required operation overrides
 	void run() { execute_run(); }
 
+	// coverage of executed addresses, fed by the instruction hook and by
+	// recompiled code (nullptr when not recording)
+	util::coverage_map *exec_coverage() const { return m_exec_coverage; }
+	void set_exec_coverage(util::coverage_map *map) { m_exec_coverage = map; }
+
 	// deliberately ambiguous functions; if you have the execute interface
 	// just use it
 	device_execute_interface &execute() { return *this; }
@@ -229,7 +236,12 @@ protected:
 	void debugger_instruction_hook(offs_t curpc)
 	{
 		if (device().machine().debug_flags & DEBUG_FLAG_CALL_HOOK)
-			device().debug()->instruction_hook(curpc);
+		{
+			if (m_exec_coverage)
+				m_exec_coverage->record(util::coverage_map::EXEC, curpc);
+			if (device().machine().debug_flags & DEBUG_FLAG_ENABLED)
+				device().debug()->instruction_hook(curpc);
+		}
 	}
 	void debugger_exception_hook(int exception)
 	{
@@ -306,6 +318,7 @@ private:
 	int *                   m_icountptr;                // pointer to the icount
 	int                     m_cycles_running;           // number of cycles we are executing
 	int                     m_cycles_stolen;            // number of cycles we artificially stole
+	util::coverage_map *    m_exec_coverage;            // executed addresses, when recording coverage
 
 	// suspend states
 	u32                     m_suspend;                  // suspend reason mask (0 = not suspended)
@@ -106,6 +106,7 @@ class address_map; // Forward declaration
 // generic helpers
 #include "devcb.h"
 #include "bookkeeping.h"
+#include "covrecord.h"
 #include "video/generic.h"
 
 // member templates that don't like incomplete types
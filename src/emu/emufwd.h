@@ -73,6 +73,9 @@ class bookkeeping_manager;
 enum class config_type;
 class configuration_manager;
 
+// declared in covrecord.h
+class coverage_recorder;
+
 // declared in crsshair.h
 class crosshair_manager;
 
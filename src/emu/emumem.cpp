@@ -183,6 +183,8 @@
 #include "emuopts.h"
 #include "debug/debugcpu.h"
 
+#include "coverage.h"
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -570,7 +572,7 @@ public:
 
 	// getters
 	virtual handler_entry &handler(u32 index) const = 0;
-	bool watchpoints_enabled() const { return (m_live_lookup == s_watchpoint_table); }
+	bool watchpoints_enabled() const { return (m_live_lookup != &m_table[0]); }
 
 	// address lookups
 	u32 lookup_live(offs_t address) const { return m_large ? lookup_live_large(address) : lookup_live_small(address); }
@@ -603,8 +605,14 @@ public:
 		return entry;
 	}
 
-	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	// enable watchpoints on the whole space by swapping in the watchpoint table
+	void enable_watchpoints(bool enable = true);
+
+	// enable watchpoints only on the pages covering a set of byte ranges
+	void watch_ranges(const std::vector<std::pair<offs_t, offs_t>> &ranges);
+
+	// route every access through the watchpoint handler to record it
+	void set_coverage(util::coverage_map *map);
 
 	// table mapping helpers
 	void map_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, u16 staticentry);
@@ -635,11 +643,20 @@ protected:
 	void subtable_close(offs_t l1index);
 	u16 *subtable_ptr(u16 entry) { return &m_table[level2_index(entry, 0)]; }
 
+	// watchpoint table management
+	u16 *live_table() { return (m_watch_all || m_coverage) ? s_watchpoint_table : !m_watch_ranges.empty() ? &m_watch_table[0] : &m_table[0]; }
+	bool debugger_watching() const { return m_watch_all || !m_watch_ranges.empty(); }
+	void watch_table_update();
+
 	// internal state
 	std::vector<u16>   m_table;                    // pointer to base of table
 	u16 *                m_live_lookup;              // current lookup
+	std::vector<u16>        m_watch_table;              // copy of the table with watched pages redirected
+	std::vector<std::pair<offs_t, offs_t>> m_watch_ranges; // watched byte ranges, inclusive
 	address_space &         m_space;                    // pointer back to the space
 	bool                    m_large;                    // large memory model?
+	bool                    m_watch_all;                // whole space watched?
+	util::coverage_map *    m_coverage;                 // map recording every access, if any
 
 	// subtable_data is an internal class with information about each subtable
 	class subtable_data
@@ -745,16 +762,18 @@ private:
 	{
 		int base_shift = sizeof(UintType) == 1 ? 0 : sizeof(UintType) == 2 ? 1 : sizeof(UintType) == 4 ? 2 : 3;
 		offset = offset << (AddrShift + base_shift);
-		m_space.device().debug()->memory_read_hook(m_space, offset, mask);
+		if (m_coverage)
+			m_coverage->record(util::coverage_map::READ, offset);
+		if (debugger_watching())
+			m_space.device().debug()->memory_read_hook(m_space, offset, mask);
 
-		u16 *oldtable = m_live_lookup;
 		m_live_lookup = &m_table[0];
 		UintType result;
 		if (sizeof(UintType) == 1) result = m_space.read_byte(offset);
 		if (sizeof(UintType) == 2) result = m_space.read_word(offset, mask);
 		if (sizeof(UintType) == 4) result = m_space.read_dword(offset, mask);
 		if (sizeof(UintType) == 8) result = m_space.read_qword(offset, mask);
-		m_live_lookup = oldtable;
+		m_live_lookup = live_table();
 		return result;
 	}
 
@@ -814,15 +833,17 @@ private:
 	{
 		int base_shift = sizeof(UintType) == 1 ? 0 : sizeof(UintType) == 2 ? 1 : sizeof(UintType) == 4 ? 2 : 3;
 		offset = offset << (AddrShift + base_shift);
-		m_space.device().debug()->memory_write_hook(m_space, offset, data, mask);
+		if (m_coverage)
+			m_coverage->record(util::coverage_map::WRITE, offset);
+		if (debugger_watching())
+			m_space.device().debug()->memory_write_hook(m_space, offset, data, mask);
 
-		u16 *oldtable = m_live_lookup;
 		m_live_lookup = &m_table[0];
 		if (sizeof(UintType) == 1) m_space.write_byte(offset, data);
 		if (sizeof(UintType) == 2) m_space.write_word(offset, data, mask);
 		if (sizeof(UintType) == 4) m_space.write_dword(offset, data, mask);
 		if (sizeof(UintType) == 8) m_space.write_qword(offset, data, mask);
-		m_live_lookup = oldtable;
+		m_live_lookup = live_table();
 	}
 
 	// internal state
@@ -1053,6 +1074,9 @@ public:
 	// watchpoint control
 	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
 	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
+	virtual void watch_read_ranges(const std::vector<std::pair<offs_t, offs_t>> &ranges) override { m_read.watch_ranges(ranges); }
+	virtual void watch_write_ranges(const std::vector<std::pair<offs_t, offs_t>> &ranges) override { m_write.watch_ranges(ranges); }
+	virtual void set_coverage(util::coverage_map *map) override { m_read.set_coverage(map); m_write.set_coverage(map); }
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
@@ -3165,6 +3189,8 @@ address_table::address_table(address_space &space, bool large)
 	: m_table(1 << LEVEL1_BITS),
 		m_space(space),
 		m_large(large),
+		m_watch_all(false),
+		m_coverage(nullptr),
 		m_subtable(SUBTABLE_COUNT),
 		m_subtable_alloc(0)
 {
@@ -3199,6 +3225,84 @@ address_table::~address_table()
 }
 
 
+//-------------------------------------------------
+//  enable_watchpoints - route every access in the
+//  space through the watchpoint handler
+//-------------------------------------------------
+
+void address_table::enable_watchpoints(bool enable)
+{
+	m_watch_all = enable;
+	m_watch_ranges.clear();
+	m_watch_table.clear();
+	m_live_lookup = live_table();
+}
+
+
+//-------------------------------------------------
+//  watch_ranges - route only accesses to the
+//  pages covering the given byte ranges through
+//  the watchpoint handler, leaving the rest of
+//  the space on the normal table
+//-------------------------------------------------
+
+void address_table::watch_ranges(const std::vector<std::pair<offs_t, offs_t>> &ranges)
+{
+	m_watch_all = false;
+	m_watch_ranges = ranges;
+	if (m_watch_ranges.empty())
+		m_watch_table.clear();
+	else
+		watch_table_update();
+	m_live_lookup = live_table();
+}
+
+
+//-------------------------------------------------
+//  set_coverage - record every access in the
+//  space to the given map; the debugger's hooks
+//  are still only called for what it watches
+//-------------------------------------------------
+
+void address_table::set_coverage(util::coverage_map *map)
+{
+	m_coverage = map;
+	m_live_lookup = live_table();
+}
+
+
+//-------------------------------------------------
+//  watch_table_update - rebuild the watch table
+//  from the current table; small tables are
+//  redirected per address, large ones per level 1
+//  entry
+//-------------------------------------------------
+
+void address_table::watch_table_update()
+{
+	bool const was_live = !m_watch_table.empty() && (m_live_lookup == &m_watch_table[0]);
+	m_watch_table = m_table;
+
+	// accesses are looked up at the native word address
+	offs_t const native_mask = (m_space.data_width() / 8) - 1;
+	for (auto &range : m_watch_ranges)
+	{
+		offs_t const start = (range.first & m_space.addrmask()) & ~native_mask;
+		offs_t const end = std::min(range.second, m_space.addrmask()) | native_mask;
+		if (start > end)
+			continue;
+
+		if (m_large)
+			std::fill(&m_watch_table[level1_index_large(start)], &m_watch_table[level1_index_large(end)] + 1, STATIC_WATCHPOINT);
+		else
+			std::fill(&m_watch_table[start], &m_watch_table[end] + 1, STATIC_WATCHPOINT);
+	}
+
+	if (was_live)
+		m_live_lookup = &m_watch_table[0];
+}
+
+
 //-------------------------------------------------
 //  map_range - map a specific entry in the address
 //  map
@@ -3225,6 +3329,10 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 	// recompute any direct access on this space if it is a read modification
 	m_space.invalidate_read_caches(entry);
 
+	// keep the watched pages in step with the new mapping
+	if (!m_watch_ranges.empty())
+		watch_table_update();
+
 	//  verify_reference_counts();
 }
 
@@ -3250,10 +3358,16 @@ std::list<u32> address_table::setup_range(offs_t addrstart, offs_t addrend, offs
 	// Careful, you can't shift by 64 or more
 	u64 testmask = (1ULL << (m_space.data_width()-1) << 1) - 1;
 
+	std::list<u32> entries;
 	if ((umask & testmask) == 0 || (umask & testmask) == testmask || range_simply_masks(addrstart, addrend, addrmask, addrmirror, umask))
-		return setup_range_solid(addrstart, addrend, addrmask, addrmirror);
+		entries = setup_range_solid(addrstart, addrend, addrmask, addrmirror);
 	else
-		return setup_range_masked(addrstart, addrend, addrmask, addrmirror, umask);
+		entries = setup_range_masked(addrstart, addrend, addrmask, addrmirror, umask);
+
+	// keep the watched pages in step with the new mapping
+	if (!m_watch_ranges.empty())
+		watch_table_update();
+	return entries;
 }
 
 //-------------------------------------------------
@@ -59,6 +59,9 @@ class address_table_read;
 class address_table_setoffset;
 class address_table_write;
 
+// coverage maps live in the utility library
+namespace util { class coverage_map; }
+
 // offsets and addresses are 32-bit (for now...)
 typedef u32 offs_t;
 
@@ -277,9 +280,16 @@ public:
 	void set_log_unmap(bool log) { m_log_unmap = log; }
 	void dump_map(FILE *file, read_or_write readorwrite);
 
-	// watchpoint enablers
+	// watchpoint enablers; the range versions only slow down accesses to
+	// the pages covering the given inclusive byte ranges
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
+	virtual void watch_read_ranges(const std::vector<std::pair<offs_t, offs_t>> &ranges) = 0;
+	virtual void watch_write_ranges(const std::vector<std::pair<offs_t, offs_t>> &ranges) = 0;
+
+	// record every read and write to the given map; this takes the same
+	// path as watchpoints but needs no debugger (nullptr to stop)
+	virtual void set_coverage(util::coverage_map *map) = 0;
 
 	// general accessors
 	virtual void accessors(data_accessors &accessors) const = 0;
@@ -75,6 +75,7 @@
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_AUDIOTHROTTLE        "audiothrottle"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -121,6 +122,7 @@
 // core sound options
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
+#define OPTION_SAMPLE_CACHE         "samplecache"
 #define OPTION_VOLUME               "volume"
 
 // core input options
@@ -158,6 +160,8 @@
 #define OPTION_OSLOG                "oslog"
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
+#define OPTION_DRC_BREAKPOINTS      "drc_breakpoints"
+#define OPTION_COVERAGE             "coverage"
 
 // core misc options
 #define OPTION_DRC                  "drc"
@@ -357,6 +361,7 @@ public:
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	bool audio_throttle() const { return bool_value(OPTION_AUDIOTHROTTLE); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -403,6 +408,7 @@ public:
 	// core sound options
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
+	int sample_cache() const { return int_value(OPTION_SAMPLE_CACHE); }
 	int volume() const { return int_value(OPTION_VOLUME); }
 
 	// core input options
@@ -438,6 +444,8 @@ public:
 	bool oslog() const { return bool_value(OPTION_OSLOG); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	bool drc_breakpoints() const { return bool_value(OPTION_DRC_BREAKPOINTS); }
+	const char *coverage() const { return value(OPTION_COVERAGE); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
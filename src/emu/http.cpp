@@ -11,6 +11,10 @@ HTTP server handling
 #include "emu.h"
 #include "server_ws_impl.hpp"
 #include "server_http_impl.hpp"
+#include "png.h"
+#include "screen.h"
+#include "spscqueue.h"
+#include <condition_variable>
 #include <fstream>
 
 #include <inttypes.h>
@@ -253,6 +257,20 @@ struct websocket_connection_impl : public http_manager::websocket_connection {
 		}
 	}
 
+	/** Sends a binary message made of a header and a body, calling back once it has been written.
+	 * Returns false if the connection is gone. */
+	bool send_binary(const std::vector<u8> &header, const u8 *data, size_t length, const std::function<void(const std::error_code&)> &callback) {
+		if (auto connection = m_connection.lock()) {
+			std::shared_ptr<webpp::ws_server::SendStream> message_stream = std::make_shared<webpp::ws_server::SendStream>();
+			message_stream->write(reinterpret_cast<const char *>(header.data()), header.size());
+			if (length != 0)
+				message_stream->write(reinterpret_cast<const char *>(data), length);
+			m_wsserver->send(connection, message_stream, callback, 0x82);
+			return true;
+		}
+		return false;
+	}
+
 	/** Closes this open Websocket connection. */
 	virtual void close() {
 		if (auto connection = m_connection.lock()) {
@@ -261,8 +279,565 @@ struct websocket_connection_impl : public http_manager::websocket_connection {
 	}
 };
 
+/** An append-only file in memory, so PNG frames can be encoded without touching the disk. */
+class memory_output_file : public util::core_file
+{
+public:
+	memory_output_file(std::vector<u8> &data) : m_data(data), m_offset(0) { m_data.clear(); }
+
+	virtual osd_file::error compress(int level) override { return osd_file::error::FAILURE; }
+	virtual int seek(std::int64_t offset, int whence) override
+	{
+		switch (whence)
+		{
+		case SEEK_SET: m_offset = offset; break;
+		case SEEK_CUR: m_offset += offset; break;
+		case SEEK_END: m_offset = m_data.size() + offset; break;
+		}
+		return 0;
+	}
+	virtual std::uint64_t tell() const override { return m_offset; }
+	virtual bool eof() const override { return m_offset >= m_data.size(); }
+	virtual std::uint64_t size() const override { return m_data.size(); }
+	virtual std::uint32_t read(void *buffer, std::uint32_t length) override { return 0; }
+	virtual int getc() override { return EOF; }
+	virtual int ungetc(int c) override { return EOF; }
+	virtual char *gets(char *s, int n) override { return nullptr; }
+	virtual const void *buffer() override { return m_data.data(); }
+	virtual std::uint32_t write(const void *buffer, std::uint32_t length) override
+	{
+		if (m_offset + length > m_data.size())
+			m_data.resize(m_offset + length);
+		std::memcpy(&m_data[m_offset], buffer, length);
+		m_offset += length;
+		return length;
+	}
+	virtual int puts(const char *s) override { return write(s, std::strlen(s)); }
+	virtual int vprintf(util::format_argument_pack<std::ostream> const &args) override
+	{
+		std::ostringstream text;
+		util::stream_format(text, args);
+		return write(text.str().c_str(), text.str().length());
+	}
+	virtual osd_file::error truncate(std::uint64_t offset) override { m_data.resize(offset); return osd_file::error::NONE; }
+	virtual osd_file::error flush() override { return osd_file::error::NONE; }
+
+private:
+	std::vector<u8> &m_data;
+	std::uint64_t m_offset;
+};
+
+/** Pushes frames, audio and memory snapshots to websocket clients.
+ *
+ * The emulation thread copies what is due into pooled packets and hands them to the
+ * stream thread through a lock-free queue; the stream thread encodes each packet once
+ * and queues it on every client that has fewer than MAX_IN_FLIGHT messages still
+ * being written. Packets and clients that cannot keep up are dropped, never waited for.
+ *
+ * All messages are binary and little-endian, starting with a type byte:
+ *   FRAME_RAW/FRAME_PNG: u32 frame, u16 width, u16 height, then xRGB32 pixels or a PNG
+ *   AUDIO: u32 sample rate, u32 sample frames, then interleaved stereo s16 samples
+ *   MEMORY: u32 frame, then for each watch u32 id, u32 address, u32 length and the bytes
+ *
+ * Clients configure their stream with text messages:
+ *   /stream/frame: "rate <n>" (every nth frame), "scale <n>" (downscale 1-8), "format raw|png"
+ *   /stream/memory: "rate <n>", "watch <id> <device tag> <space> <first> <last>" (hex addresses), "unwatch <id>"
+ */
+class http_manager::stream_hub
+{
+public:
+	enum stream_type { FRAME, AUDIO, MEMORY, STREAM_COUNT };
+	enum message_type : u8 { FRAME_RAW = 1, FRAME_PNG, AUDIO_CHUNK, MEMORY_SNAPSHOT };
+
+	static constexpr int MAX_IN_FLIGHT = 2;
+	static constexpr int MAX_SCALE = 8;
+
+	stream_hub(http_manager &manager);
+	~stream_hub();
+
+	void frame(running_machine &machine, const bitmap_rgb32 *source);
+	void machine_exit();
+	bool active(stream_type type) const { return m_divider[type].load(std::memory_order_relaxed) != 0; }
+	void audio(const s16 *samples, int frames, int rate);
+
+private:
+	struct watch
+	{
+		u32 id;
+		std::string tag;
+		int spacenum;
+		offs_t first, last;
+	};
+
+	struct client
+	{
+		client(std::shared_ptr<websocket_connection_impl> &&connection, stream_type type) : connection(std::move(connection)), type(type), rate(1), scale(1), png(false), in_flight(std::make_shared<std::atomic<int>>(0)) { }
+
+		std::shared_ptr<websocket_connection_impl> connection;
+		stream_type type;
+		u32 rate;                                   // frames between messages
+		int scale;                                  // frame downscale factor
+		bool png;                                   // frames as PNG rather than raw pixels
+		std::vector<watch> watches;
+		std::shared_ptr<std::atomic<int>> in_flight; // messages queued but not yet written
+	};
+
+	// a client due for a message, copied out so encoding runs without the lock
+	struct target
+	{
+		const void *key;
+		std::shared_ptr<websocket_connection_impl> connection;
+		std::shared_ptr<std::atomic<int>> in_flight;
+		int scale;
+		bool png;
+	};
+
+	// resolved watch on the emulation side
+	struct live_watch
+	{
+		const void *client;
+		u32 id;
+		address_space *space;
+		offs_t first, last;
+	};
+
+	struct packet
+	{
+		struct range
+		{
+			const void *client;
+			u32 id;
+			offs_t address;
+			size_t offset, length;
+		};
+
+		stream_type type;
+		u32 frame;
+		int width, height;
+		u32 rate;
+		std::vector<u8> data;
+		std::vector<range> ranges;
+	};
+	typedef std::unique_ptr<packet> packet_ptr;
+
+	void open(websocket_connection_ptr connection, stream_type type);
+	void message(websocket_connection_ptr connection, const std::string &payload);
+	void close(websocket_connection_ptr connection);
+	void update_divider(stream_type type);
+
+	packet_ptr acquire(stream_type type);
+	void submit(packet_ptr &&pkt);
+	void thread_main();
+	void send_frame(const packet &pkt);
+	void send_audio(const packet &pkt);
+	void send_memory(const packet &pkt);
+	std::vector<target> targets(stream_type type, u32 frame);
+	void send(const target &t, const std::vector<u8> &header, const u8 *data, size_t length);
+
+	http_manager &m_manager;
+
+	// clients and their settings, shared with the server thread
+	std::mutex m_clients_mutex;
+	std::unordered_map<const void *, client> m_clients;
+	std::atomic<u32> m_divider[STREAM_COUNT];       // gcd of the client rates, 0 with no clients
+	std::atomic<u32> m_watch_generation;
+
+	// emulation side
+	running_machine *m_machine;
+	u32 m_frame;
+	u32 m_live_generation;
+	std::vector<live_watch> m_live_watches;
+	u64 m_dropped;
+
+	// handover to the stream thread
+	util::spsc_queue<packet_ptr, 16> m_queue;
+	util::spsc_queue<packet_ptr, 16> m_recycle;
+	std::mutex m_wakeup_mutex;
+	std::condition_variable m_wakeup;
+	bool m_pending;
+	bool m_exit;
+	std::thread m_thread;
+};
+
+http_manager::stream_hub::stream_hub(http_manager &manager)
+	: m_manager(manager), m_watch_generation(0), m_machine(nullptr), m_frame(0), m_live_generation(~u32(0)), m_dropped(0), m_pending(false), m_exit(false)
+{
+	for (auto &divider : m_divider)
+		divider = 0;
+
+	static const char *const paths[STREAM_COUNT] = { "/stream/frame", "/stream/audio", "/stream/memory" };
+	for (int type = 0; type < STREAM_COUNT; type++)
+	{
+		m_manager.add_endpoint(paths[type],
+				[this, type] (websocket_connection_ptr connection) { open(connection, stream_type(type)); },
+				[this] (websocket_connection_ptr connection, const std::string &payload, int opcode) { message(connection, payload); },
+				[this] (websocket_connection_ptr connection, int status, const std::string &reason) { close(connection); },
+				[this] (websocket_connection_ptr connection, const std::error_code &error_code) { close(connection); });
+	}
+
+	m_thread = std::thread([this] () { thread_main(); });
+}
+
+http_manager::stream_hub::~stream_hub()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeup_mutex);
+		m_exit = true;
+	}
+	m_wakeup.notify_one();
+	m_thread.join();
+}
+
+void http_manager::stream_hub::open(websocket_connection_ptr connection, stream_type type)
+{
+	std::lock_guard<std::mutex> lock(m_clients_mutex);
+	m_clients.emplace(connection.get(), client(std::static_pointer_cast<websocket_connection_impl>(connection), type));
+	update_divider(type);
+}
+
+void http_manager::stream_hub::close(websocket_connection_ptr connection)
+{
+	std::lock_guard<std::mutex> lock(m_clients_mutex);
+	auto i = m_clients.find(connection.get());
+	if (i != m_clients.end()) {
+		stream_type const type = i->second.type;
+		bool const watched = !i->second.watches.empty();
+		m_clients.erase(i);
+		update_divider(type);
+		if (watched)
+			m_watch_generation++;
+	}
+}
+
+void http_manager::stream_hub::message(websocket_connection_ptr connection, const std::string &payload)
+{
+	std::lock_guard<std::mutex> lock(m_clients_mutex);
+	auto i = m_clients.find(connection.get());
+	if (i == m_clients.end())
+		return;
+	client &c = i->second;
+
+	std::istringstream stream(payload);
+	std::string command;
+	stream >> command;
+	if (command == "rate") {
+		u32 rate;
+		if (stream >> rate && rate != 0) {
+			c.rate = rate;
+			update_divider(c.type);
+		}
+	} else if (command == "scale") {
+		int scale;
+		if (stream >> scale)
+			c.scale = std::min(std::max(scale, 1), MAX_SCALE);
+	} else if (command == "format") {
+		std::string format;
+		stream >> format;
+		c.png = (format == "png");
+	} else if (command == "watch" && c.type == MEMORY) {
+		watch w;
+		if (stream >> w.id >> w.tag >> w.spacenum >> std::hex >> w.first >> w.last && w.first <= w.last) {
+			c.watches.push_back(std::move(w));
+			m_watch_generation++;
+		}
+	} else if (command == "unwatch" && c.type == MEMORY) {
+		u32 id;
+		if (stream >> id) {
+			c.watches.erase(std::remove_if(c.watches.begin(), c.watches.end(), [id] (const watch &w) { return w.id == id; }), c.watches.end());
+			m_watch_generation++;
+		}
+	}
+}
+
+// called with m_clients_mutex held
+void http_manager::stream_hub::update_divider(stream_type type)
+{
+	u32 divider = 0;
+	for (auto &entry : m_clients) {
+		if (entry.second.type == type) {
+			u32 a = divider, b = entry.second.rate;
+			while (b != 0) { u32 t = a % b; a = b; b = t; }
+			divider = a;
+		}
+	}
+	m_divider[type] = divider;
+}
+
+http_manager::stream_hub::packet_ptr http_manager::stream_hub::acquire(stream_type type)
+{
+	packet_ptr pkt;
+	if (!m_recycle.pop(pkt))
+		pkt = std::make_unique<packet>();
+	pkt->type = type;
+	pkt->frame = m_frame;
+	pkt->ranges.clear();
+	return pkt;
+}
+
+void http_manager::stream_hub::submit(packet_ptr &&pkt)
+{
+	// the stream thread is behind: drop rather than wait for it
+	if (!m_queue.push(std::move(pkt))) {
+		m_dropped++;
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_wakeup_mutex);
+		m_pending = true;
+	}
+	m_wakeup.notify_one();
+}
+
+void http_manager::stream_hub::frame(running_machine &machine, const bitmap_rgb32 *source)
+{
+	u32 const frame = m_frame++;
+
+	// address spaces belong to the machine, so a new one resolves the watches again
+	if (&machine != m_machine) {
+		m_machine = &machine;
+		m_live_generation = m_watch_generation.load() - 1;
+		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&stream_hub::machine_exit, this));
+	}
+
+	u32 const frame_divider = m_divider[FRAME].load(std::memory_order_relaxed);
+	if (frame_divider != 0 && (frame % frame_divider) == 0) {
+		const bitmap_rgb32 *bitmap = source;
+		if (bitmap == nullptr) {
+			screen_device *const screen = screen_device_iterator(machine.root_device()).first();
+			if (screen != nullptr)
+				bitmap = &machine.video().snapshot_bitmap(screen);
+		}
+		if (bitmap != nullptr && bitmap->valid()) {
+			packet_ptr pkt = acquire(FRAME);
+			pkt->width = bitmap->width();
+			pkt->height = bitmap->height();
+			pkt->data.resize(size_t(pkt->width) * pkt->height * 4);
+			for (int y = 0; y < pkt->height; y++)
+				std::memcpy(&pkt->data[size_t(y) * pkt->width * 4], &bitmap->pix32(y), pkt->width * 4);
+			submit(std::move(pkt));
+		}
+	}
+
+	u32 const memory_divider = m_divider[MEMORY].load(std::memory_order_relaxed);
+	if (memory_divider != 0 && (frame % memory_divider) == 0) {
+		// resolve the watch list again when a client changed it
+		u32 const generation = m_watch_generation.load();
+		if (generation != m_live_generation) {
+			m_live_generation = generation;
+			m_live_watches.clear();
+			std::lock_guard<std::mutex> lock(m_clients_mutex);
+			for (auto &entry : m_clients) {
+				for (const watch &w : entry.second.watches) {
+					device_t *const device = machine.root_device().subdevice(w.tag.c_str());
+					device_memory_interface *memory;
+					if (device != nullptr && device->interface(memory) && memory->has_space(w.spacenum))
+						m_live_watches.push_back({ entry.first, w.id, &memory->space(w.spacenum), w.first, w.last });
+				}
+			}
+		}
+
+		if (!m_live_watches.empty()) {
+			packet_ptr pkt = acquire(MEMORY);
+			pkt->data.clear();
+			for (const live_watch &w : m_live_watches) {
+				size_t const offset = pkt->data.size();
+				for (offs_t address = w.first; ; address++) {
+					pkt->data.push_back(w.space->read_byte(address));
+					if (address == w.last)
+						break;
+				}
+				pkt->ranges.push_back({ w.client, w.id, w.first, offset, pkt->data.size() - offset });
+			}
+			submit(std::move(pkt));
+		}
+	}
+}
+
+void http_manager::stream_hub::machine_exit()
+{
+	// the next machine may be constructed at the same address, so forget this one
+	// entirely rather than relying on the pointer changing
+	m_live_watches.clear();
+	m_machine = nullptr;
+}
+
+void http_manager::stream_hub::audio(const s16 *samples, int frames, int rate)
+{
+	packet_ptr pkt = acquire(AUDIO);
+	pkt->rate = rate;
+	pkt->data.resize(size_t(frames) * 2 * sizeof(s16));
+	u8 *dest = pkt->data.data();
+	for (int i = 0; i < frames * 2; i++) {
+		*dest++ = u8(samples[i]);
+		*dest++ = u8(u16(samples[i]) >> 8);
+	}
+	submit(std::move(pkt));
+}
+
+static void put_u16(std::vector<u8> &buffer, u16 value)
+{
+	buffer.push_back(u8(value));
+	buffer.push_back(u8(value >> 8));
+}
+
+static void put_u32(std::vector<u8> &buffer, u32 value)
+{
+	put_u16(buffer, u16(value));
+	put_u16(buffer, u16(value >> 16));
+}
+
+std::vector<http_manager::stream_hub::target> http_manager::stream_hub::targets(stream_type type, u32 frame)
+{
+	std::vector<target> result;
+	std::lock_guard<std::mutex> lock(m_clients_mutex);
+	for (auto &entry : m_clients) {
+		const client &c = entry.second;
+		if (c.type == type && (frame % c.rate) == 0)
+			result.push_back({ entry.first, c.connection, c.in_flight, c.scale, c.png });
+	}
+	return result;
+}
+
+void http_manager::stream_hub::send(const target &t, const std::vector<u8> &header, const u8 *data, size_t length)
+{
+	// a client that has not taken the last messages yet misses this one
+	if (t.in_flight->load() >= MAX_IN_FLIGHT)
+		return;
+	t.in_flight->fetch_add(1);
+
+	std::shared_ptr<std::atomic<int>> in_flight = t.in_flight;
+	if (!t.connection->send_binary(header, data, length, [in_flight] (const std::error_code &) { in_flight->fetch_sub(1); }))
+		in_flight->fetch_sub(1);
+}
+
+void http_manager::stream_hub::send_frame(const packet &pkt)
+{
+	// encode once for every format and scale in use
+	std::map<std::pair<int, bool>, std::vector<u8>> encoded;
+	std::vector<u8> header;
+
+	for (const target &t : targets(FRAME, pkt.frame)) {
+		int const width = std::max(pkt.width / t.scale, 1);
+		int const height = std::max(pkt.height / t.scale, 1);
+		const u8 *data;
+		size_t length;
+
+#ifdef LSB_FIRST
+		if (t.scale == 1 && !t.png) {
+			// the captured pixels need no conversion, so send the packet's copy as is
+			data = pkt.data.data();
+			length = pkt.data.size();
+		} else
+#endif
+		{
+			auto found = encoded.find(std::make_pair(t.scale, t.png));
+			if (found == encoded.end()) {
+				found = encoded.emplace(std::make_pair(t.scale, t.png), std::vector<u8>()).first;
+				std::vector<u8> &payload = found->second;
+				bitmap_rgb32 scaled(width, height);
+				const u32 *const source = reinterpret_cast<const u32 *>(pkt.data.data());
+				int const count = t.scale * t.scale;
+				for (int y = 0; y < height; y++) {
+					u32 *dest = &scaled.pix32(y);
+					for (int x = 0; x < width; x++) {
+						// box filter over the scale x scale source block
+						u32 r = 0, g = 0, b = 0;
+						for (int sy = 0; sy < t.scale; sy++) {
+							const u32 *src = source + size_t(y * t.scale + sy) * pkt.width + x * t.scale;
+							for (int sx = 0; sx < t.scale; sx++) {
+								rgb_t const pixel(src[sx]);
+								r += pixel.r();
+								g += pixel.g();
+								b += pixel.b();
+							}
+						}
+						*dest++ = rgb_t(r / count, g / count, b / count);
+					}
+				}
+
+				if (t.png) {
+					memory_output_file file(payload);
+					png_info info;
+					png_write_bitmap(file, &info, scaled, 0, nullptr);
+				} else {
+					payload.reserve(size_t(width) * height * 4);
+					for (int y = 0; y < height; y++)
+						for (int x = 0; x < width; x++)
+							put_u32(payload, scaled.pix32(y, x));
+				}
+			}
+			data = found->second.data();
+			length = found->second.size();
+		}
+
+		header.clear();
+		header.push_back(t.png ? FRAME_PNG : FRAME_RAW);
+		put_u32(header, pkt.frame);
+		put_u16(header, width);
+		put_u16(header, height);
+		send(t, header, data, length);
+	}
+}
+
+void http_manager::stream_hub::send_audio(const packet &pkt)
+{
+	std::vector<u8> header;
+	header.push_back(AUDIO_CHUNK);
+	put_u32(header, pkt.rate);
+	put_u32(header, pkt.data.size() / (2 * sizeof(s16)));
+
+	for (const target &t : targets(AUDIO, pkt.frame))
+		send(t, header, pkt.data.data(), pkt.data.size());
+}
+
+void http_manager::stream_hub::send_memory(const packet &pkt)
+{
+	std::vector<u8> payload;
+
+	for (const target &t : targets(MEMORY, pkt.frame)) {
+		payload.clear();
+		payload.push_back(MEMORY_SNAPSHOT);
+		put_u32(payload, pkt.frame);
+		for (const packet::range &r : pkt.ranges) {
+			if (r.client != t.key)
+				continue;
+			put_u32(payload, r.id);
+			put_u32(payload, r.address);
+			put_u32(payload, r.length);
+			payload.insert(payload.end(), pkt.data.begin() + r.offset, pkt.data.begin() + r.offset + r.length);
+		}
+		if (payload.size() > 5)
+			send(t, payload, nullptr, 0);
+	}
+}
+
+void http_manager::stream_hub::thread_main()
+{
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m_wakeup_mutex);
+			m_wakeup.wait(lock, [this] () { return m_pending || m_exit; });
+			m_pending = false;
+			if (m_exit)
+				break;
+		}
+
+		packet_ptr pkt;
+		while (m_queue.pop(pkt)) {
+			switch (pkt->type) {
+			case FRAME:     send_frame(*pkt);   break;
+			case AUDIO:     send_audio(*pkt);   break;
+			case MEMORY:    send_memory(*pkt);  break;
+			default:                            break;
+			}
+			// hand the buffers back for reuse; a full pool just frees them
+			m_recycle.push(std::move(pkt));
+		}
+	}
+}
+
 http_manager::http_manager(bool active, short port, const char *root)
-  : m_active(active), m_io_context(std::make_shared<asio::io_context>()), m_root(root)
+  : m_active(active), m_io_context(std::make_shared<asio::io_context>()), m_root(root), m_frame_source(nullptr)
 {
 	if (!active) return;
 
@@ -331,6 +906,8 @@ http_manager::http_manager(bool active, short port, const char *root)
 		m_wsserver->upgrade(connection);
 	};
 
+	m_streams = std::make_unique<stream_hub>(*this);
+
 	m_server->start();
 
 	m_server_thread = std::thread([this]() {
@@ -346,6 +923,7 @@ http_manager::~http_manager()
 	m_io_context->stop();
 	if (m_server_thread.joinable())
 		m_server_thread.join();
+	m_streams.reset();
 }
 
 static void on_get(http_manager::http_handler handler, std::shared_ptr<webpp::Response> response, std::shared_ptr<webpp::Request> request) {
@@ -565,3 +1143,20 @@ void http_manager::remove_endpoint(const std::string &path) {
 
 	m_endpoints.erase(path);
 }
+
+void http_manager::stream_frame(running_machine &machine)
+{
+	if (m_streams)
+		m_streams->frame(machine, m_frame_source);
+}
+
+bool http_manager::streaming_audio() const
+{
+	return m_streams && m_streams->active(stream_hub::AUDIO);
+}
+
+void http_manager::stream_audio(const s16 *samples, int frames, int rate)
+{
+	if (m_streams)
+		m_streams->audio(samples, frames, rate);
+}
@@ -158,7 +158,23 @@ public:
 		return m_active;
 	}
 
+	/** Streams the current frame and the subscribed memory ranges to the clients of
+	 * /stream/frame and /stream/memory that are due. Called once per emulated frame. */
+	void stream_frame(running_machine &machine);
+
+	/** Streams this bitmap to /stream/frame clients instead of a snapshot of the first
+	 * screen, so an OSD renderer can publish its composited output; nullptr reverts. */
+	void set_frame_source(const bitmap_rgb32 *bitmap) { m_frame_source = bitmap; }
+
+	/** Returns whether any client is connected to /stream/audio. */
+	bool streaming_audio() const;
+
+	/** Streams a chunk of interleaved stereo samples to the clients of /stream/audio. */
+	void stream_audio(const s16 *samples, int frames, int rate);
+
 private:
+	class stream_hub;
+
 	void on_open(http_manager::websocket_endpoint_ptr endpoint, std::shared_ptr<webpp::Connection> connection);
 
 	void on_message(http_manager::websocket_endpoint_ptr endpoint, std::shared_ptr<webpp::Connection> connection, const std::string& payload, int opcode);
@@ -186,6 +202,9 @@ private:
 	std::unordered_map<void *, websocket_connection_ptr> m_connections;  // the keys are really webpp::ws_server::Connection pointers
 	std::mutex                                           m_connections_mutex;
 
+	std::unique_ptr<stream_hub>                          m_streams;
+	const bitmap_rgb32 *                                 m_frame_source;
+
 };
 
 
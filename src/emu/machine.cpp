@@ -239,6 +239,7 @@ void running_machine::start()
 	m_tilemap = std::make_unique<tilemap_manager>(*this);
 	m_crosshair = make_unique_clear<crosshair_manager>(*this);
 	m_network = std::make_unique<network_manager>(*this);
+	m_coverage = std::make_unique<coverage_recorder>(*this);
 
 	// initialize the debugger
 	if ((debug_flags & DEBUG_FLAG_ENABLED) != 0)
@@ -58,6 +58,7 @@ constexpr int DEBUG_FLAG_WPW_PROGRAM    = 0x00000100;       // watchpoints are e
 constexpr int DEBUG_FLAG_WPW_DATA       = 0x00000200;       // watchpoints are enabled for DATA memory writes
 constexpr int DEBUG_FLAG_WPW_IO         = 0x00000400;       // watchpoints are enabled for IO memory writes
 constexpr int DEBUG_FLAG_OSD_ENABLED    = 0x00001000;       // The OSD debugger is enabled
+constexpr int DEBUG_FLAG_COVERAGE       = 0x00002000;       // coverage is being recorded (with or without the debugger)
 
 
 
@@ -183,6 +184,7 @@ public:
 	ui_manager &ui() const { assert(m_ui != nullptr); return *m_ui; }
 	ui_input_manager &ui_input() const { assert(m_ui_input != nullptr); return *m_ui_input; }
 	crosshair_manager &crosshair() const { assert(m_crosshair != nullptr); return *m_crosshair; }
+	coverage_recorder &coverage() const { assert(m_coverage != nullptr); return *m_coverage; }
 	image_manager &image() const { assert(m_image != nullptr); return *m_image; }
 	rom_load_manager &rom_load() const { assert(m_rom_load != nullptr); return *m_rom_load; }
 	tilemap_manager &tilemap() const { assert(m_tilemap != nullptr); return *m_tilemap; }
@@ -329,6 +331,7 @@ private:
 	std::unique_ptr<configuration_manager> m_configuration; // internal data from config.cpp
 	std::unique_ptr<output_manager> m_output;          // internal data from output.cpp
 	std::unique_ptr<crosshair_manager> m_crosshair;    // internal data from crsshair.cpp
+	std::unique_ptr<coverage_recorder> m_coverage;     // internal data from covrecord.cpp
 	std::unique_ptr<image_manager> m_image;            // internal data from image.cpp
 	std::unique_ptr<rom_load_manager> m_rom_load;      // internal data from romload.cpp
 	std::unique_ptr<debugger_manager> m_debugger;      // internal data from debugger.cpp
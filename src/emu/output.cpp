@@ -23,12 +23,10 @@
 output_manager::output_item::output_item(
 		output_manager &manager,
 		std::string &&name,
-		u32 id,
-		s32 value)
+		u32 id)
 	: m_manager(manager)
 	, m_name(std::move(name))
 	, m_id(id)
-	, m_value(value)
 	, m_notifylist()
 {
 }
@@ -37,8 +35,9 @@ output_manager::output_item::output_item(
 void output_manager::output_item::notify(s32 value)
 {
 	if (OUTPUT_VERBOSE)
-		m_manager.machine().logerror("Output %s = %d (was %d)\n", m_name, value, m_value);
-	m_value = value;
+		m_manager.machine().logerror("Output %s = %d (was %d)\n", m_name, value, get());
+	m_manager.m_values[m_id] = value;
+	m_manager.mark_dirty(m_id);
 
 	// call the local notifiers first
 	for (auto const &notify : m_notifylist)
@@ -74,8 +73,10 @@ void output_manager::item_proxy::resolve(device_t &device, std::string const &na
 //-------------------------------------------------
 
 output_manager::output_manager(running_machine &machine)
-	: m_machine(machine),
-		m_uniqueid(12345)
+	: m_machine(machine)
+	, m_items(1)
+	, m_values(1, 0)
+	, m_dirty(1, 0)
 {
 	/* add pause callback */
 	machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&output_manager::pause, this));
@@ -88,9 +89,9 @@ output_manager::output_manager(running_machine &machine)
 
 output_manager::output_item* output_manager::find_item(const char *string)
 {
-	auto item = m_itemtable.find(std::string(string));
-	if (item != m_itemtable.end())
-		return &item->second;
+	auto item = m_nametable.find(std::string(string));
+	if (item != m_nametable.end())
+		return m_items[item->second].get();
 
 	return nullptr;
 }
@@ -102,12 +103,14 @@ output_manager::output_item* output_manager::find_item(const char *string)
 
 output_manager::output_item &output_manager::create_new_item(const char *outname, s32 value)
 {
-	auto const ins(m_itemtable.emplace(
-			std::piecewise_construct,
-			std::forward_as_tuple(outname),
-			std::forward_as_tuple(*this, outname, m_uniqueid++, value)));
+	u32 const id = m_items.size();
+	auto const ins(m_nametable.emplace(outname, id));
 	assert(ins.second);
-	return ins.first->second;
+	m_items.emplace_back(std::make_unique<output_item>(*this, outname, id));
+	m_values.push_back(value);
+	if ((id >> 6) >= m_dirty.size())
+		m_dirty.push_back(0);
+	return *m_items.back();
 }
 
 /*-------------------------------------------------
@@ -209,8 +212,32 @@ void output_manager::set_notifier(const char *outname, output_notifier_func call
 
 void output_manager::notify_all(output_module *module)
 {
-	for (auto &item : m_itemtable)
-		module->notify(item.second.name().c_str(), item.second.get());
+	for (u32 id = 1; id < m_items.size(); id++)
+		module->notify(m_items[id]->name().c_str(), m_values[id]);
+}
+
+
+/*-------------------------------------------------
+    frame_update - hand the IDs changed since the
+    last call to the batch notifiers
+-------------------------------------------------*/
+
+void output_manager::frame_update()
+{
+	m_changed.clear();
+	for (u32 word = 0; word < m_dirty.size(); word++)
+	{
+		// most words are clean, so only the dirty ones are walked bit by bit
+		u64 bits = m_dirty[word];
+		for (u32 id = word << 6; bits != 0; id++, bits >>= 1)
+			if (bits & 1)
+				m_changed.push_back(id);
+		m_dirty[word] = 0;
+	}
+
+	if (!m_changed.empty())
+		for (auto const &notify : m_batch_notifylist)
+			notify(*this, m_changed);
 }
 
 
@@ -234,9 +261,8 @@ u32 output_manager::name_to_id(const char *outname)
 
 const char *output_manager::id_to_name(u32 id)
 {
-	for (auto &item : m_itemtable)
-		if (item.second.id() == id)
-			return item.second.name().c_str();
+	if (id != 0 && id < m_items.size())
+		return m_items[id]->name().c_str();
 
 	/* nothing found, return nullptr */
 	return nullptr;
@@ -22,9 +22,15 @@
 ***************************************************************************/
 
 typedef void (*output_notifier_func)(const char *outname, s32 value, void *param);
+typedef void (*output_batch_notifier_func)(output_manager &manager, const std::vector<u32> &ids, void *param);
 
 // ======================> output_manager
 
+// Outputs are interned to dense IDs starting at 1 when first named; values
+// live in one array indexed by ID.  Changes set a bit in a dirty bitset and
+// batch notifiers get the list of IDs changed since the last frame_update(),
+// so bulk consumers never look outputs up by name per change.
+
 class output_manager
 {
 private:
@@ -56,13 +62,12 @@ private:
 		output_item(
 				output_manager &manager,
 				std::string &&name,
-				u32 id,
-				s32 value);
+				u32 id);
 
 		std::string const &name() const { return m_name; }
 		u32 id() const { return m_id; }
-		s32 get() const { return m_value; }
-		void set(s32 value) { if (m_value != value) { notify(value); } }
+		s32 get() const { return m_manager.m_values[m_id]; }
+		void set(s32 value) { if (get() != value) { notify(value); } }
 		void notify(s32 value);
 
 		void set_notifier(output_notifier_func callback, void *param) { m_notifylist.emplace_back(callback, param); }
@@ -70,8 +75,7 @@ private:
 	private:
 		output_manager      &m_manager;     // parent output manager
 		std::string const   m_name;         // string name of the item
-		u32 const           m_id;           // unique ID for this item
-		s32                 m_value;        // current value
+		u32 const           m_id;           // dense ID for this item
 		notify_vector       m_notifylist;   // list of notifier callbacks
 	};
 
@@ -171,12 +175,22 @@ public:
 	// set a notifier on a particular output, or globally if nullptr
 	void notify_all(output_module *module);
 
+	// add a notifier called from frame_update() with the IDs changed since the last call
+	void add_batch_notifier(output_batch_notifier_func callback, void *param) { m_batch_notifylist.emplace_back(callback, param); }
+
+	// deliver the outputs changed since the last call to the batch notifiers
+	void frame_update();
+
 	// map a name to a unique ID
 	u32 name_to_id(const char *outname);
 
 	// map a unique ID back to a name
 	const char *id_to_name(u32 id);
 
+	// access by ID
+	u32 count() const { return m_items.size() - 1; }
+	s32 value(u32 id) const { return (id < m_values.size()) ? m_values[id] : 0; }
+
 	// helpers
 	void set_led_value(int index, int value) { set_indexed_value("led", index, value ? 1 : 0); }
 	void set_lamp_value(int index, int value) { set_indexed_value("lamp", index, value); }
@@ -191,12 +205,28 @@ private:
 
 	output_item *find_item(const char *string);
 	output_item &create_new_item(const char *outname, s32 value);
+	void mark_dirty(u32 id) { m_dirty[id >> 6] |= u64(1) << (id & 63); }
+
+	class batch_notify
+	{
+	public:
+		batch_notify(output_batch_notifier_func callback, void *param) : m_notifier(callback), m_param(param) { }
+		void operator()(output_manager &manager, const std::vector<u32> &ids) const { m_notifier(manager, ids, m_param); }
+
+	private:
+		output_batch_notifier_func  m_notifier;
+		void *                      m_param;
+	};
 
 	// internal state
 	running_machine &m_machine;                  // reference to our machine
-	std::unordered_map<std::string, output_item> m_itemtable;
+	std::unordered_map<std::string, u32> m_nametable;    // name to ID
+	std::vector<std::unique_ptr<output_item>> m_items;  // by ID, entry 0 unused
+	std::vector<s32> m_values;                   // by ID
+	std::vector<u64> m_dirty;                    // changed since the last frame_update, one bit per ID
+	std::vector<u32> m_changed;                  // scratch list handed to batch notifiers
 	notify_vector m_global_notifylist;
-	u32 m_uniqueid;
+	std::vector<batch_notify> m_batch_notifylist;
 };
 
 template <unsigned... N> using output_finder = output_manager::output_finder<void, N...>;
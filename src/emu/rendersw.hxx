@@ -14,6 +14,9 @@
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+#include <array>
+
 
 template<typename _PixelType, int _SrcShiftR, int _SrcShiftG, int _SrcShiftB, int _DstShiftR, int _DstShiftG, int _DstShiftB, bool _NoDestRead = false, bool _BilinearFilter = false>
 class software_renderer
@@ -48,16 +51,53 @@ private:
 	static inline u32 dest_g(_PixelType pixel) { return (pixel >> _DstShiftG) & (0xff >> _SrcShiftG); }
 	static inline u32 dest_b(_PixelType pixel) { return (pixel >> _DstShiftB) & (0xff >> _SrcShiftB); }
 
+	// destinations in the standard format can take source pixels as they are
+	static constexpr bool is_standard_format() { return _SrcShiftR == 0 && _SrcShiftG == 0 && _SrcShiftB == 0 && _DstShiftR == 16 && _DstShiftG == 8 && _DstShiftB == 0; }
+
 	// generic conversion with special optimization for destinations in the standard format
 	static inline _PixelType source32_to_dest(u32 pixel)
 	{
-		if (_SrcShiftR == 0 && _SrcShiftG == 0 && _SrcShiftB == 0 && _DstShiftR == 16 && _DstShiftG == 8 && _DstShiftB == 0)
+		if (is_standard_format())
 			return pixel;
 		else
 			return dest_assemble_rgb(source32_r(pixel), source32_g(pixel), source32_b(pixel));
 	}
 
 
+	//-------------------------------------------------
+	//  scale_rgb32 - scale each channel of a standard
+	//  format pixel, as (src * scale) >> 8, with all
+	//  channels at once in the vector unit
+	//-------------------------------------------------
+
+	static inline u32 scale_rgb32(u32 pix, const rgbaint_t &scale)
+	{
+		rgbaint_t src(pix);
+		src.mul(scale);
+		src.shr_imm(8);
+		return src.to_rgba() & 0x00ffffff;
+	}
+
+
+	//-------------------------------------------------
+	//  blend_rgb32 - blend two standard format
+	//  pixels, as (src * scale + dst * dstscale) >>
+	//  shift, with all channels at once in the
+	//  vector unit
+	//-------------------------------------------------
+
+	static inline u32 blend_rgb32(u32 pix, const rgbaint_t &scale, u32 dpix, u32 dstscale, u8 shift)
+	{
+		rgbaint_t src(pix);
+		rgbaint_t dst(dpix);
+		src.mul(scale);
+		dst.mul_imm(dstscale);
+		src.add(dst);
+		src.shr_imm(shift);
+		return src.to_rgba() & 0x00ffffff;
+	}
+
+
 	//-------------------------------------------------
 	//  ycc_to_rgb - convert YCC to RGB; the YCC pixel
 	//  contains Y in the LSB, Cb << 8, and Cr << 16
@@ -334,14 +374,31 @@ private:
 
 
 	//-------------------------------------------------
-	//  draw_line - draw a line or point
+	//  cosine_table - beam width correction for
+	//  antialiased lines, built on first use
 	//-------------------------------------------------
 
-	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static const u32 *cosine_table()
 	{
-		// internal tables
-		static u32 s_cosine_table[2049];
+		// bands can draw lines concurrently, so let the compiler guard the build
+		static const std::array<u32, 2049> s_table = []
+		{
+			std::array<u32, 2049> table;
+			for (int entry = 0; entry <= 2048; entry++)
+				table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			return table;
+		}();
+		return s_table.data();
+	}
+
+
+	//-------------------------------------------------
+	//  draw_line - draw a line or point, clipped to
+	//  the rows from top to bottom
+	//-------------------------------------------------
 
+	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 top, s32 bottom, u32 pitch)
+	{
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
 		int y1 = int(prim.bounds.y0 * 65536.0f);
@@ -353,10 +410,7 @@ private:
 
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
-			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			const u32 *const s_cosine_table = cosine_table();
 
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
@@ -382,7 +436,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -390,11 +444,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= top && dy < bottom)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -414,7 +468,7 @@ private:
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= top && y1 < bottom)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -457,7 +511,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -473,7 +527,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -495,10 +549,11 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_rect - draw a solid rectangle
+	//  draw_rect - draw a solid rectangle, clipped to
+	//  the rows from top to bottom
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 top, s32 bottom, u32 pitch)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -515,10 +570,10 @@ private:
 		if (startx >= width) startx = width;
 		if (endx < 0) endx = 0;
 		if (endx >= width) endx = width;
-		if (starty < 0) starty = 0;
-		if (starty >= height) starty = height;
-		if (endy < 0) endy = 0;
-		if (endy >= height) endy = height;
+		if (starty < top) starty = top;
+		if (starty >= bottom) starty = bottom;
+		if (endy < top) endy = top;
+		if (endy >= bottom) endy = bottom;
 
 		// bail if nothing left
 		if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
@@ -1154,6 +1209,7 @@ private:
 			if (sr > 0x100) { if (s32(sr) < 0) sr = 0; else sr = 0x100; }
 			if (sg > 0x100) { if (s32(sg) < 0) sg = 0; else sg = 0x100; }
 			if (sb > 0x100) { if (s32(sb) < 0) sb = 0; else sb = 0x100; }
+			rgbaint_t const scale(0, sr, sg, sb);
 
 			// loop over rows
 			for (s32 y = setup.starty; y < setup.endy; y++)
@@ -1162,8 +1218,20 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// no lookup case, standard format
+				if (palbase == nullptr && is_standard_format())
+				{
+					// loop over cols
+					for (s32 x = setup.startx; x < endx; x++)
+					{
+						*dest++ = scale_rgb32(get_texel_rgb32(prim.texture, curu, curv), scale);
+						curu += dudx;
+						curv += dvdx;
+					}
+				}
+
 				// no lookup case
-				if (palbase == nullptr)
+				else if (palbase == nullptr)
 				{
 					// loop over cols
 					for (s32 x = setup.startx; x < endx; x++)
@@ -1211,6 +1279,7 @@ private:
 			if (sg > 0x100) { if (s32(sg) < 0) sg = 0; else sg = 0x100; }
 			if (sb > 0x100) { if (s32(sb) < 0) sb = 0; else sb = 0x100; }
 			if (invsa > 0x100) { if (s32(invsa) < 0) invsa = 0; else invsa = 0x100; }
+			rgbaint_t const scale(0, sr, sg, sb);
 
 			// loop over rows
 			for (s32 y = setup.starty; y < setup.endy; y++)
@@ -1219,8 +1288,22 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// no lookup case, standard format
+				if (palbase == nullptr && is_standard_format())
+				{
+					// loop over cols
+					for (s32 x = setup.startx; x < endx; x++)
+					{
+						u32 pix = get_texel_rgb32(prim.texture, curu, curv);
+						u32 dpix = _NoDestRead ? 0 : *dest;
+						*dest++ = blend_rgb32(pix, scale, dpix, invsa, 8);
+						curu += dudx;
+						curv += dvdx;
+					}
+				}
+
 				// no lookup case
-				if (palbase == nullptr)
+				else if (palbase == nullptr)
 				{
 					// loop over cols
 					for (s32 x = setup.startx; x < endx; x++)
@@ -1419,8 +1502,29 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// no lookup case, standard format
+				if (palbase == nullptr && is_standard_format())
+				{
+					// loop over cols
+					for (s32 x = setup.startx; x < endx; x++)
+					{
+						u32 pix = get_texel_argb32(prim.texture, curu, curv);
+						u32 ta = pix >> 24;
+						if (ta != 0)
+						{
+							u32 dpix = _NoDestRead ? 0 : *dest;
+							rgbaint_t scale;
+							scale.set_all(ta);
+							*dest = blend_rgb32(pix, scale, dpix, 0x100 - ta, 8);
+						}
+						dest++;
+						curu += dudx;
+						curv += dvdx;
+					}
+				}
+
 				// no lookup case
-				if (palbase == nullptr)
+				else if (palbase == nullptr)
 				{
 					// loop over cols
 					for (s32 x = setup.startx; x < endx; x++)
@@ -1482,6 +1586,7 @@ private:
 			if (sg > 0x100) { if (s32(sg) < 0) sg = 0; else sg = 0x100; }
 			if (sb > 0x100) { if (s32(sb) < 0) sb = 0; else sb = 0x100; }
 			if (sa > 0x100) { if (s32(sa) < 0) sa = 0; else sa = 0x100; }
+			rgbaint_t const color(0, sr, sg, sb);
 
 			// loop over rows
 			for (s32 y = setup.starty; y < setup.endy; y++)
@@ -1490,8 +1595,33 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// no lookup case, standard format
+				if (palbase == nullptr && is_standard_format())
+				{
+					// loop over cols
+					for (s32 x = setup.startx; x < endx; x++)
+					{
+						u32 pix = get_texel_argb32(prim.texture, curu, curv);
+						u32 ta = (pix >> 24) * sa;
+						if (ta != 0)
+						{
+							// the lanes are signed 32-bit, and 255 times a full
+							// scale of 0x10000 << 8 doesn't fit, so both scales
+							// drop their lowest bit and the shift one less
+							u32 dpix = _NoDestRead ? 0 : *dest;
+							rgbaint_t scale(color);
+							scale.mul_imm(ta);
+							scale.shr_imm(1);
+							*dest = blend_rgb32(pix, scale, dpix, (0x10000 - ta) << 7, 23);
+						}
+						dest++;
+						curu += dudx;
+						curv += dvdx;
+					}
+				}
+
 				// no lookup case
-				if (palbase == nullptr)
+				else if (palbase == nullptr)
 				{
 					// loop over cols
 					for (s32 x = setup.startx; x < endx; x++)
@@ -1822,10 +1952,11 @@ private:
 	//-------------------------------------------------
 	//  setup_and_draw_textured_quad - perform setup
 	//  and then dispatch to a texture-mode-specific
-	//  drawing routine
+	//  drawing routine; only the rows from top to
+	//  bottom are drawn
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, s32 top, s32 bottom, u32 pitch)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1872,6 +2003,17 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// keep to the band, stepping U/V to its first row so every band
+		// samples exactly what a single pass over the whole target would
+		if (setup.starty < top)
+		{
+			setup.startu += (top - setup.starty) * setup.dudy;
+			setup.startv += (top - setup.starty) * setup.dvdy;
+			setup.starty = top;
+		}
+		if (setup.endy > bottom)
+			setup.endy = bottom;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1927,34 +2069,101 @@ private:
 
 
 	//**************************************************************************
-	//  PRIMARY ENTRY POINT
+	//  BANDED RENDERING
 	//**************************************************************************
 
+	struct band_info
+	{
+		const render_primitive_list *primlist;
+		_PixelType *dstdata;
+		s32 width, height;
+		s32 top, bottom;
+		u32 pitch;
+	};
+
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_band - draw every primitive, clipped to
+	//  the rows from top to bottom
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	static void draw_band(const render_primitive_list &primlist, _PixelType *dstdata, s32 width, s32 height, s32 top, s32 bottom, u32 pitch)
 	{
 		// loop over the list and render each element
 		for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
 			switch (prim->type)
 			{
 				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+					draw_line(*prim, dstdata, width, top, bottom, pitch);
 					break;
 
 				case render_primitive::QUAD:
 					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						draw_rect(*prim, dstdata, width, top, bottom, pitch);
 					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						setup_and_draw_textured_quad(*prim, dstdata, width, height, top, bottom, pitch);
 					break;
 
 				default:
 					throw emu_fatalerror("Unexpected render_primitive type");
 			}
 	}
+
+	//-------------------------------------------------
+	//  draw_band_callback - draw one band on a work
+	//  queue thread
+	//-------------------------------------------------
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		const band_info &band = *reinterpret_cast<const band_info *>(param);
+		draw_band(*band.primlist, band.dstdata, band.width, band.height, band.top, band.bottom, band.pitch);
+		return nullptr;
+	}
+
+
+	//**************************************************************************
+	//  PRIMARY ENTRY POINT
+	//**************************************************************************
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  using a software rasterizer; given a work
+	//  queue, large targets are split into horizontal
+	//  bands that are drawn concurrently
+	//-------------------------------------------------
+
+public:
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue = nullptr)
+	{
+		// every band walks the whole list, so only split when there are enough pixels to go round
+		constexpr u32 BAND_MIN_PIXELS = 256 * 1024;
+		constexpr u32 BAND_MIN_ROWS = 32;
+		constexpr int BAND_MAX = 16;
+
+		_PixelType *const dest = reinterpret_cast<_PixelType *>(dstdata);
+		int bands = 1;
+		if (queue != nullptr && width * height >= BAND_MIN_PIXELS)
+			bands = std::min(int(height / BAND_MIN_ROWS), BAND_MAX);
+		if (bands <= 1)
+		{
+			draw_band(primlist, dest, width, height, 0, height, pitch);
+			return;
+		}
+
+		band_info band[BAND_MAX];
+		for (int index = 0; index < bands; index++)
+		{
+			band[index].primlist = &primlist;
+			band[index].dstdata = dest;
+			band[index].width = width;
+			band[index].height = height;
+			band[index].top = height * index / bands;
+			band[index].bottom = height * (index + 1) / bands;
+			band[index].pitch = pitch;
+		}
+
+		// the bands live on our stack, so don't leave until all of them are done
+		osd_work_item_queue_multiple(queue, draw_band_callback, bands, band, sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) { }
+	}
 };
@@ -128,6 +128,28 @@ void save_manager::register_presave(save_prepost_delegate func)
 }
 
 
+//-------------------------------------------------
+//  register_preload - register a function
+//  called before loaded data is copied into the
+//  registered items
+//-------------------------------------------------
+
+void save_manager::register_preload(save_prepost_delegate func)
+{
+	// check for invalid timing
+	if (!m_reg_allowed)
+		fatalerror("Attempt to register callback function after state registration is closed!\n");
+
+	// scan for duplicates and push through to the end
+	for (auto &cb : m_preload_list)
+		if (cb->m_func == func)
+			fatalerror("Duplicate save state function (%s/%s)\n", cb->m_func.name(), func.name());
+
+	// allocate a new entry
+	m_preload_list.push_back(std::make_unique<state_callback>(func));
+}
+
+
 //-------------------------------------------------
 //  state_save_register_postload -
 //  register a post-load function callback
@@ -221,6 +243,18 @@ save_error save_manager::check_file(running_machine &machine, emu_file &file, co
 }
 
 
+//-------------------------------------------------
+//  dispatch_preload - invoke all registered
+//  preload callbacks before data is overwritten
+//-------------------------------------------------
+
+void save_manager::dispatch_preload()
+{
+	for (auto &func : m_preload_list)
+		func->m_func();
+}
+
+
 //-------------------------------------------------
 //  dispatch_postload - invoke all registered
 //  postload callbacks for updates
@@ -259,6 +293,9 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// call the pre-load functions
+	dispatch_preload();
+
 	// read all the data, flipping if necessary
 	for (auto &entry : m_entry_list)
 	{
@@ -542,6 +579,9 @@ save_error ram_state::load()
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// call the pre-load functions
+	m_save.dispatch_preload();
+
 	// read all the data, flipping if necessary
 	for (auto &entry : m_save.m_entry_list)
 	{
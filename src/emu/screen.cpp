@@ -47,7 +47,7 @@ public:
 
 	int render(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect);
 
-	static void output_notifier(const char *outname, s32 value, void *param);
+	static void output_notifier(output_manager &manager, const std::vector<u32> &ids, void *param);
 
 private:
 	struct paired_entry {
@@ -71,6 +71,7 @@ private:
 	std::vector<bool> m_key_state;
 	std::vector<std::list<NSVGshape *>> m_keyed_shapes;
 	std::unordered_map<std::string, int> m_key_ids;
+	std::vector<int> m_output_keys;         // key for each output ID: -1 none, -2 not looked up yet
 	int m_key_count;
 
 	int m_sx, m_sy;
@@ -79,7 +80,7 @@ private:
 
 	std::vector<cached_bitmap> m_cache;
 
-	void output_change(const char *outname, s32 value);
+	void output_change(output_manager &manager, u32 id);
 	void render_state(std::vector<u32> &dest, const std::vector<bool> &state);
 	void compute_initial_bboxes(std::vector<bbox> &bboxes);
 	bool compute_mask_intersection_bbox(int key1, int key2, bbox &bb) const;
@@ -237,17 +238,25 @@ int screen_device::svg_renderer::render(screen_device &screen, bitmap_rgb32 &bit
 	return 0;
 }
 
-void screen_device::svg_renderer::output_notifier(const char *outname, s32 value, void *param)
+void screen_device::svg_renderer::output_notifier(output_manager &manager, const std::vector<u32> &ids, void *param)
 {
-	static_cast<svg_renderer *>(param)->output_change(outname, value);
+	svg_renderer *const renderer = static_cast<svg_renderer *>(param);
+	for (u32 id : ids)
+		renderer->output_change(manager, id);
 }
 
-void screen_device::svg_renderer::output_change(const char *outname, s32 value)
+void screen_device::svg_renderer::output_change(output_manager &manager, u32 id)
 {
-	auto l = m_key_ids.find(outname);
-	if (l == m_key_ids.end())
-		return;
-	m_key_state[l->second] = value;
+	// names are only looked up the first time an output changes
+	if (id >= m_output_keys.size())
+		m_output_keys.resize(id + 1, -2);
+	if (m_output_keys[id] == -2)
+	{
+		auto l = m_key_ids.find(manager.id_to_name(id));
+		m_output_keys[id] = (l != m_key_ids.end()) ? l->second : -1;
+	}
+	if (m_output_keys[id] >= 0)
+		m_key_state[m_output_keys[id]] = manager.value(id);
 }
 
 void screen_device::svg_renderer::compute_initial_bboxes(std::vector<bbox> &bboxes)
@@ -696,7 +705,7 @@ void screen_device::device_start()
 		if (!reg)
 			fatalerror("SVG region \"%s\" does not exist\n", m_svg_region);
 		m_svg = std::make_unique<svg_renderer>(reg);
-		machine().output().set_notifier(nullptr, svg_renderer::output_notifier, m_svg.get());
+		machine().output().add_batch_notifier(svg_renderer::output_notifier, m_svg.get());
 
 		if (0)
 		{
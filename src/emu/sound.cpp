@@ -1099,6 +1099,8 @@ void sound_manager::update(void *ptr, int param)
 		machine().video().add_sound_to_recording(finalmix, finalmix_offset / 2);
 		if (m_wavfile != nullptr)
 			wav_add_data_16(m_wavfile, finalmix, finalmix_offset);
+		if (machine().manager().http()->streaming_audio())
+			machine().manager().http()->stream_audio(finalmix, finalmix_offset / 2, machine().sample_rate());
 	}
 
 	// see if we ticked over to the next second
@@ -31,6 +31,18 @@
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// gains of the sound buffer fill controller used by -audiothrottle, and the
+// largest fraction by which it may speed up or slow down real time
+constexpr double AUDIO_THROTTLE_KP = 0.05;
+constexpr double AUDIO_THROTTLE_KI = 0.0005;
+constexpr double AUDIO_THROTTLE_LIMIT = 0.02;
+
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -58,7 +70,7 @@ const bool video_manager::s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS] =
 //  VIDEO MANAGER
 //**************************************************************************
 
-static void video_notifier_callback(const char *outname, s32 value, void *param)
+static void video_notifier_callback(output_manager &manager, const std::vector<u32> &ids, void *param)
 {
 	video_manager *vm = (video_manager *)param;
 
@@ -78,6 +90,15 @@ video_manager::video_manager(running_machine &machine)
 	, m_throttle_realtime(attotime::zero)
 	, m_throttle_emutime(attotime::zero)
 	, m_throttle_history(0)
+	, m_audio_throttle(machine.options().audio_throttle())
+	, m_audio_integral(0.0)
+	, m_audio_rate(1.0)
+	, m_pacing_last_ticks(0)
+	, m_pacing_frames(0)
+	, m_pacing_mean(0.0)
+	, m_pacing_m2(0.0)
+	, m_pacing_sleep_ticks(0)
+	, m_pacing_spin_ticks(0)
 	, m_speed_last_realtime(0)
 	, m_speed_last_emutime(attotime::zero)
 	, m_speed_percent(1.0)
@@ -98,6 +119,7 @@ video_manager::video_manager(running_machine &machine)
 	, m_skipping_this_frame(false)
 	, m_average_oversleep(0)
 	, m_snap_target(nullptr)
+	, m_snap_queue(nullptr)
 	, m_snap_native(true)
 	, m_snap_width(0)
 	, m_snap_height(0)
@@ -186,7 +208,7 @@ video_manager::video_manager(running_machine &machine)
 	{
 		m_screenless_frame_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(video_manager::screenless_update_callback), this));
 		m_screenless_frame_timer->adjust(screen_device::DEFAULT_FRAME_PERIOD, 0, screen_device::DEFAULT_FRAME_PERIOD);
-		machine.output().set_notifier(nullptr, video_notifier_callback, this);
+		machine.output().add_batch_notifier(video_notifier_callback, this);
 	}
 }
 
@@ -225,6 +247,9 @@ void video_manager::frame_update(bool from_debugger)
 	// only render sound and video if we're in the running phase
 	machine_phase const phase = machine().phase();
 	bool skipped_it = m_skipping_this_frame;
+	// hand this frame's output changes to layouts, the OSD and scripts in one go
+	machine().output().frame_update();
+
 	if (phase == machine_phase::RUNNING && (!machine().paused() || machine().options().update_in_pause()))
 	{
 		bool anything_changed = finish_screen_updates();
@@ -244,7 +269,10 @@ void video_manager::frame_update(bool from_debugger)
 	// if we're throttling, synchronize before rendering
 	attotime current_time = machine().time();
 	if (!from_debugger && !skipped_it && effective_throttle())
+	{
 		update_throttle(current_time);
+		update_pacing_statistics();
+	}
 
 	// ask the OSD to update
 	g_profiler.start(PROFILER_BLIT);
@@ -257,6 +285,10 @@ void video_manager::frame_update(bool from_debugger)
 	if (!from_debugger)
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
 
+	// feed the web server's streaming clients
+	if (!from_debugger && phase == machine_phase::RUNNING)
+		machine().manager().http()->stream_frame(machine());
+
 	// update frameskipping
 	if (!from_debugger)
 		update_frameskip();
@@ -701,6 +733,9 @@ void video_manager::exit()
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	if (m_snap_queue != nullptr)
+		osd_work_queue_free(m_snap_queue);
+	m_snap_queue = nullptr;
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (!emulator_info::standalone() && m_overall_emutime.seconds() >= 1)
@@ -710,6 +745,18 @@ void video_manager::exit()
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
 	}
+
+	// frame pacing is mostly of interest when tuning -audiothrottle
+	if (!emulator_info::standalone() && m_pacing_frames >= 2)
+	{
+		double const deviation = sqrt(m_pacing_m2 / (m_pacing_frames - 1));
+		osd_ticks_t const waited = m_pacing_sleep_ticks + m_pacing_spin_ticks;
+		double const spin = waited ? (100.0 * m_pacing_spin_ticks / waited) : 0.0;
+		if (m_audio_throttle)
+			osd_printf_info("Frame pacing: %.3f ms average, %.3f ms standard deviation, %.1f%% of waiting spent spinning\n", m_pacing_mean * 1000.0, deviation * 1000.0, spin);
+		else
+			osd_printf_verbose("Frame pacing: %.3f ms average, %.3f ms standard deviation, %.1f%% of waiting spent spinning\n", m_pacing_mean * 1000.0, deviation * 1000.0, spin);
+	}
 }
 
 
@@ -930,6 +977,9 @@ void video_manager::update_throttle(attotime emutime)
 		3,4,4,5,4,5,5,6, 4,5,5,6,5,6,6,7, 4,5,5,6,5,6,6,7, 5,6,6,7,6,7,7,8
 	};
 
+	// let the sound buffer steer the rate of real time
+	update_audio_throttle();
+
 	// outer scope so we can break out in case of a resync
 	while (1)
 	{
@@ -942,7 +992,7 @@ void video_manager::update_throttle(attotime emutime)
 
 		// compute conversion factors up front
 		osd_ticks_t ticks_per_second = osd_ticks_per_second();
-		attoseconds_t attoseconds_per_tick = ATTOSECONDS_PER_SECOND / ticks_per_second * m_throttle_rate;
+		attoseconds_t attoseconds_per_tick = ATTOSECONDS_PER_SECOND / ticks_per_second * m_throttle_rate * m_audio_rate;
 
 		// if we're paused, emutime will not advance; instead, we subtract a fixed
 		// amount of time (1/60th of a second) from the emulated time that was passed in,
@@ -1036,8 +1086,9 @@ void video_manager::update_throttle(attotime emutime)
 osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 {
 	// we're allowed to sleep via the OSD code only if we're configured to do so
-	// and we're not frameskipping due to autoframeskip, or if we're paused
-	bool const allowed_to_sleep = (machine().options().sleep() && (!effective_autoframeskip() || effective_frameskip() == 0)) || machine().paused();
+	// and we're not frameskipping due to autoframeskip, or if we're paused; the
+	// sound buffer corrects any shortfall when it paces us, so we always sleep then
+	bool const allowed_to_sleep = (machine().options().sleep() && (!effective_autoframeskip() || effective_frameskip() == 0)) || machine().paused() || m_audio_throttle;
 
 	// loop until we reach our target
 	g_profiler.start(PROFILER_IDLE);
@@ -1047,13 +1098,20 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 		// compute how much time to sleep for, taking into account the average oversleep
 		osd_ticks_t const delta = (target_ticks - current_ticks) * 1000 / (1000 + m_average_oversleep);
 
-		// see if we can sleep
+		// see if we can sleep; rather than spin out the last fraction of a tick
+		// under audio throttling, leave it for the next frame to absorb
 		bool const slept = allowed_to_sleep && delta;
 		if (slept)
 			osd_sleep(delta);
+		else if (m_audio_throttle)
+			break;
 
 		// read the new value
 		osd_ticks_t const new_ticks = osd_ticks();
+		if (slept)
+			m_pacing_sleep_ticks += new_ticks - current_ticks;
+		else
+			m_pacing_spin_ticks += new_ticks - current_ticks;
 
 		// keep some metrics on the sleeping patterns of the OSD layer
 		if (slept)
@@ -1078,6 +1136,61 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 }
 
 
+//-------------------------------------------------
+//  update_audio_throttle - run the controller
+//  that keeps the sound buffer at its target
+//  fill by nudging the rate of real time
+//-------------------------------------------------
+
+void video_manager::update_audio_throttle()
+{
+	// the buffer only tracks real time when emulating at normal speed
+	int queued, target;
+	if (!m_audio_throttle || machine().paused() || m_speed != 1000 || m_throttle_rate != 1.0f ||
+		!machine().osd().get_audio_buffer_fill(queued, target) || target <= 0)
+	{
+		m_audio_integral = 0.0;
+		m_audio_rate = 1.0;
+		return;
+	}
+
+	// a fuller buffer than wanted means we are ahead of the sound card, so slow
+	// real time down; the integral is bounded so it can never exceed the limit alone
+	double const error = double(queued - target) / double(target);
+	double const bound = AUDIO_THROTTLE_LIMIT / AUDIO_THROTTLE_KI;
+	m_audio_integral = std::max(std::min(m_audio_integral + error, bound), -bound);
+	double const correction = AUDIO_THROTTLE_KP * error + AUDIO_THROTTLE_KI * m_audio_integral;
+	m_audio_rate = 1.0 - std::max(std::min(correction, AUDIO_THROTTLE_LIMIT), -AUDIO_THROTTLE_LIMIT);
+
+	if (LOG_THROTTLE)
+		machine().logerror("Audio throttle: queued %d of %d, rate %f\n", queued, target, m_audio_rate);
+}
+
+
+//-------------------------------------------------
+//  update_pacing_statistics - accumulate the
+//  real time taken by each throttled frame
+//-------------------------------------------------
+
+void video_manager::update_pacing_statistics()
+{
+	osd_ticks_t const current_ticks = osd_ticks();
+	osd_ticks_t const delta = current_ticks - m_pacing_last_ticks;
+	m_pacing_last_ticks = current_ticks;
+
+	// skip the first frame and anything that includes a pause or a stall
+	if (machine().paused() || delta >= osd_ticks_per_second())
+		return;
+
+	// running mean and variance, so nothing needs to be kept per frame
+	double const seconds = double(delta) / double(osd_ticks_per_second());
+	double const difference = seconds - m_pacing_mean;
+	m_pacing_frames++;
+	m_pacing_mean += difference / m_pacing_frames;
+	m_pacing_m2 += difference * (seconds - m_pacing_mean);
+}
+
+
 //-------------------------------------------------
 //  update_frameskip - update frameskipping
 //  counters and periodically update autoframeskip
@@ -1267,13 +1380,17 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	if (!m_snap_bitmap.valid() || width != m_snap_bitmap.width() || height != m_snap_bitmap.height())
 		m_snap_bitmap.allocate(width, height);
 
+	// movies render every frame, so large snapshots are drawn in bands
+	if (m_snap_queue == nullptr)
+		m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// render the screen there
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
 	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue);
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue);
 	primlist.release_lock();
 }
 
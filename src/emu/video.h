@@ -84,6 +84,7 @@ public:
 
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
+	const bitmap_rgb32 &snapshot_bitmap(screen_device *screen) { create_snapshot_bitmap(screen); return m_snap_bitmap; }
 	void save_active_screen_snapshots();
 	void save_input_timecode();
 
@@ -124,6 +125,8 @@ private:
 	bool finish_screen_updates();
 	void update_throttle(attotime emutime);
 	osd_ticks_t throttle_until_ticks(osd_ticks_t target_ticks);
+	void update_audio_throttle();
+	void update_pacing_statistics();
 	void update_frameskip();
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
@@ -145,6 +148,19 @@ private:
 	attotime            m_throttle_emutime;         // emulated time the last call to throttle
 	u32                 m_throttle_history;         // history of frames where we were fast enough
 
+	// audio clock throttling
+	bool                m_audio_throttle;           // flag: true if the sound buffer fill paces throttling
+	double              m_audio_integral;           // accumulated buffer fill error
+	double              m_audio_rate;               // correction applied to the rate of real time
+
+	// frame pacing statistics
+	osd_ticks_t         m_pacing_last_ticks;        // osd_ticks at the end of the last throttled frame
+	u32                 m_pacing_frames;            // number of frame times measured
+	double              m_pacing_mean;              // mean frame time, in seconds
+	double              m_pacing_m2;                // sum of squared differences from the mean
+	osd_ticks_t         m_pacing_sleep_ticks;       // ticks spent sleeping while throttling
+	osd_ticks_t         m_pacing_spin_ticks;        // ticks spent spinning while throttling
+
 	// dynamic speed computation
 	osd_ticks_t         m_speed_last_realtime;      // real time at the last speed calculation
 	attotime            m_speed_last_emutime;       // emulated time at the last speed calculation
@@ -175,6 +191,7 @@ private:
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
+	osd_work_queue *    m_snap_queue;               // work queue for drawing snapshots in bands
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	s32                 m_snap_width;               // width of snapshots (0 == auto)
 	s32                 m_snap_height;              // height of snapshots (0 == auto)
@@ -21,6 +21,7 @@
 #include "ui/ui.h"
 #include "ui/pluginopt.h"
 #include "luaengine.h"
+#include "luaworker.h"
 #include "natkeyboard.h"
 #include "uiinput.h"
 #include "pluginopts.h"
@@ -436,6 +437,105 @@ void lua_engine::addr_space::direct_mem_write(offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  range_step - default address step for
+//  read_range and write_range: one <width> value
+//-------------------------------------------------
+
+static offs_t range_step(int width)
+{
+	switch(width)
+	{
+		case 16:
+			return 2;
+		case 32:
+			return 4;
+		case 64:
+			return 8;
+		default:
+			return 1;
+	}
+}
+
+//-------------------------------------------------
+//  mem_read_range - templated range reader for <size>,
+//  packing the values into a string in host order
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:read_range(0xC000, 0xC0FF, 8)
+//-------------------------------------------------
+
+template <typename T>
+std::string lua_engine::addr_space::mem_read_range(offs_t first, offs_t last, offs_t step)
+{
+	std::string result;
+	last = std::min(last, space.addrmask());
+	if(first > last || step == 0)
+		return result;
+
+	result.resize((u64(last - first) / step + 1) * sizeof(T));
+	char *dest = &result[0];
+	for(u64 address = first; address <= last; address += step, dest += sizeof(T))
+	{
+		T const value = mem_read<T>(address);
+		memcpy(dest, &value, sizeof(T));
+	}
+	return result;
+}
+
+//-------------------------------------------------
+//  mem_write_range - templated range writer for <size>,
+//  from values packed into a string in host order
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:write_range(0xC000, data, 16)
+//-------------------------------------------------
+
+template <typename T>
+void lua_engine::addr_space::mem_write_range(offs_t address, const std::string &data, offs_t step)
+{
+	for(size_t offset = 0; offset + sizeof(T) <= data.size(); offset += sizeof(T), address += step)
+	{
+		T value;
+		memcpy(&value, &data[offset], sizeof(T));
+		mem_write<T>(address, value);
+	}
+}
+
+//-------------------------------------------------
+//  mem_watch::refresh - read every watched value,
+//  noting which ones changed
+//-------------------------------------------------
+
+void lua_engine::mem_watch::refresh()
+{
+	changed.clear();
+	if(!live)
+		return;
+	for(int index = 0; index < entries.size(); index++)
+	{
+		entry &ent = entries[index];
+		uint64_t value;
+		switch(ent.width)
+		{
+			case 8:
+			default:
+				value = sp.mem_read<uint8_t>(ent.address);
+				break;
+			case 16:
+				value = sp.mem_read<uint16_t>(ent.address);
+				break;
+			case 32:
+				value = sp.mem_read<uint32_t>(ent.address);
+				break;
+			case 64:
+				value = sp.mem_read<uint64_t>(ent.address);
+				break;
+		}
+		if(value != ent.value)
+		{
+			ent.value = value;
+			changed.push_back(index + 1);
+		}
+	}
+}
+
 //-------------------------------------------------
 //  region_read - templated region readers for <sign>,<size>
 //  -> manager:machine():memory().regions[":maincpu"]:read_i8(0xC000)
@@ -633,16 +733,28 @@ bool lua_engine::execute_function(const char *id)
 	sol::object functable = sol().registry()[id];
 	if(functable.is<sol::table>())
 	{
+		std::vector<callback_timing> &timing = m_callback_timing[id];
 		for(auto &func : functable.as<sol::table>())
 		{
 			if(func.second.is<sol::protected_function>())
 			{
+				osd_ticks_t const start = osd_ticks();
 				auto ret = (func.second.as<sol::protected_function>())();
+				osd_ticks_t const elapsed = osd_ticks() - start;
 				if(!ret.valid())
 				{
 					sol::error err = ret;
 					osd_printf_error("[LUA ERROR] in execute_function: %s\n", err.what());
 				}
+
+				// callbacks are added in order, so the key matches the timing slot
+				int const index = func.first.as<int>() - 1;
+				if(index >= 0 && index < timing.size())
+				{
+					timing[index].calls++;
+					timing[index].total += elapsed;
+					timing[index].worst = std::max(timing[index].worst, elapsed);
+				}
 			}
 		}
 		return true;
@@ -657,6 +769,12 @@ void lua_engine::register_function(sol::function func, const char *id)
 		functable.as<sol::table>().add(func);
 	else
 		sol().registry().create_named(id, 1, func);
+
+	// remember where the callback was defined for the timing report
+	lua_Debug ar;
+	func.push();
+	lua_getinfo(func.lua_state(), ">S", &ar);
+	m_callback_timing[id].emplace_back(string_format("%s:%d", ar.short_src, ar.linedefined));
 }
 
 void lua_engine::on_machine_prestart()
@@ -672,6 +790,27 @@ void lua_engine::on_machine_start()
 void lua_engine::on_machine_stop()
 {
 	execute_function("LUA_ON_STOP");
+
+	for(auto &worker : m_workers)
+	{
+		if(worker->dropped() != 0)
+			osd_printf_verbose("Lua worker missed %u frames\n", unsigned(worker->dropped()));
+		worker->stop();
+	}
+	m_workers.clear();
+
+	// the watched address spaces go away with the machine
+	for(std::weak_ptr<mem_watch> &ptr : m_watches)
+		if(std::shared_ptr<mem_watch> watch = ptr.lock())
+			watch->live = false;
+	m_watches.clear();
+
+	// report where plugins spent their time
+	for(auto &event : m_callback_timing)
+		for(callback_timing &timing : event.second)
+			if(timing.calls != 0)
+				osd_printf_verbose("%s callback %s: %u calls, %.3f ms average, %.3f ms worst\n", event.first.c_str(), timing.source.c_str(), unsigned(timing.calls),
+						double(timing.total) * 1000.0 / (double(osd_ticks_per_second()) * timing.calls), double(timing.worst) * 1000.0 / double(osd_ticks_per_second()));
 }
 
 void lua_engine::on_machine_pause()
@@ -686,6 +825,21 @@ void lua_engine::on_machine_resume()
 
 void lua_engine::on_machine_frame()
 {
+	// refresh the live watch lists in one pass, dropping collected ones
+	for(auto it = m_watches.begin(); it != m_watches.end(); )
+	{
+		if(std::shared_ptr<mem_watch> watch = it->lock())
+		{
+			watch->refresh();
+			++it;
+		}
+		else
+			it = m_watches.erase(it);
+	}
+
+	for(auto &worker : m_workers)
+		worker->frame();
+
 	execute_function("LUA_ON_FRAME");
 }
 
@@ -707,6 +861,13 @@ void lua_engine::attach_notifiers()
 	machine().add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&lua_engine::on_machine_pause, this));
 	machine().add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&lua_engine::on_machine_resume, this));
 	machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&lua_engine::on_machine_frame, this));
+	machine().output().add_batch_notifier(&lua_engine::output_batch, this);
+	m_output_changes.clear();
+}
+
+void lua_engine::output_batch(output_manager &manager, const std::vector<u32> &ids, void *param)
+{
+	static_cast<lua_engine *>(param)->m_output_changes = ids;
 }
 
 //-------------------------------------------------
@@ -734,6 +895,7 @@ void lua_engine::initialize()
  * emu.register_frame(callback) - callback at end of frame
  * emu.register_frame_done(callback) - callback after frame is drawn to screen (for overlays)
  * emu.register_periodic(callback) - periodic callback while program is running
+ * emu.callback_timing() - time spent in each registered callback so far
  * emu.register_menu(event_callback, populate_callback, name) - callbacks for plugin menu
  * emu.print_verbose(str) -- output to stderr at verbose level
  * emu.print_error(str) -- output to stderr at error level
@@ -770,6 +932,22 @@ void lua_engine::initialize()
 	emu["register_frame"] = [this](sol::function func){ register_function(func, "LUA_ON_FRAME"); };
 	emu["register_frame_done"] = [this](sol::function func){ register_function(func, "LUA_ON_FRAME_DONE"); };
 	emu["register_periodic"] = [this](sol::function func){ register_function(func, "LUA_ON_PERIODIC"); };
+	emu["callback_timing"] = [this]() {
+			sol::table table = sol().create_table();
+			double const scale = 1.0 / double(osd_ticks_per_second());
+			for(auto &event : m_callback_timing)
+				for(callback_timing &timing : event.second)
+				{
+					sol::table entry = sol().create_table();
+					entry["event"] = event.first;
+					entry["source"] = timing.source;
+					entry["calls"] = timing.calls;
+					entry["total"] = double(timing.total) * scale;
+					entry["worst"] = double(timing.worst) * scale;
+					table.add(entry);
+				}
+			return table;
+		};
 	emu["register_menu"] = [this](sol::function cb, sol::function pop, const std::string &name) {
 			std::string cbfield = "menu_cb_" + name;
 			std::string popfield = "menu_pop_" + name;
@@ -974,6 +1152,35 @@ void lua_engine::initialize()
 			"busy", sol::readonly(&context::busy),
 			"yield", sol::readonly(&context::yield));
 
+/*
+ * emu.worker(filename) - run the script in filename in its own lua state on a worker thread
+ * worker:range(name, space, first, last) - pass bytes first..last of space to the script each frame
+ * worker:output(name) - pass the value of an output to the script each frame
+ * worker:stop() - stop the script and remove its overlay
+ * worker.dropped - frames the script was too busy to see
+ */
+
+	emu["worker"] = [this](const std::string &filename) {
+			auto worker = std::make_shared<lua_worker>(machine(), filename);
+			m_workers.push_back(worker);
+			return worker;
+		};
+	emu.new_usertype<lua_worker>("lua_worker", "new", sol::no_constructor,
+			"range", [](lua_worker &worker, const std::string &name, addr_space &sp, offs_t first, offs_t last) {
+					worker.add_range(name, sp.space, first, last);
+				},
+			"output", &lua_worker::add_output,
+			"stop", [this](lua_worker &worker) {
+					worker.stop();
+					for(auto it = m_workers.begin(); it != m_workers.end(); ++it)
+						if(it->get() == &worker)
+						{
+							m_workers.erase(it);
+							break;
+						}
+				},
+			"dropped", sol::property(&lua_worker::dropped));
+
 	emu.new_usertype<save_item>("item", sol::call_constructor, sol::initializers([this](save_item &item, int index) {
 					if(!machine().save().indexed_item(index, item.base, item.size, item.count))
 					{
@@ -1392,6 +1599,13 @@ void lua_engine::initialize()
 					return table;
 				}));
 
+/* device.spaces[space_name]
+ * space:read_range(first, last, width, [step]) - read width bit values from first to last into a string, packed in host order
+ * space:write_range(address, data, width, [step]) - write width bit values packed in host order from a string
+ *   both step through addresses by step, which defaults to the size of a value in bytes
+ * space:watch_list() - create a watch list, refreshed in one pass before the frame callbacks
+ */
+
 	sol().registry().new_usertype<addr_space>("addr_space", sol::call_constructor, sol::constructors<sol::types<address_space &, device_memory_interface &>>(),
 			"read_i8", &addr_space::mem_read<int8_t>,
 			"read_u8", &addr_space::mem_read<uint8_t>,
@@ -1441,6 +1655,45 @@ void lua_engine::initialize()
 			"write_direct_u32", &addr_space::direct_mem_write<uint32_t>,
 			"write_direct_i64", &addr_space::direct_mem_write<int64_t>,
 			"write_direct_u64", &addr_space::direct_mem_write<uint64_t>,
+			"read_range", [](addr_space &sp, offs_t first, offs_t last, int width, sol::object step) {
+					offs_t const stride = step.is<offs_t>() ? step.as<offs_t>() : range_step(width);
+					switch(width)
+					{
+						case 8:
+						default:
+							return sp.mem_read_range<uint8_t>(first, last, stride);
+						case 16:
+							return sp.mem_read_range<uint16_t>(first, last, stride);
+						case 32:
+							return sp.mem_read_range<uint32_t>(first, last, stride);
+						case 64:
+							return sp.mem_read_range<uint64_t>(first, last, stride);
+					}
+				},
+			"write_range", [](addr_space &sp, offs_t address, const std::string &data, int width, sol::object step) {
+					offs_t const stride = step.is<offs_t>() ? step.as<offs_t>() : range_step(width);
+					switch(width)
+					{
+						case 8:
+						default:
+							sp.mem_write_range<uint8_t>(address, data, stride);
+							break;
+						case 16:
+							sp.mem_write_range<uint16_t>(address, data, stride);
+							break;
+						case 32:
+							sp.mem_write_range<uint32_t>(address, data, stride);
+							break;
+						case 64:
+							sp.mem_write_range<uint64_t>(address, data, stride);
+							break;
+					}
+				},
+			"watch_list", [this](addr_space &sp) {
+					auto watch = std::make_shared<mem_watch>(sp);
+					m_watches.push_back(watch);
+					return watch;
+				},
 			"name", sol::property(&addr_space::name),
 			"shift", sol::property([](addr_space &sp) { return sp.space.addr_shift(); }),
 			"map", sol::property([this](addr_space &sp) {
@@ -1458,6 +1711,37 @@ void lua_engine::initialize()
 					return map;
 				}));
 
+/* space:watch_list()
+ * watch:add(address, width) - watch a width bit value, returning its index
+ * watch:clear() - stop watching everything
+ * watch:refresh() - read the watched values now (nothing is read once the machine has stopped)
+ * watch.values[] - values as of the last refresh
+ * watch.changed[] - indexes of the values that changed at the last refresh
+ */
+
+	sol().registry().new_usertype<mem_watch>("mem_watch", "new", sol::no_constructor,
+			"add", [](mem_watch &watch, offs_t address, int width) {
+					watch.entries.push_back({ address, width, 0 });
+					return int(watch.entries.size());
+				},
+			"clear", [](mem_watch &watch) {
+					watch.entries.clear();
+					watch.changed.clear();
+				},
+			"refresh", &mem_watch::refresh,
+			"values", sol::property([this](mem_watch &watch) {
+					sol::table table = sol().create_table(watch.entries.size(), 0);
+					for(int index = 0; index < watch.entries.size(); index++)
+						table[index + 1] = watch.entries[index].value;
+					return table;
+				}),
+			"changed", sol::property([this](mem_watch &watch) {
+					sol::table table = sol().create_table(watch.changed.size(), 0);
+					for(int index = 0; index < watch.changed.size(); index++)
+						table[index + 1] = watch.changed[index];
+					return table;
+				}));
+
 /* machine:ioport()
  * ioport:count_players() - get count of player controllers
  * ioport.ports[] - ioports table
@@ -1961,6 +2245,8 @@ void lua_engine::initialize()
  * output:get_indexed_value(index) - get output index value
  * output:name_to_id(name) - get index for name
  * output:id_to_name(index) - get name for index
+ * output:get_id_value(index) - get value for index
+ * output:changed() - table of name/value for the outputs changed in the last frame
  */
 
 	sol().registry().new_usertype<output_manager>("output", "new", sol::no_constructor,
@@ -1969,7 +2255,14 @@ void lua_engine::initialize()
 			"get_value", &output_manager::get_value,
 			"get_indexed_value", [](output_manager &o, char const *basename, int index) { return o.get_value(util::string_format("%s%d", basename, index).c_str()); },
 			"name_to_id", &output_manager::name_to_id,
-			"id_to_name", &output_manager::id_to_name);
+			"id_to_name", &output_manager::id_to_name,
+			"get_id_value", [](output_manager &o, u32 id) { return o.value(id); },
+			"changed", [this](output_manager &o) {
+					sol::table changed = sol().create_table(0, m_output_changes.size());
+					for(u32 id : m_output_changes)
+						changed[o.id_to_name(id)] = o.value(id);
+					return changed;
+				});
 
 /* machine.images[] - images are floppy/cart/cdrom/tape/hdd etc, otherwise this should be self explanatory
  */
@@ -2005,7 +2298,9 @@ void lua_engine::initialize()
 //-------------------------------------------------
 bool lua_engine::frame_hook()
 {
-	return execute_function("LUA_ON_FRAME_DONE");
+	for(auto &worker : m_workers)
+		worker->draw();
+	return execute_function("LUA_ON_FRAME_DONE") || !m_workers.empty();
 }
 
 //-------------------------------------------------
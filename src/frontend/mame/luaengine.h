@@ -28,6 +28,7 @@
 #include "sol2/sol.hpp"
 
 struct lua_State;
+class lua_worker;
 
 class lua_engine
 {
@@ -138,12 +139,50 @@ private:
 		template<typename T> void log_mem_write(offs_t address, T val);
 		template<typename T> T direct_mem_read(offs_t address);
 		template<typename T> void direct_mem_write(offs_t address, T val);
+		template<typename T> std::string mem_read_range(offs_t first, offs_t last, offs_t step);
+		template<typename T> void mem_write_range(offs_t address, const std::string &data, offs_t step);
 		const char *name() const { return space.name(); }
 
 		address_space &space;
 		device_memory_interface &dev;
 	};
 
+	// a set of addresses read in one pass before each frame callback
+	struct mem_watch {
+		mem_watch(const addr_space &sp) : sp(sp), live(true) {}
+		void refresh();
+
+		struct entry {
+			offs_t address;
+			int width;
+			uint64_t value;
+		};
+
+		addr_space sp;                          // only usable while live
+		bool live;                              // cleared when the machine stops
+		std::vector<entry> entries;
+		std::vector<int> changed;               // 1-based indexes changed at the last refresh
+	};
+	std::vector<std::weak_ptr<mem_watch>> m_watches;
+
+	// time spent in each registered callback
+	struct callback_timing {
+		callback_timing(std::string &&source) : source(std::move(source)), calls(0), total(0), worst(0) {}
+
+		std::string source;
+		uint64_t calls;
+		osd_ticks_t total;
+		osd_ticks_t worst;
+	};
+	std::map<std::string, std::vector<callback_timing>> m_callback_timing;
+
+	// scripts running in their own state on worker threads
+	std::vector<std::shared_ptr<lua_worker>> m_workers;
+
+	// outputs changed in the last frame, from the output manager's batch notifier
+	std::vector<u32> m_output_changes;
+	static void output_batch(output_manager &manager, const std::vector<u32> &ids, void *param);
+
 	template<typename T> static T share_read(memory_share &share, offs_t address);
 	template<typename T> static void share_write(memory_share &share, offs_t address, T val);
 	template<typename T> static T region_read(memory_region &region, offs_t address);
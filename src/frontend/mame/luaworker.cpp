@@ -0,0 +1,341 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    luaworker.cpp
+
+    Lua scripts running in their own Lua state on a worker thread.
+
+***************************************************************************/
+
+#include <lua.hpp>
+#include "emu.h"
+#include "mame.h"
+#include "ui/ui.h"
+#include "luaengine.h"
+#include "luaworker.h"
+
+extern "C" {
+	int luaopen_zlib(lua_State *L);
+	int luaopen_lfs(lua_State *L);
+}
+
+
+//**************************************************************************
+//  LUA WORKER
+//**************************************************************************
+
+//-------------------------------------------------
+//  lua_worker - constructor
+//-------------------------------------------------
+
+lua_worker::lua_worker(running_machine &machine, const std::string &filename)
+	: m_machine(machine)
+	, m_filename(filename)
+	, m_frame(0)
+	, m_dropped(0)
+	, m_pending(false)
+	, m_exit(false)
+{
+	m_thread = std::thread([this] () { thread_main(); });
+}
+
+
+//-------------------------------------------------
+//  ~lua_worker - destructor
+//-------------------------------------------------
+
+lua_worker::~lua_worker()
+{
+	stop();
+}
+
+
+//-------------------------------------------------
+//  add_range - copy a range of byte addresses
+//  into every snapshot
+//-------------------------------------------------
+
+void lua_worker::add_range(const std::string &name, address_space &space, offs_t first, offs_t last)
+{
+	if (first <= last)
+		m_ranges.push_back({ name, &space, first, last });
+}
+
+
+//-------------------------------------------------
+//  add_output - copy an output value into every
+//  snapshot
+//-------------------------------------------------
+
+void lua_worker::add_output(const std::string &name)
+{
+	m_outputs.push_back(name);
+}
+
+
+//-------------------------------------------------
+//  frame - apply what the worker sent back since
+//  the last frame and hand it a new snapshot
+//-------------------------------------------------
+
+void lua_worker::frame()
+{
+	if (m_exit)
+		return;
+
+	// apply the answers in the order they were produced
+	std::unique_ptr<command_batch> batch;
+	while (m_commands.pop(batch))
+		apply(*batch);
+
+	// copy out what the script asked for
+	auto snap = std::make_unique<snapshot>();
+	snap->frame = m_frame++;
+	snap->time = m_machine.time().as_double();
+	snap->ranges.reserve(m_ranges.size());
+	for (const range &r : m_ranges)
+	{
+		std::string data;
+		data.reserve(r.last - r.first + 1);
+		for (offs_t address = r.first; ; address++)
+		{
+			data.push_back(char(r.space->read_byte(address)));
+			if (address == r.last)
+				break;
+		}
+		snap->ranges.emplace_back(r.name, std::move(data));
+	}
+	snap->outputs.reserve(m_outputs.size());
+	for (const std::string &name : m_outputs)
+		snap->outputs.emplace_back(name, m_machine.output().get_value(name.c_str()));
+
+	// a worker still busy with an older frame just misses this one
+	if (!m_snapshots.push(std::move(snap)))
+		m_dropped++;
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeup_lock);
+		m_pending = true;
+	}
+	m_wakeup.notify_one();
+}
+
+
+//-------------------------------------------------
+//  apply - perform one batch of commands; draw
+//  commands replace the current overlay
+//-------------------------------------------------
+
+void lua_worker::apply(command_batch &batch)
+{
+	m_overlay.clear();
+	for (command &cmd : batch)
+	{
+		switch (cmd.type)
+		{
+		case command::INPUT:
+			{
+				auto const port = m_machine.ioport().ports().find(cmd.text);
+				ioport_field *const field = (port != m_machine.ioport().ports().end()) ? port->second->field(cmd.mask) : nullptr;
+				if (field)
+					field->set_value(cmd.value);
+			}
+			break;
+
+		case command::MESSAGE:
+			osd_printf_error("%s: %s\n", m_filename.c_str(), cmd.text.c_str());
+			break;
+
+		default:
+			m_overlay.push_back(std::move(cmd));
+			break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  draw - draw the current overlay on the first
+//  screen, scaled like the screen_dev methods
+//-------------------------------------------------
+
+void lua_worker::draw()
+{
+	screen_device *const screen = screen_device_iterator(m_machine.root_device()).first();
+	if (!screen || m_overlay.empty())
+		return;
+
+	float const sc_width = screen->visible_area().width();
+	float const sc_height = screen->visible_area().height();
+	auto const scale_x = [sc_width] (float x) { return std::min(std::max(0.0f, x), sc_width - 1) / sc_width; };
+	auto const scale_y = [sc_height] (float y) { return std::min(std::max(0.0f, y), sc_height - 1) / sc_height; };
+	mame_ui_manager &ui = mame_machine_manager::instance()->ui();
+
+	for (const command &cmd : m_overlay)
+	{
+		float const x1 = scale_x(cmd.x1), y1 = scale_y(cmd.y1);
+		switch (cmd.type)
+		{
+		case command::BOX:
+			ui.draw_outlined_box(screen->container(), x1, y1, scale_x(cmd.x2), scale_y(cmd.y2), cmd.fgcolor, cmd.bgcolor);
+			break;
+
+		case command::LINE:
+			screen->container().add_line(x1, y1, scale_x(cmd.x2), scale_y(cmd.y2), UI_LINE_WIDTH, rgb_t(cmd.fgcolor), PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+			break;
+
+		case command::TEXT:
+			ui.draw_text_full(screen->container(), cmd.text.c_str(), x1, y1, 1.0f - x1,
+					ui::text_layout::LEFT, ui::text_layout::WORD, mame_ui_manager::NORMAL, rgb_t(cmd.fgcolor),
+					rgb_t(cmd.bgcolor), nullptr, nullptr);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  stop - ask the worker to finish and wait for
+//  it; later frames are ignored
+//-------------------------------------------------
+
+void lua_worker::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_wakeup_lock);
+		m_exit = true;
+	}
+	m_wakeup.notify_one();
+	if (m_thread.joinable())
+		m_thread.join();
+	m_overlay.clear();
+}
+
+
+//-------------------------------------------------
+//  thread_main - load the script and run its frame
+//  callbacks against each new snapshot
+//-------------------------------------------------
+
+/*
+ * worker.register_frame(callback) - call callback(snapshot) for each frame the worker keeps up with
+ * worker.input(tag, mask, value) - set an input field
+ * worker.draw_box(x1, y1, x2, y2, bgcolor, fgcolor) - draw a box on the first screen until the next frame
+ * worker.draw_line(x1, y1, x2, y2, color) - draw a line on the first screen until the next frame
+ * worker.draw_text(x, y, text, [color]) - draw text on the first screen until the next frame
+ * worker.print(text) - show text on the error console
+ *
+ * snapshot.frame - frames since the worker was started
+ * snapshot.time - emulated time in seconds
+ * snapshot.ranges[name] - memory range contents as a byte string
+ * snapshot.outputs[name] - output values
+ */
+
+void lua_worker::thread_main()
+{
+	sol::state lua;
+	lua.open_libraries();
+	lua["package"]["preload"]["zlib"] = &luaopen_zlib;
+	lua["package"]["preload"]["lfs"] = &luaopen_lfs;
+
+	command_batch batch;
+	std::vector<sol::protected_function> callbacks;
+
+	auto const message = [&batch] (std::string &&text) {
+			command cmd = { command::MESSAGE, std::move(text), 0, 0, 0, 0, 0, 0, 0, 0 };
+			batch.push_back(std::move(cmd));
+		};
+	auto const send = [this, &batch] () {
+			if (batch.empty())
+				return;
+			// the emulation thread drains every frame, so this only fails when it is stopped
+			m_commands.push(std::make_unique<command_batch>(std::move(batch)));
+			batch.clear();
+		};
+
+	sol::table worker = lua.create_named_table("worker");
+	worker["register_frame"] = [&callbacks] (sol::protected_function func) { callbacks.push_back(func); };
+	worker["input"] = [&batch] (const std::string &tag, ioport_value mask, ioport_value value) {
+			batch.push_back({ command::INPUT, tag, mask, value, 0, 0, 0, 0, 0, 0 });
+		};
+	worker["draw_box"] = [&batch] (float x1, float y1, float x2, float y2, u32 bgcolor, u32 fgcolor) {
+			batch.push_back({ command::BOX, std::string(), 0, 0, x1, y1, x2, y2, fgcolor, bgcolor });
+		};
+	worker["draw_line"] = [&batch] (float x1, float y1, float x2, float y2, u32 color) {
+			batch.push_back({ command::LINE, std::string(), 0, 0, x1, y1, x2, y2, color, 0 });
+		};
+	worker["draw_text"] = [&batch] (float x, float y, const std::string &text, sol::object color) {
+			u32 const fgcolor = color.is<u32>() ? color.as<u32>() : u32(UI_TEXT_COLOR);
+			batch.push_back({ command::TEXT, text, 0, 0, x, y, 0, 0, fgcolor, u32(UI_TEXT_BG_COLOR) });
+		};
+	worker["print"] = [&message] (const std::string &text) { message(std::string(text)); };
+
+	sol::load_result res = lua.load_file(m_filename);
+	if (!res.valid())
+	{
+		sol::error err = res;
+		message(std::string("error loading script: ") + err.what());
+	}
+	else
+	{
+		sol::protected_function_result result = res.get<sol::protected_function>()();
+		if (!result.valid())
+		{
+			sol::error err = result;
+			message(std::string("error running script: ") + err.what());
+		}
+	}
+	send();
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_wakeup_lock);
+			m_wakeup.wait(lock, [this] () { return m_pending || m_exit; });
+			m_pending = false;
+		}
+		if (m_exit)
+			break;
+
+		// only the newest snapshot is worth looking at; the older ones count as missed
+		std::unique_ptr<snapshot> snap, next;
+		while (m_snapshots.pop(next))
+		{
+			if (snap)
+				m_dropped++;
+			snap = std::move(next);
+		}
+		if (!snap || callbacks.empty())
+			continue;
+
+		sol::table ranges = lua.create_table(0, snap->ranges.size());
+		for (auto &r : snap->ranges)
+			ranges[r.first] = r.second;
+		sol::table outputs = lua.create_table(0, snap->outputs.size());
+		for (auto &o : snap->outputs)
+			outputs[o.first] = o.second;
+		sol::table table = lua.create_table();
+		table["frame"] = snap->frame;
+		table["time"] = snap->time;
+		table["ranges"] = ranges;
+		table["outputs"] = outputs;
+
+		for (sol::protected_function &func : callbacks)
+		{
+			sol::protected_function_result result = func(table);
+			if (!result.valid())
+			{
+				sol::error err = result;
+				message(std::string("error in frame callback: ") + err.what());
+			}
+		}
+
+		// always answer, so an empty batch clears last frame's overlay
+		m_commands.push(std::make_unique<command_batch>(std::move(batch)));
+		batch.clear();
+	}
+}
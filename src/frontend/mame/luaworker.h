@@ -0,0 +1,110 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    luaworker.h
+
+    Lua scripts running in their own Lua state on a worker thread.
+
+    A worker never touches the running machine.  Each frame the emulation
+    thread copies the memory ranges and outputs the script asked for into
+    a snapshot and hands it over; the script answers with a batch of input
+    and overlay commands that the emulation thread applies on the next
+    frame.  Both directions go through single producer/single consumer
+    queues, so a slow script drops snapshots instead of stalling emulation.
+
+***************************************************************************/
+
+#ifndef MAME_FRONTEND_LUAWORKER_H
+#define MAME_FRONTEND_LUAWORKER_H
+
+#pragma once
+
+#include "spscqueue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> lua_worker
+
+class lua_worker
+{
+public:
+	// construction/destruction
+	lua_worker(running_machine &machine, const std::string &filename);
+	~lua_worker();
+
+	// snapshot contents, declared from the emulation thread
+	void add_range(const std::string &name, address_space &space, offs_t first, offs_t last);
+	void add_output(const std::string &name);
+
+	// emulation thread hooks
+	void frame();
+	void draw();
+	void stop();
+
+	// statistics
+	u64 dropped() const { return m_dropped; }
+
+private:
+	struct range
+	{
+		std::string     name;
+		address_space * space;
+		offs_t          first;
+		offs_t          last;
+	};
+
+	// what the script sees each frame
+	struct snapshot
+	{
+		u64                                             frame;
+		double                                          time;
+		std::vector<std::pair<std::string, std::string>> ranges;
+		std::vector<std::pair<std::string, s32>>        outputs;
+	};
+
+	// what the script asks for in return
+	struct command
+	{
+		enum command_type { INPUT, BOX, LINE, TEXT, MESSAGE };
+
+		command_type    type;
+		std::string     text;           // port tag or text
+		ioport_value    mask, value;
+		float           x1, y1, x2, y2;
+		u32             fgcolor, bgcolor;
+	};
+	typedef std::vector<command> command_batch;
+
+	void thread_main();
+	void apply(command_batch &batch);
+
+	running_machine &                                   m_machine;
+	std::string                                         m_filename;
+	std::vector<range>                                  m_ranges;
+	std::vector<std::string>                            m_outputs;
+	u64                                                 m_frame;
+	std::atomic<u64>                                    m_dropped;      // snapshots never shown to the script
+	command_batch                                       m_overlay;      // draw commands from the latest batch
+
+	util::spsc_queue<std::unique_ptr<snapshot>, 4>      m_snapshots;    // emulation -> worker
+	util::spsc_queue<std::unique_ptr<command_batch>, 16> m_commands;    // worker -> emulation
+	std::mutex                                          m_wakeup_lock;
+	std::condition_variable                             m_wakeup;
+	bool                                                m_pending;      // guarded by m_wakeup_lock
+	std::atomic<bool>                                   m_exit;
+	std::thread                                         m_thread;
+};
+
+#endif // MAME_FRONTEND_LUAWORKER_H
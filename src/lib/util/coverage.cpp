@@ -0,0 +1,321 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    coverage.cpp
+
+    Memory access heatmap and code coverage for one address space.
+
+    Coverage files are little-endian throughout:
+
+        header:     char[8] "MAMECOV\0", u32 version, u16 page bits,
+                    u16 cell bits, u32 space count, u32 tag length,
+                    tag characters
+        space:      u32 address mask, u32 page count, u32 name length,
+                    name characters, then page count pages
+        page:       u32 page number, touched bitmaps as u64 words for
+                    read, write and exec, then hit counts as u32 words
+                    in the same order
+
+    Only pages that were touched are stored.
+
+***************************************************************************/
+
+#include "coverage.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace util {
+
+namespace {
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+constexpr char COVERAGE_SIGNATURE[8] = { 'M', 'A', 'M', 'E', 'C', 'O', 'V', 0 };
+constexpr std::uint32_t COVERAGE_VERSION = 1;
+
+
+//**************************************************************************
+//  FILE HELPERS
+//**************************************************************************
+
+class coverage_writer
+{
+public:
+	void u16(std::uint16_t value) { m_data.push_back(std::uint8_t(value)); m_data.push_back(std::uint8_t(value >> 8)); }
+	void u32(std::uint32_t value) { u16(std::uint16_t(value)); u16(std::uint16_t(value >> 16)); }
+	void u64(std::uint64_t value) { u32(std::uint32_t(value)); u32(std::uint32_t(value >> 32)); }
+	void string(const std::string &value) { u32(value.length()); m_data.insert(m_data.end(), value.begin(), value.end()); }
+	void bytes(const void *data, std::size_t length) { m_data.insert(m_data.end(), (const std::uint8_t *)data, (const std::uint8_t *)data + length); }
+
+	bool flush(core_file &file)
+	{
+		bool const result = file.write(m_data.data(), m_data.size()) == m_data.size();
+		m_data.clear();
+		return result;
+	}
+
+private:
+	std::vector<std::uint8_t> m_data;
+};
+
+class coverage_reader
+{
+public:
+	coverage_reader(core_file &file) : m_file(file), m_ok(true) { }
+
+	bool ok() const { return m_ok; }
+
+	void bytes(void *data, std::uint32_t length) { if (m_ok && m_file.read(data, length) != length) m_ok = false; }
+	std::uint16_t u16() { std::uint8_t b[2] = { 0, 0 }; bytes(b, 2); return b[0] | (b[1] << 8); }
+	std::uint32_t u32() { std::uint32_t const low = u16(); return low | (std::uint32_t(u16()) << 16); }
+	std::uint64_t u64() { std::uint64_t const low = u32(); return low | (std::uint64_t(u32()) << 32); }
+	std::string string(std::uint32_t maxlength)
+	{
+		std::uint32_t const length = u32();
+		if (length > maxlength)
+		{
+			m_ok = false;
+			return std::string();
+		}
+		std::string result(length, '\0');
+		if (length != 0)
+			bytes(&result[0], length);
+		return result;
+	}
+
+private:
+	core_file & m_file;
+	bool        m_ok;
+};
+
+} // anonymous namespace
+
+
+//**************************************************************************
+//  COVERAGE MAP
+//**************************************************************************
+
+//-------------------------------------------------
+//  coverage_map - constructor
+//-------------------------------------------------
+
+coverage_map::coverage_map(const std::string &name, std::uint32_t addrmask)
+	: m_name(name)
+	, m_addrmask(addrmask)
+	, m_pages(std::size_t(addrmask >> PAGE_BITS) + 1)
+{
+}
+
+
+//-------------------------------------------------
+//  touched - return whether an address saw a
+//  given type of access
+//-------------------------------------------------
+
+bool coverage_map::touched(access_type type, std::uint32_t address) const
+{
+	address &= m_addrmask;
+	const page *const p = find_page(address >> PAGE_BITS);
+	std::uint32_t const offset = address & (PAGE_SIZE - 1);
+	return p && ((p->touched[type][offset >> 6] >> (offset & 63)) & 1);
+}
+
+
+//-------------------------------------------------
+//  hits - return the hit count of the cell
+//  holding an address
+//-------------------------------------------------
+
+std::uint32_t coverage_map::hits(access_type type, std::uint32_t address) const
+{
+	address &= m_addrmask;
+	const page *const p = find_page(address >> PAGE_BITS);
+	return p ? p->hits[type][(address & (PAGE_SIZE - 1)) >> CELL_BITS] : 0;
+}
+
+
+//-------------------------------------------------
+//  touched_count - return the number of addresses
+//  that saw a given type of access
+//-------------------------------------------------
+
+std::uint64_t coverage_map::touched_count(access_type type) const
+{
+	std::uint64_t result = 0;
+	for (const std::unique_ptr<page> &p : m_pages)
+		if (p)
+			for (std::uint64_t word : p->touched[type])
+				for ( ; word != 0; word &= word - 1)
+					result++;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  clear - forget everything recorded so far
+//-------------------------------------------------
+
+void coverage_map::clear()
+{
+	for (std::unique_ptr<page> &p : m_pages)
+		p.reset();
+}
+
+
+//-------------------------------------------------
+//  merge - add another run of the same space, so
+//  coverage of several runs can be combined
+//-------------------------------------------------
+
+void coverage_map::merge(const coverage_map &other)
+{
+	std::uint32_t const count = std::min(page_count(), other.page_count());
+	for (std::uint32_t number = 0; number < count; number++)
+	{
+		const page *const src = other.find_page(number);
+		if (src == nullptr)
+			continue;
+		page *dst = m_pages[number].get();
+		if (dst == nullptr)
+			dst = allocate(number);
+		for (int type = 0; type < TYPE_COUNT; type++)
+		{
+			for (std::uint32_t word = 0; word < PAGE_SIZE / 64; word++)
+				dst->touched[type][word] |= src->touched[type][word];
+			for (std::uint32_t cell = 0; cell < PAGE_CELLS; cell++)
+			{
+				std::uint32_t const sum = dst->hits[type][cell] + src->hits[type][cell];
+				dst->hits[type][cell] = (sum < dst->hits[type][cell]) ? ~std::uint32_t(0) : sum;
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  allocate - create an empty page the first time
+//  it is touched
+//-------------------------------------------------
+
+coverage_map::page *coverage_map::allocate(std::uint32_t number)
+{
+	m_pages[number].reset(new page);
+	page *const p = m_pages[number].get();
+	std::memset(p, 0, sizeof(*p));
+	p->number = number;
+	return p;
+}
+
+
+//-------------------------------------------------
+//  save - write the maps of one device to a
+//  coverage file
+//-------------------------------------------------
+
+coverage_error coverage_map::save(core_file &file, const std::string &tag, const std::vector<const coverage_map *> &maps)
+{
+	coverage_writer writer;
+	writer.bytes(COVERAGE_SIGNATURE, sizeof(COVERAGE_SIGNATURE));
+	writer.u32(COVERAGE_VERSION);
+	writer.u16(PAGE_BITS);
+	writer.u16(CELL_BITS);
+	writer.u32(maps.size());
+	writer.string(tag);
+	if (!writer.flush(file))
+		return coverage_error::FILE_ERROR;
+
+	for (const coverage_map *map : maps)
+	{
+		std::uint32_t pages = 0;
+		for (const std::unique_ptr<page> &p : map->m_pages)
+			if (p)
+				pages++;
+		writer.u32(map->m_addrmask);
+		writer.u32(pages);
+		writer.string(map->m_name);
+
+		// one page at a time keeps the staging buffer small
+		for (const std::unique_ptr<page> &p : map->m_pages)
+		{
+			if (!p)
+				continue;
+			writer.u32(p->number);
+			for (auto &bitmap : p->touched)
+				for (std::uint64_t word : bitmap)
+					writer.u64(word);
+			for (auto &counts : p->hits)
+				for (std::uint32_t count : counts)
+					writer.u32(count);
+			if (!writer.flush(file))
+				return coverage_error::FILE_ERROR;
+		}
+		if (!writer.flush(file))
+			return coverage_error::FILE_ERROR;
+	}
+	return coverage_error::NONE;
+}
+
+
+//-------------------------------------------------
+//  load - read the maps of one device from a
+//  coverage file
+//-------------------------------------------------
+
+coverage_error coverage_map::load(core_file &file, std::string &tag, std::vector<std::unique_ptr<coverage_map>> &maps)
+{
+	coverage_reader reader(file);
+	maps.clear();
+
+	char signature[sizeof(COVERAGE_SIGNATURE)];
+	reader.bytes(signature, sizeof(signature));
+	if (!reader.ok())
+		return coverage_error::FILE_TRUNCATED;
+	if (std::memcmp(signature, COVERAGE_SIGNATURE, sizeof(signature)) != 0)
+		return coverage_error::BAD_SIGNATURE;
+	std::uint32_t const version = reader.u32();
+	std::uint16_t const pagebits = reader.u16();
+	std::uint16_t const cellbits = reader.u16();
+	if (reader.ok() && (version != COVERAGE_VERSION || pagebits != PAGE_BITS || cellbits != CELL_BITS))
+		return coverage_error::UNSUPPORTED_VERSION;
+	std::uint32_t const count = reader.u32();
+	tag = reader.string(1024);
+	if (!reader.ok())
+		return coverage_error::FILE_TRUNCATED;
+
+	for (std::uint32_t index = 0; index < count; index++)
+	{
+		std::uint32_t const addrmask = reader.u32();
+		std::uint32_t const pages = reader.u32();
+		std::string const name = reader.string(1024);
+		if (!reader.ok())
+			return coverage_error::FILE_TRUNCATED;
+
+		auto map = std::make_unique<coverage_map>(name, addrmask);
+		for (std::uint32_t pageindex = 0; pageindex < pages; pageindex++)
+		{
+			std::uint32_t const number = reader.u32();
+			if (!reader.ok())
+				return coverage_error::FILE_TRUNCATED;
+			if (number >= map->page_count() || map->m_pages[number])
+				return coverage_error::FILE_CORRUPT;
+			page *const p = map->allocate(number);
+			for (auto &bitmap : p->touched)
+				for (std::uint64_t &word : bitmap)
+					word = reader.u64();
+			for (auto &counts : p->hits)
+				for (std::uint32_t &count : counts)
+					count = reader.u32();
+			if (!reader.ok())
+				return coverage_error::FILE_TRUNCATED;
+		}
+		maps.push_back(std::move(map));
+	}
+	return coverage_error::NONE;
+}
+
+} // namespace util
@@ -0,0 +1,124 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    coverage.h
+
+    Memory access heatmap and code coverage for one address space.
+
+    The space is split into pages of 4096 addresses that are allocated
+    the first time anything in them is touched.  Each page holds one bit
+    per address and access type, saying whether the address was ever
+    read, written or executed, and a saturating hit counter per 16
+    address cell and access type for heatmaps.
+
+***************************************************************************/
+
+#ifndef MAME_UTIL_COVERAGE_H
+#define MAME_UTIL_COVERAGE_H
+
+#pragma once
+
+#include "corefile.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace util {
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// error types
+enum class coverage_error
+{
+	NONE,
+	FILE_ERROR,
+	BAD_SIGNATURE,
+	UNSUPPORTED_VERSION,
+	FILE_TRUNCATED,
+	FILE_CORRUPT
+};
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> coverage_map
+
+class coverage_map
+{
+public:
+	// access types
+	enum access_type
+	{
+		READ = 0,
+		WRITE,
+		EXEC,
+		TYPE_COUNT
+	};
+
+	// page layout
+	static constexpr unsigned PAGE_BITS = 12;
+	static constexpr unsigned CELL_BITS = 4;
+	static constexpr std::uint32_t PAGE_SIZE = 1 << PAGE_BITS;
+	static constexpr std::uint32_t PAGE_CELLS = PAGE_SIZE >> CELL_BITS;
+
+	struct page
+	{
+		std::uint32_t   number;                             // address >> PAGE_BITS
+		std::uint64_t   touched[TYPE_COUNT][PAGE_SIZE / 64];  // one bit per address
+		std::uint32_t   hits[TYPE_COUNT][PAGE_CELLS];       // saturating count per cell
+	};
+
+	// construction/destruction
+	coverage_map(const std::string &name, std::uint32_t addrmask);
+
+	// getters
+	const std::string &name() const { return m_name; }
+	std::uint32_t addrmask() const { return m_addrmask; }
+	std::uint32_t page_count() const { return m_pages.size(); }
+	const page *find_page(std::uint32_t number) const { return (number < m_pages.size()) ? m_pages[number].get() : nullptr; }
+	bool touched(access_type type, std::uint32_t address) const;
+	std::uint32_t hits(access_type type, std::uint32_t address) const;
+	std::uint64_t touched_count(access_type type) const;
+
+	// record an access; kept inline since it runs on every hooked access
+	void record(access_type type, std::uint32_t address)
+	{
+		address &= m_addrmask;
+		std::uint32_t const number = address >> PAGE_BITS;
+		page *p = m_pages[number].get();
+		if (p == nullptr)
+			p = allocate(number);
+		std::uint32_t const offset = address & (PAGE_SIZE - 1);
+		p->touched[type][offset >> 6] |= std::uint64_t(1) << (offset & 63);
+		std::uint32_t &count = p->hits[type][offset >> CELL_BITS];
+		if (count != ~std::uint32_t(0))
+			count++;
+	}
+
+	// setters
+	void clear();
+	void merge(const coverage_map &other);
+
+	// coverage files hold the maps of every space of one device
+	static coverage_error save(core_file &file, const std::string &tag, const std::vector<const coverage_map *> &maps);
+	static coverage_error load(core_file &file, std::string &tag, std::vector<std::unique_ptr<coverage_map>> &maps);
+
+private:
+	page *allocate(std::uint32_t number);
+
+	std::string                         m_name;         // address space name
+	std::uint32_t                       m_addrmask;     // mask applied to recorded addresses
+	std::vector<std::unique_ptr<page>>  m_pages;        // indexed by page number, null until touched
+};
+
+} // namespace util
+
+#endif // MAME_UTIL_COVERAGE_H
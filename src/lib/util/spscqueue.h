@@ -0,0 +1,74 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    spscqueue.h
+
+    Bounded lock-free queue between exactly one producer thread and one
+    consumer thread.
+
+***************************************************************************/
+
+#ifndef MAME_UTIL_SPSCQUEUE_H
+#define MAME_UTIL_SPSCQUEUE_H
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+
+namespace util {
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> spsc_queue
+
+template <typename T, std::size_t Capacity>
+class spsc_queue
+{
+	static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "spsc_queue capacity must be a power of two");
+
+public:
+	spsc_queue() : m_head(0), m_tail(0) { }
+	spsc_queue(const spsc_queue &) = delete;
+	spsc_queue &operator=(const spsc_queue &) = delete;
+
+	// producer side; returns false and leaves item alone if the queue is full
+	bool push(T &&item)
+	{
+		std::size_t const tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+			return false;
+		m_items[tail & (Capacity - 1)] = std::move(item);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer side; returns false if the queue is empty
+	bool pop(T &item)
+	{
+		std::size_t const head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+		item = std::move(m_items[head & (Capacity - 1)]);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// either side; only a hint while the other side is running
+	bool empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+private:
+	std::array<T, Capacity>     m_items;
+	std::atomic<std::size_t>    m_head;         // next item to pop, only written by the consumer
+	std::atomic<std::size_t>    m_tail;         // next slot to push, only written by the producer
+};
+
+} // namespace util
+
+#endif // MAME_UTIL_SPSCQUEUE_H
@@ -96,6 +96,17 @@ struct CPS1config
 	int bootleg_kludge;
 };
 
+/* one tile of the buffered sprite table, with the bank mapping already applied */
+struct cps1_sprite
+{
+	int code;
+	int colour;
+	int flipx;
+	int flipy;
+	int sx;
+	int sy;
+};
+
 
 class cps_state : public driver_device
 {
@@ -146,6 +157,8 @@ public:
 	uint16_t *     m_obj;
 	uint16_t *     m_other;
 	std::unique_ptr<uint16_t[]>     m_buffered_obj;
+	std::vector<cps1_sprite>        m_sprite_list;  /* m_buffered_obj flattened to single tiles */
+	bool                            m_sprite_list_dirty;
 	optional_shared_ptr<uint8_t> m_qsound_sharedram1;
 	optional_shared_ptr<uint8_t> m_qsound_sharedram2;
 	std::unique_ptr<uint8_t[]> m_decrypt_kabuki;
@@ -388,6 +401,8 @@ public:
 	void cps1_update_transmasks();
 	void cps1_build_palette(const uint16_t* const palette_base);
 	void cps1_find_last_sprite();
+	void cps1_build_sprite_list();
+	void cps1_invalidate_sprite_list() { m_sprite_list_dirty = true; }
 	void cps1_render_sprites(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect);
 	void cps2_find_last_sprite();
 	void cps2_render_sprites(screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect, int *primasks);
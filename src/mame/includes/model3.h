@@ -159,6 +159,16 @@ public:
 	std::unique_ptr<uint32_t[]> m_display_list_ram;
 	std::unique_ptr<uint32_t[]> m_culling_ram;
 	std::unique_ptr<uint32_t[]> m_polygon_ram;
+	std::unique_ptr<uint32_t[]> m_display_list_snap;   // copies the geometry thread walks
+	std::unique_ptr<uint32_t[]> m_culling_snap;
+	std::unique_ptr<uint32_t[]> m_polygon_snap;
+	uint32_t m_display_list_dirty[2];                   // word range written since the last copy
+	uint32_t m_culling_dirty[2];
+	uint32_t m_polygon_dirty[2];
+	osd_work_queue *m_geo_queue;
+	osd_work_item *m_geo_item;
+	std::exception_ptr m_geo_error;                     // thrown by the last walk, rethrown at sync
+	std::vector<std::pair<uint32_t, uint32_t>> m_geo_bad_links; // unknown links seen by the last walk
 	int m_real3d_display_list;
 	rectangle m_clip3d;
 	rectangle *m_screen_clip;
@@ -321,6 +331,11 @@ public:
 	void draw_block(uint32_t address);
 	void draw_viewport(int pri, uint32_t address);
 	void real3d_traverse_display_list();
+	void real3d_render_frame();
+	void real3d_geometry_sync();
+	static void *real3d_geometry_callback(void *param, int threadid);
+	static void real3d_mark_dirty(uint32_t *dirty, uint32_t start, uint32_t count);
+	static void real3d_snapshot(uint32_t *dst, const uint32_t *src, uint32_t *dirty, uint32_t size);
 	void real3d_display_list_end();
 	void real3d_display_list1_dma(uint32_t src, uint32_t dst, int length, int byteswap);
 	void real3d_display_list2_dma(uint32_t src, uint32_t dst, int length, int byteswap);
@@ -2270,6 +2270,7 @@ VIDEO_START_MEMBER(cps_state,cps)
 		m_palette->set_pen_color(i, rgb_t(0,0,0));
 
 	m_buffered_obj = make_unique_clear<uint16_t[]>(m_obj_size / 2);
+	m_sprite_list_dirty = true;
 
 	if (m_cps_version == 2)
 		m_cps2_buffered_obj = make_unique_clear<uint16_t[]>(m_cps2_obj_size / 2);
@@ -2335,6 +2336,7 @@ VIDEO_START_MEMBER(cps_state,cps)
 	}
 
 	machine().save().register_postload(save_prepost_delegate(FUNC(cps_state::cps1_get_video_base), this));
+	machine().save().register_postload(save_prepost_delegate(FUNC(cps_state::cps1_invalidate_sprite_list), this));
 }
 
 VIDEO_START_MEMBER(cps_state,cps1)
@@ -2468,26 +2470,13 @@ void cps_state::cps1_find_last_sprite()    /* Find the offset of last sprite */
 }
 
 
-void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect )
+void cps_state::cps1_build_sprite_list()
 {
-#define DRAWSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)                    \
-{                                                                   \
-	if (flip_screen())                                           \
-		m_gfxdecode->gfx(2)->prio_transpen(bitmap,\
-				cliprect,                            \
-				CODE,                                               \
-				COLOR,                                              \
-				!(FLIPX),!(FLIPY),                                  \
-				512-16-(SX),256-16-(SY),    screen.priority(),0x02,15);                   \
-	else                                                            \
-		m_gfxdecode->gfx(2)->prio_transpen(bitmap,\
-				cliprect,                            \
-				CODE,                                               \
-				COLOR,                                              \
-				FLIPX,FLIPY,                                        \
-				SX,SY, screen.priority(),0x02,15);          \
-}
+#define ADDSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)                     \
+	m_sprite_list.push_back(cps1_sprite{ CODE, COLOR, FLIPX, FLIPY, SX, SY })
 
+	m_sprite_list.clear();
+	m_sprite_list_dirty = false;
 
 	int i, baseadd;
 	uint16_t *base = m_buffered_obj.get();
@@ -2539,7 +2528,7 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 								sx = (x + nxs * 16) & 0x1ff;
 								sy = (y + nys * 16) & 0x1ff;
 
-								DRAWSPRITE(
+								ADDSPRITE(
 //                                      code + (nx - 1) - nxs + 0x10 * (ny - 1 - nys),
 										(code & ~0xf) + ((code + (nx - 1) - nxs) & 0xf) + 0x10 * (ny - 1 - nys),
 										(col & 0x1f),
@@ -2557,7 +2546,7 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 								sx = (x + nxs * 16) & 0x1ff;
 								sy = (y + nys * 16) & 0x1ff;
 
-								DRAWSPRITE(
+								ADDSPRITE(
 //                                      code + nxs + 0x10 * (ny - 1 - nys),
 										(code & ~0xf) + ((code + nxs) & 0xf) + 0x10 * (ny - 1 - nys),
 										(col & 0x1f),
@@ -2578,7 +2567,7 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 								sx = (x + nxs * 16) & 0x1ff;
 								sy = (y + nys * 16) & 0x1ff;
 
-								DRAWSPRITE(
+								ADDSPRITE(
 //                                      code + (nx - 1) - nxs + 0x10 * nys,
 										(code & ~0xf) + ((code + (nx - 1) - nxs) & 0xf) + 0x10 * nys,
 										(col & 0x1f),
@@ -2596,7 +2585,7 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 								sx = (x + nxs * 16) & 0x1ff;
 								sy = (y + nys * 16) & 0x1ff;
 
-								DRAWSPRITE(
+								ADDSPRITE(
 //                                      code + nxs + 0x10 * nys,
 										(code & ~0xf) + ((code + nxs) & 0xf) + 0x10 * nys,  // fix 00406: qadjr: When playing as the ninja, there is one broken frame in his animation loop when walking.
 										(col & 0x1f),
@@ -2610,7 +2599,7 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 			else
 			{
 				/* Simple case... 1 sprite */
-						DRAWSPRITE(
+						ADDSPRITE(
 						code,
 						(col & 0x1f),
 						colour&0x20,colour&0x40,
@@ -2619,6 +2608,37 @@ void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap
 		}
 		base += baseadd;
 	}
+#undef ADDSPRITE
+}
+
+
+void cps_state::cps1_render_sprites( screen_device &screen, bitmap_ind16 &bitmap, const rectangle &cliprect )
+{
+#define DRAWSPRITE(CODE,COLOR,FLIPX,FLIPY,SX,SY)                    \
+{                                                                   \
+	if (flip_screen())                                           \
+		m_gfxdecode->gfx(2)->prio_transpen(bitmap,\
+				cliprect,                            \
+				CODE,                                               \
+				COLOR,                                              \
+				!(FLIPX),!(FLIPY),                                  \
+				512-16-(SX),256-16-(SY),    screen.priority(),0x02,15);                   \
+	else                                                            \
+		m_gfxdecode->gfx(2)->prio_transpen(bitmap,\
+				cliprect,                            \
+				CODE,                                               \
+				COLOR,                                              \
+				FLIPX,FLIPY,                                        \
+				SX,SY, screen.priority(),0x02,15);          \
+}
+
+
+	/* the buffered table only changes at vblank, so it's walked once per change rather than on every update */
+	if (m_sprite_list_dirty)
+		cps1_build_sprite_list();
+
+	for (const cps1_sprite &sprite : m_sprite_list)
+		DRAWSPRITE(sprite.code, sprite.colour, sprite.flipx, sprite.flipy, sprite.sx, sprite.sy);
 #undef DRAWSPRITE
 }
 
@@ -3115,7 +3135,11 @@ WRITE_LINE_MEMBER(cps_state::screen_vblank_cps1)
 		if (m_cps_version == 1)
 		{
 			/* CPS1 sprites have to be delayed one frame */
-			memcpy(m_buffered_obj.get(), m_obj, m_obj_size);
+			if (memcmp(m_buffered_obj.get(), m_obj, m_obj_size) != 0)
+			{
+				memcpy(m_buffered_obj.get(), m_obj, m_obj_size);
+				m_sprite_list_dirty = true;
+			}
 		}
 	}
 }
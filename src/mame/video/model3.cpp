@@ -84,6 +84,17 @@ private:
 
 void model3_state::model3_exit()
 {
+	// a frame that failed after the last sync has nowhere to report to now
+	try
+	{
+		real3d_geometry_sync();
+	}
+	catch (emu_fatalerror &)
+	{
+	}
+	if (m_geo_queue != nullptr)
+		osd_work_queue_free(m_geo_queue);
+
 #if 0
 	FILE* file;
 	int i;
@@ -195,6 +206,15 @@ void model3_state::video_start()
 	/* 4MB Polygon RAM */
 	m_polygon_ram = make_unique_clear<uint32_t[]>(0x400000/4);
 
+	/* the display list is walked on a separate thread from copies taken at display list end */
+	m_display_list_snap = make_unique_clear<uint32_t[]>(0x100000/4);
+	m_culling_snap = make_unique_clear<uint32_t[]>(0x400000/4);
+	m_polygon_snap = make_unique_clear<uint32_t[]>(0x400000/4);
+	m_display_list_dirty[0] = m_culling_dirty[0] = m_polygon_dirty[0] = ~0;
+	m_display_list_dirty[1] = m_culling_dirty[1] = m_polygon_dirty[1] = 0;
+	m_geo_queue = osd_work_queue_alloc(0);
+	m_geo_item = nullptr;
+
 	m_vid_reg0 = 0;
 
 	m_layer4[0] = &machine().tilemap().create(*m_gfxdecode, tilemap_get_info_delegate(FUNC(model3_state::tile_info_layer0_4bit), this), TILEMAP_SCAN_ROWS, 8, 8, 64, 64);
@@ -371,6 +391,7 @@ uint32_t model3_state::screen_update_model3(screen_device &screen, bitmap_rgb32
 		draw_layer(bitmap, cliprect, 0, layer_scroll_x[0], layer_scroll_y[0], 0);
 
 	// render 3D
+	real3d_geometry_sync();
 	m_renderer->draw(bitmap, cliprect);
 
 	// render enabled layers with priority 1
@@ -983,6 +1004,7 @@ cached_texture *model3_state::get_texture(int page, int texx, int texy, int texw
 
 WRITE64_MEMBER(model3_state::real3d_display_list_w)
 {
+	real3d_mark_dirty(m_display_list_dirty, offset*2, 2);
 	if (ACCESSING_BITS_32_63)
 	{
 		m_display_list_ram[offset*2] = BYTE_REVERSE32((uint32_t)(data >> 32));
@@ -995,6 +1017,7 @@ WRITE64_MEMBER(model3_state::real3d_display_list_w)
 
 WRITE64_MEMBER(model3_state::real3d_polygon_ram_w)
 {
+	real3d_mark_dirty(m_polygon_dirty, offset*2, 2);
 	if (ACCESSING_BITS_32_63)
 	{
 		m_polygon_ram[offset*2] = BYTE_REVERSE32((uint32_t)(data >> 32));
@@ -1226,8 +1249,76 @@ void model3_state::real3d_upload_texture(uint32_t header, uint32_t *data)
 	}
 }
 
+/*
+    The display list is walked, and the resulting triangles queued to the
+    renderer, on a geometry thread so the PowerPC can carry on into the next
+    frame meanwhile.  At display list end the parts of display list, culling
+    and polygon RAM written since the previous frame are copied to snapshots
+    the walk reads from.  Anything else the walk or the renderer use (texture
+    RAM and cache, the framebuffer) is only touched on the emulation side after
+    real3d_geometry_sync().
+
+    The walk must not log or throw on the geometry thread: bad links are
+    kept for real3d_geometry_sync() to log, and a fatal error in the walk
+    is caught there and rethrown on the emulation thread.
+*/
+
+void *model3_state::real3d_geometry_callback(void *param, int threadid)
+{
+	model3_state *state = (model3_state *)param;
+	try
+	{
+		state->real3d_render_frame();
+	}
+	catch (...)
+	{
+		state->m_geo_error = std::current_exception();
+	}
+	return nullptr;
+}
+
+void model3_state::real3d_geometry_sync()
+{
+	if (m_geo_item != nullptr)
+	{
+		osd_work_item_wait(m_geo_item, osd_ticks_per_second() * 100);
+		osd_work_item_release(m_geo_item);
+		m_geo_item = nullptr;
+	}
+
+	for (const auto &link : m_geo_bad_links)
+		logerror("process_link %08X: link = %08X\n", link.first, link.second);
+	m_geo_bad_links.clear();
+
+	if (m_geo_error)
+	{
+		std::exception_ptr error = m_geo_error;
+		m_geo_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+void model3_state::real3d_mark_dirty(uint32_t *dirty, uint32_t start, uint32_t count)
+{
+	dirty[0] = std::min(dirty[0], start);
+	dirty[1] = std::max(dirty[1], start + count);
+}
+
+void model3_state::real3d_snapshot(uint32_t *dst, const uint32_t *src, uint32_t *dirty, uint32_t size)
+{
+	const uint32_t end = std::min(dirty[1], size);
+	if (dirty[0] < end)
+		memcpy(&dst[dirty[0]], &src[dirty[0]], (end - dirty[0]) * sizeof(uint32_t));
+
+	dirty[0] = ~0;
+	dirty[1] = 0;
+}
+
 void model3_state::real3d_display_list_end()
 {
+	/* the previous frame must be done with the textures and framebuffer */
+	real3d_geometry_sync();
+
 	/* upload textures if there are any in the FIFO */
 	if (m_texture_fifo_pos > 0)
 	{
@@ -1242,6 +1333,21 @@ void model3_state::real3d_display_list_end()
 	}
 	m_texture_fifo_pos = 0;
 
+	real3d_snapshot(m_display_list_snap.get(), m_display_list_ram.get(), m_display_list_dirty, 0x100000/4);
+	real3d_snapshot(m_culling_snap.get(), m_culling_ram.get(), m_culling_dirty, 0x400000/4);
+	real3d_snapshot(m_polygon_snap.get(), m_polygon_ram.get(), m_polygon_dirty, 0x400000/4);
+
+	if (m_geo_queue != nullptr)
+		m_geo_item = osd_work_item_queue(m_geo_queue, real3d_geometry_callback, this, 0);
+	if (m_geo_item == nullptr)
+	{
+		real3d_render_frame();
+		real3d_geometry_sync();
+	}
+}
+
+void model3_state::real3d_render_frame()
+{
 	m_renderer->clear_fb();
 
 	reset_triangle_buffers();
@@ -1277,6 +1383,7 @@ void model3_state::real3d_display_list1_dma(uint32_t src, uint32_t dst, int leng
 {
 	address_space &space = m_maincpu->space(AS_PROGRAM);
 	int d = (dst & 0xffffff) / 4;
+	real3d_mark_dirty(m_display_list_dirty, d, (length + 3) / 4);
 	for (int i = 0; i < length; i += 4)
 	{
 		uint32_t w = space.read_dword(src);
@@ -1293,6 +1400,7 @@ void model3_state::real3d_display_list2_dma(uint32_t src, uint32_t dst, int leng
 {
 	address_space &space = m_maincpu->space(AS_PROGRAM);
 	int d = (dst & 0xffffff) / 4;
+	real3d_mark_dirty(m_culling_dirty, d, (length + 3) / 4);
 	for (int i = 0; i < length; i += 4)
 	{
 		uint32_t w = space.read_dword(src);
@@ -1308,6 +1416,7 @@ void model3_state::real3d_display_list2_dma(uint32_t src, uint32_t dst, int leng
 void model3_state::real3d_vrom_texture_dma(uint32_t src, uint32_t dst, int length, int byteswap)
 {
 	address_space &space = m_maincpu->space(AS_PROGRAM);
+	real3d_geometry_sync();
 	if ((dst & 0xff) == 0)
 	{
 		for (int i=0; i < length; i+=12)
@@ -1346,6 +1455,7 @@ void model3_state::real3d_polygon_ram_dma(uint32_t src, uint32_t dst, int length
 {
 	address_space &space = m_maincpu->space(AS_PROGRAM);
 	int d = (dst & 0xffffff) / 4;
+	real3d_mark_dirty(m_polygon_dirty, d, (length + 3) / 4);
 	for (int i = 0; i < length; i += 4)
 	{
 		uint32_t w = space.read_dword(src);
@@ -1526,7 +1636,7 @@ m3_triangle *model3_state::push_triangle(bool alpha)
 void model3_state::draw_model(uint32_t addr)
 {
 	// Polygon RAM is mapped to the low 4MB of VROM
-	uint32_t *model = (addr >= 0x100000) ? &m_vrom[addr] :  &m_polygon_ram[addr];
+	uint32_t *model = (addr >= 0x100000) ? &m_vrom[addr] :  &m_polygon_snap[addr];
 
 	uint32_t header[7];
 	int index = 0;
@@ -1633,7 +1743,7 @@ void model3_state::draw_model(uint32_t addr)
 		else
 		{
 			int ci = (header[4] >> 8) & 0x7ff;
-			color = m_polygon_ram[0x400 + ci];
+			color = m_polygon_snap[0x400 + ci];
 		}
 
 		polygon_transparency =  (header[6] & 0x800000) ? 32 : ((header[6] >> 18) & 0x1f);
@@ -1810,14 +1920,14 @@ uint32_t *model3_state::get_memory_pointer(uint32_t address)
 		if (address >= 0x840000) {
 			fatalerror("get_memory_pointer: invalid display list memory address %08X\n", address);
 		}
-		return &m_display_list_ram[address & 0x7fffff];
+		return &m_display_list_snap[address & 0x7fffff];
 	}
 	else
 	{
 		if (address >= 0x100000) {
 			fatalerror("get_memory_pointer: invalid node ram address %08X\n", address);
 		}
-		return &m_culling_ram[address];
+		return &m_culling_snap[address];
 	}
 }
 
@@ -1895,7 +2005,7 @@ inline void model3_state::process_link(uint32_t address, uint32_t link)
 				break;
 
 			default:
-				logerror("process_link %08X: link = %08X\n", address, link);
+				m_geo_bad_links.emplace_back(address, link);
 				break;
 		}
 	}
@@ -2050,6 +2050,7 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 	bool new_object = true;
 	rdp_poly_state* object = nullptr;
 	bool valid = false;
+	const uint32_t* texels[TEXCACHE_FORMATS] = { nullptr };
 
 	int32_t* minx = flip ? &minxhx : &minxmx;
 	int32_t* maxx = flip ? &maxxmx : &maxxhx;
@@ -2104,6 +2105,10 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 				{
 					object = &object_data_alloc();
 					memcpy(object->m_tmem, m_tmem.get(), 0x1000);
+					if (texture)
+					{
+						cache_texels(texels, tilenum);
+					}
 					new_object = false;
 				}
 
@@ -2118,6 +2123,7 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 
 				rdp_span_aux* userdata = (rdp_span_aux*)spans[spanidx].userdata;
 				userdata->m_tmem = object->m_tmem;
+				memcpy(userdata->m_texels, texels, sizeof(texels));
 
 				userdata->m_blend_color = m_blend_color;
 				userdata->m_prim_color = m_prim_color;
@@ -2202,6 +2208,66 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 
 /*****************************************************************************/
 
+// Look up pre-decoded ARGB copies of TMEM for the layouts the polygon's tiles use.  Decoding
+// TMEM once per upload and sharing it between every polygon drawn from it replaces the TLUT
+// lookup and the 256KB 16-to-32 expansion table on each texel fetch with a read from an 8KB
+// array.  Only the texels of TMEM pages loaded since the last decode are redone, unless the
+// TLUT was loaded too.  render_spans waits for the polygon to finish, so the arrays can't be
+// re-decoded while a polygon still reads them.
+void n64_rdp::cache_texels(const uint32_t** texels, int32_t tilenum)
+{
+	// the primitive tile and the next one in two-cycle mode, or up to the finest detail
+	// and the mip levels below it with LOD
+	const int32_t tiles = m_other_modes.tex_lod_en ? std::min<int32_t>(m_misc_state.m_max_level + 3, 8) : 2;
+
+	for (int32_t i = 0; i < tiles; i++)
+	{
+		const n64_tile_t& tile = m_tiles[(tilenum + i) & 7];
+		const uint32_t index = (tile.format << 4) | (tile.size << 2) | ((uint32_t) m_other_modes.en_tlut << 1) | (uint32_t) m_other_modes.tlut_type;
+
+		int32_t format;
+		int texel_shift;
+		texture_cache::range data = { 0, 0x1000 };
+		texture_cache::range pal = { 0, 0 };
+		switch (index)
+		{
+			case 8: case 9: format = TEXCACHE_RGBA16;       texel_shift = 1; break;
+			case 10:        format = TEXCACHE_RGBA16_TLUT0; texel_shift = 1; pal = { 0x800, 0x800 }; break;
+			case 38:        format = TEXCACHE_CI8_TLUT0;    texel_shift = 0; data.length = 0x800; pal = { 0x800, 0x800 }; break;
+			default:        continue;
+		}
+
+		if (texels[format] == nullptr)
+		{
+			texels[format] = m_tex_cache.get_pages(0, format, 0, 0x800, data, pal, texel_shift, [this, format] (uint32_t* dest, uint32_t first, uint32_t count) { m_tex_pipe.decode_tmem(dest, format, m_tmem.get(), first, count); });
+		}
+	}
+}
+
+// Tell the texture cache about a load into TMEM, given as a byte range that may run past the
+// end and wrap around, as the loads' TMEM addresses do.
+void n64_rdp::invalidate_tmem(int32_t start, int32_t length)
+{
+	if (length <= 0)
+	{
+		return;
+	}
+	if (length >= 0x1000)
+	{
+		m_tex_cache.invalidate(0, 0x1000);
+		return;
+	}
+
+	start &= 0xfff;
+	m_tex_cache.invalidate(start, length);
+	if (start + length > 0x1000)
+	{
+		m_tex_cache.invalidate(0, start + length - 0x1000);
+	}
+}
+
+/*****************************************************************************/
+
 ////////////////////////
 // RDP COMMANDS
 ////////////////////////
@@ -2505,6 +2571,7 @@ void n64_rdp::cmd_load_tlut(uint64_t w1)
 	}
 
 	m_capture.data_end();
+	m_tex_cache.invalidate(tile[tilenum].tmem << 3, ((count + 3) & ~3) << 1);
 
 	m_tiles[tilenum].sth = rgbaint_t(m_tiles[tilenum].sh, m_tiles[tilenum].sh, m_tiles[tilenum].th, m_tiles[tilenum].th);
 	m_tiles[tilenum].stl = rgbaint_t(m_tiles[tilenum].sl, m_tiles[tilenum].sl, m_tiles[tilenum].tl, m_tiles[tilenum].tl);
@@ -2561,6 +2628,9 @@ void n64_rdp::cmd_load_block(uint64_t w1)
 
 	m_capture.data_begin();
 
+	// 64-bit words written, including those skipped over for odd lines
+	int32_t loaded = width;
+
 	if (dxt != 0)
 	{
 		int32_t j = 0;
@@ -2653,6 +2723,7 @@ void n64_rdp::cmd_load_block(uint64_t w1)
 			}
 		}
 		tile[tilenum].th = tl + (j >> 11);
+		loaded = width + tile[tilenum].line;
 	}
 	else
 	{
@@ -2720,6 +2791,16 @@ void n64_rdp::cmd_load_block(uint64_t w1)
 
 	m_capture.data_end();
 
+	// 32-bit and YUV loads split texels across both halves of TMEM
+	if (tile[tilenum].size != PIXEL_SIZE_32BIT && tile[tilenum].format != FORMAT_YUV)
+	{
+		invalidate_tmem(tb << 1, loaded << 3);
+	}
+	else
+	{
+		m_tex_cache.invalidate(0, 0x1000);
+	}
+
 	m_tiles[tilenum].sth = rgbaint_t(m_tiles[tilenum].sh, m_tiles[tilenum].sh, m_tiles[tilenum].th, m_tiles[tilenum].th);
 	m_tiles[tilenum].stl = rgbaint_t(m_tiles[tilenum].sl, m_tiles[tilenum].sl, m_tiles[tilenum].tl, m_tiles[tilenum].tl);
 }
@@ -2757,6 +2838,9 @@ void n64_rdp::cmd_load_tile(uint64_t w1)
 
 	m_capture.data_begin();
 
+	// TMEM bytes written from the tile's first line, or 0 for every byte
+	int32_t loaded = 0;
+
 	switch (m_misc_state.m_ti_size)
 	{
 		case PIXEL_SIZE_8BIT:
@@ -2778,6 +2862,7 @@ void n64_rdp::cmd_load_tile(uint64_t w1)
 					tc[((tline + i) ^ xorval8) & 0xfff] = data;
 				}
 			}
+			loaded = (((tile[tilenum].line << 3) * (height - 1)) + width + 7) & ~7;
 			break;
 		}
 		case PIXEL_SIZE_16BIT:
@@ -2802,6 +2887,7 @@ void n64_rdp::cmd_load_tile(uint64_t w1)
 						tc[taddr & 0x7ff] = data;
 					}
 				}
+				loaded = ((((tile[tilenum].line << 2) * (height - 1)) + width + 3) & ~3) << 1;
 			}
 			else
 			{
@@ -2853,6 +2939,16 @@ void n64_rdp::cmd_load_tile(uint64_t w1)
 
 	m_capture.data_end();
 
+	// YUV and 32-bit loads split texels across both halves of TMEM
+	if (loaded != 0)
+	{
+		invalidate_tmem(tile[tilenum].tmem << 3, loaded);
+	}
+	else
+	{
+		m_tex_cache.invalidate(0, 0x1000);
+	}
+
 	m_tiles[tilenum].sth = rgbaint_t(m_tiles[tilenum].sh, m_tiles[tilenum].sh, m_tiles[tilenum].th, m_tiles[tilenum].th);
 	m_tiles[tilenum].stl = rgbaint_t(m_tiles[tilenum].sl, m_tiles[tilenum].sl, m_tiles[tilenum].tl, m_tiles[tilenum].tl);
 }
@@ -3142,7 +3238,7 @@ void n64_rdp::process_command_list()
 
 /*****************************************************************************/
 
-n64_rdp::n64_rdp(n64_state &state, uint32_t* rdram, uint32_t* dmem) : poly_manager<uint32_t, rdp_poly_state, 8, 32000>(state.machine())
+n64_rdp::n64_rdp(n64_state &state, uint32_t* rdram, uint32_t* dmem) : poly_manager<uint32_t, rdp_poly_state, 8, 32000>(state.machine()), m_tex_cache(0x1000, 8, TEXCACHE_FORMATS)
 {
 	ignore = false;
 	dolog = false;
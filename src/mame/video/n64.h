@@ -127,6 +127,7 @@ class n64_rdp;
 #include "video/n64types.h"
 #include "video/rdpblend.h"
 #include "video/rdptpipe.h"
+#include "video/texcache.h"
 
 typedef void (*rdp_command_t)(uint64_t w1);
 
@@ -215,6 +216,8 @@ public:
 	void            tc_div_no_perspective(int32_t ss, int32_t st, int32_t sw, int32_t* sss, int32_t* sst);
 	uint32_t          get_log2(uint32_t lod_clamp);
 	void            render_spans(int32_t start, int32_t end, int32_t tilenum, bool flip, extent_t* spans, bool rect, rdp_poly_state* object);
+	void            cache_texels(const uint32_t** texels, int32_t tilenum);
+	void            invalidate_tmem(int32_t start, int32_t length);
 	int32_t           get_alpha_cvg(int32_t comb_alpha, rdp_span_aux* userdata, const rdp_poly_state &object);
 
 	void            z_store(const rdp_poly_state &object, uint32_t zcurpixel, uint32_t dzcurpixel, uint32_t z, uint32_t enc);
@@ -360,6 +363,7 @@ private:
 	uint32_t  m_status;
 
 	std::unique_ptr<uint8_t[]>  m_tmem;
+	texture_cache               m_tex_cache;    // TMEM pre-decoded to ARGB, see cache_texels
 
 	// YUV factors
 	color_t m_k023;
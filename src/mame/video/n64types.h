@@ -260,6 +260,15 @@ struct rdp_poly_state
 
 #define RDP_CVG_SPAN_MAX            (1024)
 
+// TMEM layouts the RDP keeps pre-decoded to ARGB in its texture cache
+enum
+{
+	TEXCACHE_RGBA16 = 0,
+	TEXCACHE_RGBA16_TLUT0,
+	TEXCACHE_CI8_TLUT0,
+	TEXCACHE_FORMATS
+};
+
 // This is enormous and horrible
 struct rdp_span_aux
 {
@@ -304,6 +313,7 @@ struct rdp_span_aux
 	bool                m_pre_wrap;
 	int32_t               m_dzpix_enc;
 	uint8_t*              m_tmem;                /* pointer to texture cache for this polygon */
+	const uint32_t*       m_texels[TEXCACHE_FORMATS]; /* pre-decoded TMEM per layout, or nullptr */
 	bool                m_start_span;
 	rgbaint_t           m_clamp_diff[8];
 };
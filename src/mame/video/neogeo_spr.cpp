@@ -19,6 +19,7 @@ neosprite_base_device::neosprite_base_device(
 		uint32_t clock)
 	: device_t(mconfig, type, tag, owner, clock)
 	, m_bppshift(4)
+	, m_sprite_cache(NEOGEO_VTOTAL)
 {
 }
 
@@ -67,6 +68,11 @@ void neosprite_base_device::device_reset()
 	start_auto_animation_timer();
 }
 
+void neosprite_base_device::device_post_load()
+{
+	m_sprite_cache.invalidate();
+}
+
 
 
 /*************************************
@@ -92,6 +98,10 @@ uint16_t neosprite_base_device::get_videoram_data()
 
 void neosprite_base_device::set_videoram_data(uint16_t data)
 {
+	/* SCB3 (Y position, height and chaining) decides the per-line sprite lists */
+	if ((m_vram_offset & 0xfe00) == 0x8200 && m_videoram[m_vram_offset] != data)
+		m_sprite_cache.invalidate();
+
 	m_videoram[m_vram_offset] = data;
 
 	/* auto increment/decrement the current offset - A15 is NOT affected */
@@ -268,39 +278,7 @@ inline void neosprite_base_device::draw_fixed_layer_2pixels(uint32_t*&pixel_addr
  *
  *************************************/
 
-#define MAX_SPRITES_PER_SCREEN    (381)
-#define MAX_SPRITES_PER_LINE      (96)
-
-
-/* horizontal zoom table - verified on real hardware */
-static const int zoom_x_tables[][16] =
-{
-	{ 0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0 },
-	{ 0,0,0,0,1,0,0,0,1,0,0,0,0,0,0,0 },
-	{ 0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0 },
-	{ 0,0,1,0,1,0,0,0,1,0,0,0,1,0,0,0 },
-	{ 0,0,1,0,1,0,0,0,1,0,0,0,1,0,1,0 },
-	{ 0,0,1,0,1,0,1,0,1,0,0,0,1,0,1,0 },
-	{ 0,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0 },
-	{ 1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0 },
-	{ 1,0,1,0,1,0,1,0,1,1,1,0,1,0,1,0 },
-	{ 1,0,1,1,1,0,1,0,1,1,1,0,1,0,1,0 },
-	{ 1,0,1,1,1,0,1,0,1,1,1,0,1,0,1,1 },
-	{ 1,0,1,1,1,0,1,1,1,1,1,0,1,0,1,1 },
-	{ 1,0,1,1,1,0,1,1,1,1,1,0,1,1,1,1 },
-	{ 1,1,1,1,1,0,1,1,1,1,1,0,1,1,1,1 },
-	{ 1,1,1,1,1,0,1,1,1,1,1,1,1,1,1,1 },
-	{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 }
-};
-
-
-
-inline bool neosprite_base_device::sprite_on_scanline(int scanline, int y, int rows)
-{
-	return (rows == 0) || (rows >= 0x20) || ((scanline - y) & 0x1ff) < (rows * 0x10);
-}
-
-
+#define MAX_SPRITES_PER_LINE      (neogeo_sprite_cache::SPRITES_PER_LINE)
 
 
 void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
@@ -364,7 +342,7 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 
 		/* double check the Y coordinate, in case somebody modified the sprite coordinate
 		   since we buffered it */
-		if (sprite_on_scanline(scanline, y, rows))
+		if (neogeo_sprite_cache::sprite_on_scanline(scanline, y, rows))
 		{
 			int sprite_y;
 			int tile;
@@ -372,9 +350,7 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 			offs_t attr_and_code_offs;
 			uint16_t attr;
 			uint32_t code;
-			const int *zoom_x_table;
 			const pen_t *line_pens;
-			int x_inc;
 
 			int sprite_line = (scanline - y) & 0x1ff;
 			int zoom_line = sprite_line & 0xff;
@@ -422,8 +398,6 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 			if (attr & 0x0002)
 				sprite_y ^= 0x0f;
 
-			zoom_x_table = zoom_x_tables[zoom_x];
-
 			/* compute offset in gfx ROM and mask it to the number of bits available */
 			int gfx_base = ((code << 8) | (sprite_y << 4)) & m_sprite_gfx_address_mask;
 
@@ -431,63 +405,8 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 			line_pens = &m_pens[attr >> 8 << m_bppshift];
 
 
-			/* horizontal flip? */
-			if (attr & 0x0001)
-			{
-				gfx_base = gfx_base + 0x0f;
-				x_inc = -1;
-			}
-			else
-				x_inc = 1;
-
-			/* draw the line - no wrap-around */
-			if (x <= 0x01f0)
-			{
-				int i;
-
-				uint32_t *pixel_addr = &bitmap.pix32(scanline, x + NEOGEO_HBEND);
-
-				for (i = 0; i < 0x10; i++)
-				{
-					if (*zoom_x_table)
-					{
-						draw_pixel(gfx_base, pixel_addr, line_pens);
-
-						pixel_addr++;
-					}
-
-					zoom_x_table++;
-					gfx_base += x_inc;
-				}
-			}
-			/* wrap-around */
-			else
-			{
-				int i;
-
-				int x_save = x;
-				uint32_t *pixel_addr = &bitmap.pix32(scanline, NEOGEO_HBEND);
-
-				for (i = 0; i < 0x10; i++)
-				{
-					if (*zoom_x_table)
-					{
-						if (x >= 0x200)
-						{
-							draw_pixel(gfx_base, pixel_addr, line_pens);
-
-							pixel_addr++;
-						}
-
-						x++;
-					}
-
-					zoom_x_table++;
-					gfx_base += x_inc;
-				}
-
-				x = x_save;
-			}
+			/* the zoom table skips the pixels that aren't shown; X positions 0x1f1-0x1ff wrap around to the left edge */
+			draw_sprite_line(&bitmap.pix32(scanline, NEOGEO_HBEND), x, zoom_x, gfx_base, attr & 0x0001, line_pens);
 		}
 	}
 }
@@ -495,52 +414,16 @@ void neosprite_base_device::draw_sprites(bitmap_rgb32 &bitmap, int scanline)
 
 void neosprite_base_device::parse_sprites(int scanline)
 {
-	uint16_t sprite_number;
-	int y = 0;
-	int rows = 0;
 	uint16_t *sprite_list;
 
-	int active_sprite_count = 0;
-
 	/* select the active list */
 	if (scanline & 0x01)
 		sprite_list = &m_videoram_drawsource[0x8680];
 	else
 		sprite_list = &m_videoram_drawsource[0x8600];
 
-	/* scan all sprites */
-	for (sprite_number = 0; sprite_number < MAX_SPRITES_PER_SCREEN; sprite_number++)
-	{
-		uint16_t y_control = m_videoram_drawsource[0x8200 | sprite_number];
-
-		/* if not chained, get Y position and height, otherwise use previous values */
-		if (~y_control & 0x40)
-		{
-			y = 0x200 - (y_control >> 7);
-			rows = y_control & 0x3f;
-		}
-
-		/* skip sprites with 0 rows */
-		if (rows == 0)
-			continue;
-
-		if (!sprite_on_scanline(scanline, y, rows))
-			continue;
-
-		/* sprite is on this scanline, add it to active list */
-		*sprite_list = sprite_number;
-
-		sprite_list++;
-
-		/* increment sprite count, and if we reached the max, bail out */
-		active_sprite_count++;
-
-		if (active_sprite_count == MAX_SPRITES_PER_LINE)
-			break;
-	}
-
-	/* fill the rest of the sprite list with 0, including one extra entry */
-	memset(sprite_list, 0, sizeof(sprite_list[0]) * (MAX_SPRITES_PER_LINE - active_sprite_count + 1));
+	/* scan all sprites, or reuse the list built for this line if SCB3 hasn't changed since */
+	m_sprite_cache.build_list(&m_videoram_drawsource[0x8200], scanline, sprite_list);
 }
 
 
@@ -685,6 +568,11 @@ inline void neosprite_regular_device::draw_pixel(int romaddr, uint32_t* dst, con
 		*dst = line_pens[gfx];
 }
 
+void neosprite_regular_device::draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens)
+{
+	m_sprite_cache.draw_line(row, x, zoom_x, gfx_base, flip, [this, line_pens] (int romaddr, uint32_t *dst) { neosprite_regular_device::draw_pixel(romaddr, dst, line_pens); });
+}
+
 
 
 /*********************************************************************************************************************************/
@@ -762,12 +650,18 @@ inline void neosprite_optimized_device::draw_pixel(int romaddr, uint32_t* dst, c
 		*dst = line_pens[gfx];
 }
 
+void neosprite_optimized_device::draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens)
+{
+	m_sprite_cache.draw_line(row, x, zoom_x, gfx_base, flip, [this, line_pens] (int romaddr, uint32_t *dst) { neosprite_optimized_device::draw_pixel(romaddr, dst, line_pens); });
+}
+
 
 /*********************************************************************************************************************************/
 /* MIDAS specific sprite handling                                                                                                */
 /*                                                                                                                               */
 /* this is used by the midas.c hardware which is a reengineered NeoGeo, it has 8bbp tiles instead of 4bpp tiles                  */
 /* and uploads the zoom table.  The additional videoram buffering is a guess because 'hammer' is very glitchy without it         */
+/* the planar tiles are expanded to one byte per pixel when the region is set, like the optimized NeoGeo device does             */
 /*********************************************************************************************************************************/
 
 DEFINE_DEVICE_TYPE(NEOGEO_SPRITE_MIDAS, neosprite_midas_device, "midassprite", "MIDAS Sprites")
@@ -782,22 +676,17 @@ neosprite_midas_device::neosprite_midas_device(const machine_config &mconfig, co
 
 inline void neosprite_midas_device::draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens)
 {
-	const uint8_t* src = m_region_sprites + (((romaddr &~0xff)) | (((romaddr&0x8)^0x8)<<4) | ((romaddr & 0xf0)  >> 1));
-	const int x = romaddr & 0x7;
-
-	const uint8_t gfx =   (((src[0x7] >> x) & 0x01) << 7) |
-						(((src[0x6] >> x) & 0x01) << 6) |
-						(((src[0x5] >> x) & 0x01) << 5) |
-						(((src[0x4] >> x) & 0x01) << 4) |
-						(((src[0x3] >> x) & 0x01) << 3) |
-						(((src[0x2] >> x) & 0x01) << 2) |
-						(((src[0x1] >> x) & 0x01) << 1) |
-						(((src[0x0] >> x) & 0x01) << 0);
+	const uint8_t gfx = m_sprite_gfx[romaddr];
 
 	if (gfx)
 		*dst = line_pens[gfx];
 }
 
+void neosprite_midas_device::draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens)
+{
+	m_sprite_cache.draw_line(row, x, zoom_x, gfx_base, flip, [this, line_pens] (int romaddr, uint32_t *dst) { neosprite_midas_device::draw_pixel(romaddr, dst, line_pens); });
+}
+
 
 void neosprite_midas_device::device_start()
 {
@@ -812,6 +701,10 @@ void neosprite_midas_device::device_start()
 
 void neosprite_midas_device::buffer_vram()
 {
+	/* the sprite lists are built from the buffer, so only a change to its SCB3 matters */
+	if (memcmp(&m_videoram_buffer[0x8200], &m_videoram[0x8200], 0x200 * sizeof(uint16_t)) != 0)
+		m_sprite_cache.invalidate();
+
 	memcpy(m_videoram_buffer.get(), m_videoram.get(), (0x8000 + 0x800) * sizeof(uint16_t));
 }
 
@@ -836,4 +729,25 @@ void neosprite_midas_device::set_sprite_region(uint8_t* region_sprites, uint32_t
 	m_region_sprites_size = region_sprites_size;
 	uint32_t mask = get_region_mask(m_region_sprites, m_region_sprites_size);
 	m_sprite_gfx_address_mask = mask;
+
+	// expand the 8 bitplanes to one byte per pixel; addresses past the end of the region draw nothing
+	m_sprite_gfx.assign(mask + 1, 0);
+	for (uint32_t tile = 0; tile + 0x100 <= region_sprites_size && tile <= mask; tile += 0x100)
+	{
+		for (int romaddr = 0; romaddr < 0x100; romaddr++)
+		{
+			const uint8_t* src = m_region_sprites + (tile | (((romaddr&0x8)^0x8)<<4) | ((romaddr & 0xf0)  >> 1));
+			const int x = romaddr & 0x7;
+
+			m_sprite_gfx[tile | romaddr] =
+					(((src[0x7] >> x) & 0x01) << 7) |
+					(((src[0x6] >> x) & 0x01) << 6) |
+					(((src[0x5] >> x) & 0x01) << 5) |
+					(((src[0x4] >> x) & 0x01) << 4) |
+					(((src[0x3] >> x) & 0x01) << 3) |
+					(((src[0x2] >> x) & 0x01) << 2) |
+					(((src[0x1] >> x) & 0x01) << 1) |
+					(((src[0x0] >> x) & 0x01) << 0);
+		}
+	}
 }
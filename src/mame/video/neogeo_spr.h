@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "neogeo_sprcache.h"
+
 // todo, move these back, currently the sprite code needs some of the values tho
 #define NEOGEO_MASTER_CLOCK                     (24000000)
 #define NEOGEO_MAIN_CPU_CLOCK                   (NEOGEO_MASTER_CLOCK / 2)
@@ -40,8 +42,8 @@ public:
 	void create_auto_animation_timer();
 	void start_auto_animation_timer();
 	void neogeo_set_fixed_layer_source(uint8_t data);
-	inline bool sprite_on_scanline(int scanline, int y, int rows);
 	virtual void draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens) = 0;
+	virtual void draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens) = 0;
 	void draw_sprites(bitmap_rgb32 &bitmap, int scanline);
 	void parse_sprites(int scanline);
 	void create_sprite_line_timer();
@@ -89,12 +91,14 @@ protected:
 
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 	uint32_t get_region_mask(uint8_t* rgn, uint32_t rgn_size);
 	uint8_t* m_region_sprites; uint32_t m_region_sprites_size;
 	uint8_t* m_region_fixed; uint32_t m_region_fixed_size;
 	memory_region* m_region_fixedbios;
 	screen_device* m_screen;
 	const pen_t   *m_pens;
+	neogeo_sprite_cache m_sprite_cache;
 };
 
 
@@ -103,6 +107,7 @@ class neosprite_regular_device : public neosprite_base_device
 public:
 	neosprite_regular_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 	virtual void draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens) override;
+	virtual void draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens) override;
 	virtual void set_sprite_region(uint8_t* region_sprites, uint32_t region_sprites_size) override;
 
 };
@@ -117,6 +122,7 @@ public:
 	virtual void optimize_sprite_data() override;
 	virtual void set_optimized_sprite_data(uint8_t* sprdata, uint32_t mask) override;
 	virtual void draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens) override;
+	virtual void draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens) override;
 	std::vector<uint8_t> m_sprite_gfx;
 	uint8_t* m_spritegfx8;
 
@@ -133,8 +139,10 @@ public:
 	neosprite_midas_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 
 	virtual void draw_pixel(int romaddr, uint32_t* dst, const pen_t *line_pens) override;
+	virtual void draw_sprite_line(uint32_t* row, int x, int zoom_x, int gfx_base, bool flip, const pen_t *line_pens) override;
 
 	std::unique_ptr<uint16_t[]> m_videoram_buffer;
+	std::vector<uint8_t> m_sprite_gfx;
 	void buffer_vram();
 	virtual void draw_fixed_layer_2pixels(uint32_t*&pixel_addr, int offset, uint8_t* gfx_base, const pen_t* char_pens) override;
 	virtual void set_sprite_region(uint8_t* region_sprites, uint32_t region_sprites_size) override;
@@ -0,0 +1,132 @@
+// license:BSD-3-Clause
+// copyright-holders:Bryan McPhail,Ernesto Corvi,Andrew Prime,Zsolt Vasvari
+/***************************************************************************
+
+    neogeo_sprcache.cpp
+
+    Per-scanline sprite list and horizontal zoom caches for the NeoGeo
+    sprite generator.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "neogeo_sprcache.h"
+
+
+/* horizontal zoom table - verified on real hardware */
+const int neogeo_sprite_cache::zoom_x_tables[16][16] =
+{
+	{ 0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,0 },
+	{ 0,0,0,0,1,0,0,0,1,0,0,0,0,0,0,0 },
+	{ 0,0,0,0,1,0,0,0,1,0,0,0,1,0,0,0 },
+	{ 0,0,1,0,1,0,0,0,1,0,0,0,1,0,0,0 },
+	{ 0,0,1,0,1,0,0,0,1,0,0,0,1,0,1,0 },
+	{ 0,0,1,0,1,0,1,0,1,0,0,0,1,0,1,0 },
+	{ 0,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0 },
+	{ 1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0 },
+	{ 1,0,1,0,1,0,1,0,1,1,1,0,1,0,1,0 },
+	{ 1,0,1,1,1,0,1,0,1,1,1,0,1,0,1,0 },
+	{ 1,0,1,1,1,0,1,0,1,1,1,0,1,0,1,1 },
+	{ 1,0,1,1,1,0,1,1,1,1,1,0,1,0,1,1 },
+	{ 1,0,1,1,1,0,1,1,1,1,1,0,1,1,1,1 },
+	{ 1,1,1,1,1,0,1,1,1,1,1,0,1,1,1,1 },
+	{ 1,1,1,1,1,0,1,1,1,1,1,1,1,1,1,1 },
+	{ 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1 }
+};
+
+
+//-------------------------------------------------
+//  neogeo_sprite_cache - constructor
+//-------------------------------------------------
+
+neogeo_sprite_cache::neogeo_sprite_cache(int lines)
+	: m_lists(lines * LIST_LENGTH, 0)
+	, m_list_serial(lines, 0)
+	, m_block_serial(0)
+	, m_serial(1)
+{
+	for (int zoom = 0; zoom < 16; zoom++)
+	{
+		zoom_row &row = m_zoom_x[zoom];
+		row.count = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			if (zoom_x_tables[zoom][i])
+			{
+				row.offset[0][row.count] = i;
+				row.offset[1][row.count] = 0x0f - i;
+				row.count++;
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  resolve_blocks - work out the Y position and
+//  height of every sprite, following chains
+//-------------------------------------------------
+
+void neogeo_sprite_cache::resolve_blocks(const u16 *scb3)
+{
+	int y = 0;
+	int rows = 0;
+
+	for (int sprite_number = 0; sprite_number < SPRITES_PER_SCREEN; sprite_number++)
+	{
+		u16 const y_control = scb3[sprite_number];
+
+		/* if not chained, get Y position and height, otherwise use previous values */
+		if (~y_control & 0x40)
+		{
+			y = 0x200 - (y_control >> 7);
+			rows = y_control & 0x3f;
+		}
+
+		m_block_y[sprite_number] = y;
+		m_block_rows[sprite_number] = rows;
+	}
+
+	m_block_serial = m_serial;
+}
+
+
+//-------------------------------------------------
+//  build_list - write the active sprite list for
+//  a line, rebuilding it only if SCB3 changed
+//  since it was last built
+//-------------------------------------------------
+
+void neogeo_sprite_cache::build_list(const u16 *scb3, int scanline, u16 *dest)
+{
+	u16 *const list = &m_lists[scanline * LIST_LENGTH];
+
+	if (m_list_serial[scanline] != m_serial)
+	{
+		if (m_block_serial != m_serial)
+			resolve_blocks(scb3);
+
+		int active_sprite_count = 0;
+		for (int sprite_number = 0; sprite_number < SPRITES_PER_SCREEN; sprite_number++)
+		{
+			int const rows = m_block_rows[sprite_number];
+
+			/* skip sprites with 0 rows */
+			if (rows == 0)
+				continue;
+
+			if (!sprite_on_scanline(scanline, m_block_y[sprite_number], rows))
+				continue;
+
+			list[active_sprite_count++] = sprite_number;
+			if (active_sprite_count == SPRITES_PER_LINE)
+				break;
+		}
+
+		/* fill the rest of the sprite list with 0, including one extra entry */
+		std::fill(list + active_sprite_count, list + LIST_LENGTH, 0);
+		m_list_serial[scanline] = m_serial;
+	}
+
+	std::copy(list, list + LIST_LENGTH, dest);
+}
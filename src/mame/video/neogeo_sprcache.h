@@ -0,0 +1,96 @@
+// license:BSD-3-Clause
+// copyright-holders:Bryan McPhail,Ernesto Corvi,Andrew Prime,Zsolt Vasvari
+/***************************************************************************
+
+    neogeo_sprcache.h
+
+    Per-scanline sprite list and horizontal zoom caches for the NeoGeo
+    sprite generator.
+
+    The hardware builds the list of sprites to draw on a line by scanning
+    all of SCB3 (Y position, height and chaining) on every line, and most
+    games only touch SCB3 a few times per frame.  The cache resolves the
+    chained Y/height of every sprite once per SCB3 change and keeps the
+    list built for each line, so a line whose list is still current is a
+    copy instead of a 381 sprite scan.  The owner calls invalidate() on
+    every SCB3 write that changes a value.
+
+    Horizontal zoom is kept as the list of source pixel offsets drawn at
+    each zoom level, so a sprite line only visits the pixels it draws.
+
+***************************************************************************/
+
+#ifndef MAME_VIDEO_NEOGEO_SPRCACHE_H
+#define MAME_VIDEO_NEOGEO_SPRCACHE_H
+
+#pragma once
+
+#include <vector>
+
+
+class neogeo_sprite_cache
+{
+public:
+	static constexpr int SPRITES_PER_SCREEN = 381;
+	static constexpr int SPRITES_PER_LINE = 96;
+
+	// one list per line: the active sprites followed by at least one 0
+	static constexpr int LIST_LENGTH = SPRITES_PER_LINE + 1;
+
+	// construction
+	neogeo_sprite_cache(int lines);
+
+	// SCB3 write tracking
+	void invalidate() { m_serial++; }
+
+	// write the active sprite list for a line to dest (LIST_LENGTH words)
+	void build_list(const u16 *scb3, int scanline, u16 *dest);
+
+	// draw one 16 pixel sprite line at hardware X position x, calling
+	// pixel(romaddr, dst) for each pixel shown; row points at the first
+	// visible pixel of the line and X positions 0x1f1-0x1ff wrap to its
+	// left edge
+	template <typename Pixel>
+	void draw_line(u32 *row, int x, int zoom_x, int gfx_base, bool flip, Pixel &&pixel) const
+	{
+		const zoom_row &zoom = m_zoom_x[zoom_x];
+		const u8 *const offset = zoom.offset[flip ? 1 : 0];
+		int first = 0;
+
+		if (x > 0x1f0)
+		{
+			first = 0x200 - x;
+			x = 0;
+		}
+
+		u32 *dst = row + x;
+		for (int i = first; i < zoom.count; i++)
+			pixel(gfx_base + offset[i], dst++);
+	}
+
+	static bool sprite_on_scanline(int scanline, int y, int rows)
+	{
+		return (rows == 0) || (rows >= 0x20) || ((scanline - y) & 0x1ff) < (rows * 0x10);
+	}
+
+	static const int zoom_x_tables[16][16];
+
+private:
+	struct zoom_row
+	{
+		u8 count;               // pixels shown
+		u8 offset[2][16];       // source offsets, normal and flipped
+	};
+
+	void resolve_blocks(const u16 *scb3);
+
+	zoom_row m_zoom_x[16];
+	std::vector<u16> m_lists;               // cached lists, LIST_LENGTH per line
+	std::vector<u32> m_list_serial;         // SCB3 serial each list was built at
+	s16 m_block_y[SPRITES_PER_SCREEN];      // chained Y position of each sprite
+	u8 m_block_rows[SPRITES_PER_SCREEN];    // chained height of each sprite
+	u32 m_block_serial;                     // SCB3 serial the above were resolved at
+	u32 m_serial;                           // bumped on every SCB3 change
+};
+
+#endif // MAME_VIDEO_NEOGEO_SPRCACHE_H
@@ -626,6 +626,80 @@ uint32_t powervr2_device::tex_r_default(texinfo *t, float x, float y)
 	return ((int)x ^ (int)y) & 4 ? 0xffffff00 : 0xff0000ff;
 }
 
+uint32_t powervr2_device::tex_r_cached(texinfo *t, float x, float y)
+{
+	int xt = t->u_func(x, t->sizex);
+	int yt = t->v_func(y, t->sizey);
+	return t->texels[yt * t->sizex + xt];
+}
+
+// hash the texture RAM and palette entries a texture depends on, so that
+// cached decodes get thrown away when the game uploads new texel data
+uint64_t powervr2_device::texcache_fingerprint(const texinfo *t) const
+{
+	uint32_t start, end;
+	if(t->mode & 2) {
+		// codebook followed by one index byte per 2x2 block
+		start = t->vqbase;
+		end = t->address + ((t->sizex * t->sizey) >> 2);
+	} else {
+		int bits = (t->pf == 5) ? 4 : (t->pf == 6) ? 8 : 16;
+		start = t->address;
+		end = t->address + ((((t->mode & 1) ? t->stride : t->sizex) * t->sizey * bits) >> 3);
+	}
+	start &= ~7;
+	end = std::min((end + 7) & ~7, dc_texture_ram_size);
+
+	uint64_t hash = 0xcbf29ce484222325U ^ (uint64_t(t->sizes) << 32) ^ uint64_t(t->mode);
+	for(uint32_t offs = start; offs < end; offs += 8)
+		hash = (((hash << 5) | (hash >> 59)) ^ dc_texture_ram[offs >> 3]) * 0x100000001b3U;
+
+	if((t->pf == 5) || (t->pf == 6)) {
+		int count = (t->pf == 5) ? 16 : 256;
+		for(int i = 0; i < count; i++)
+			hash = (((hash << 5) | (hash >> 59)) ^ palette[t->palbase + i]) * 0x100000001b3U;
+	}
+	return hash;
+}
+
+// attach a decoded copy of the texture to the strip, decoding it again only
+// when its backing memory has changed since it was last used
+void powervr2_device::texcache_bind(texinfo *t)
+{
+	t->texels = nullptr;
+	if(!t->textured || t->r == &powervr2_device::tex_r_default)
+		return;
+
+	texcache_key key{ t->address, t->vqbase, t->stride, t->pf, t->mode, t->sizes, t->palbase };
+	texcache_entry &entry = texcache[key];
+
+	// a texture shared by several strips only needs checking once per render
+	if(entry.texels.empty() || entry.r != t->r || entry.last_used != texcache_frame) {
+		uint64_t fingerprint = texcache_fingerprint(t);
+		if(entry.texels.empty() || entry.r != t->r || entry.fingerprint != fingerprint) {
+			entry.r = t->r;
+			entry.fingerprint = fingerprint;
+			entry.texels.resize(t->sizex * t->sizey);
+			uint32_t *dest = &entry.texels[0];
+			for(int y = 0; y < t->sizey; y++)
+				for(int x = 0; x < t->sizex; x++)
+					*dest++ = (this->*(t->r))(t, x, y);
+		}
+	}
+	entry.last_used = texcache_frame;
+	t->texels = &entry.texels[0];
+}
+
+void powervr2_device::texcache_expire()
+{
+	for(auto it = texcache.begin(); it != texcache.end(); ) {
+		if(texcache_frame - it->second.last_used > TEXCACHE_MAX_AGE)
+			it = texcache.erase(it);
+		else
+			++it;
+	}
+}
+
 void powervr2_device::tex_get_info(texinfo *t)
 {
 	int miptype = 0;
@@ -683,6 +757,7 @@ void powervr2_device::tex_get_info(texinfo *t)
 	t->palbase = 0;
 	t->vqbase = t->address;
 	t->blend = use_alpha ? blend_functions[t->blend_mode] : bl10;
+	t->texels = nullptr;
 
 //  fprintf(stderr, "tex %d %d %d %d\n", t->pf, t->mode, pal_ram_ctrl, t->mipmapped);
 	if(!t->textured)
@@ -2225,22 +2300,24 @@ void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int y, flo
 	tdata = &bitmap.pix32(y, xxl);
 	wbufline = &wbuffer[y][xxl];
 
+	uint32_t (powervr2_device::*r)(texinfo *t, float x, float y) = ti->texels ? &powervr2_device::tex_r_cached : ti->r;
+
 	while(xxl < xxr) {
 		if((wl >= *wbufline)) {
 			uint32_t c;
 			float u = ul/wl;
 			float v = vl/wl;
 
-			c = (this->*(ti->r))(ti, u, v);
+			c = (this->*r)(ti, u, v);
 
 			// debug dip to turn on/off bilinear filtering, it's slooooow
 			if (debug_dip_status&0x1)
 			{
 				if(ti->filter_mode >= TEX_FILTER_BILINEAR)
 				{
-					uint32_t c1 = (this->*(ti->r))(ti, u+1.0f, v);
-					uint32_t c2 = (this->*(ti->r))(ti, u+1.0f, v+1.0f);
-					uint32_t c3 = (this->*(ti->r))(ti, u, v+1.0f);
+					uint32_t c1 = (this->*r)(ti, u+1.0f, v);
+					uint32_t c2 = (this->*r)(ti, u+1.0f, v+1.0f);
+					uint32_t c3 = (this->*r)(ti, u, v+1.0f);
 					c = bilinear_filter(c, c1, c2, c3, u, v);
 				}
 			}
@@ -2260,7 +2337,7 @@ void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int y, flo
 	}
 }
 
-void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti, int ymin, int ymax,
 									float y0, float y1,
 									float xl, float xr,
 									float ul, float ur,
@@ -2313,6 +2390,24 @@ void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 	wl += dy*dwldy;
 	wr += dy*dwrdy;
 
+	// only draw the lines inside this tile row; jump straight to its
+	// first line rather than stepping through the ones above it
+	if(yy1 > ymax)
+		yy1 = ymax;
+
+	if(yy0 < ymin) {
+		float const skip = ymin - yy0;
+		xl += skip*dxldy;
+		xr += skip*dxrdy;
+		ul += skip*duldy;
+		ur += skip*durdy;
+		vl += skip*dvldy;
+		vr += skip*dvrdy;
+		wl += skip*dwldy;
+		wr += skip*dwrdy;
+		yy0 = ymin;
+	}
+
 	while(yy0 < yy1) {
 		render_hline(bitmap, ti, yy0, xl, xr, ul, ur, vl, vr, wl, wr);
 
@@ -2359,13 +2454,13 @@ void powervr2_device::sort_vertices(const vert *v, int *i0, int *i1, int *i2)
 }
 
 
-void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
+void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, int ymin, int ymax, const vert *v0, const vert *v1, const vert *v2)
 {
 	float dy01, dy02, dy12;
 
 	float dx01dy, dx02dy, dx12dy, du01dy, du02dy, du12dy, dv01dy, dv02dy, dv12dy, dw01dy, dw02dy, dw12dy;
 
-	if(v0->y >= 480 || v2->y < 0)
+	if(v0->y >= ymax || v2->y < ymin)
 		return;
 
 	dy01 = v1->y - v0->y;
@@ -2393,41 +2488,66 @@ void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const
 			return;
 
 		if(v1->x > v0->x)
-			render_span(bitmap, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy);
+			render_span(bitmap, ti, ymin, ymax, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy);
 		else
-			render_span(bitmap, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy);
+			render_span(bitmap, ti, ymin, ymax, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy);
 
 	} else if(!dy12) {
 		if(v2->x > v1->x)
-			render_span(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy);
+			render_span(bitmap, ti, ymin, ymax, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy);
 		else
-			render_span(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy);
+			render_span(bitmap, ti, ymin, ymax, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy);
 
 	} else {
 		if(dx01dy < dx02dy) {
-			render_span(bitmap, ti, v0->y, v1->y,
+			render_span(bitmap, ti, ymin, ymax, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w,
 						dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy);
-			render_span(bitmap, ti, v1->y, v2->y,
+			render_span(bitmap, ti, ymin, ymax, v1->y, v2->y,
 						v1->x, v0->x + dx02dy*dy01, v1->u, v0->u + du02dy*dy01, v1->v, v0->v + dv02dy*dy01, v1->w, v0->w + dw02dy*dy01,
 						dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy);
 		} else {
-			render_span(bitmap, ti, v0->y, v1->y,
+			render_span(bitmap, ti, ymin, ymax, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w,
 						dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy);
-			render_span(bitmap, ti, v1->y, v2->y,
+			render_span(bitmap, ti, ymin, ymax, v1->y, v2->y,
 						v0->x + dx02dy*dy01, v1->x, v0->u + du02dy*dy01, v1->u, v0->v + dv02dy*dy01, v1->v, v0->w + dw02dy*dy01, v1->w,
 						dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy);
 		}
 	}
 }
 
-void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v)
+void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, int ymin, int ymax, const vert *v)
 {
 	int i0, i1, i2;
 
 	sort_vertices(v, &i0, &i1, &i2);
-	render_tri_sorted(bitmap, ti, v+i0, v+i1, v+i2);
+	render_tri_sorted(bitmap, ti, ymin, ymax, v+i0, v+i1, v+i2);
+}
+
+// rasterize every strip of the current display list, clipped to one row of
+// tiles; rows touch disjoint parts of the bitmap and w-buffer, and within a
+// row the strips are drawn in list order, so rows can run concurrently
+void powervr2_device::render_tile_row(bitmap_rgb32 &bitmap, int ymin, int ymax)
+{
+	receiveddata &rd = grab[renderselect];
+
+	for (int cs=0;cs < rd.strips_size;cs++)
+	{
+		strip *ts = &rd.strips[cs];
+		if(ts->evert == -1)
+			continue;
+
+		for(int i=ts->svert; i <= ts->evert-2; i++)
+			render_tri(bitmap, &ts->ti, ymin, ymax, rd.verts + i);
+	}
+}
+
+void *powervr2_device::render_tile_row_callback(void *param, int threadid)
+{
+	tile_row *row = reinterpret_cast<tile_row *>(param);
+	row->device->render_tile_row(*row->bitmap, row->ymin, row->ymax);
+	return nullptr;
 }
 
 void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap,const rectangle &cliprect)
@@ -2455,6 +2575,7 @@ void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap,const r
 	if(ns)
 		memset(wbuffer, 0x00, sizeof(wbuffer));
 
+	texcache_frame++;
 	for (int cs=0;cs < ns;cs++)
 	{
 		strip *ts = &grab[rs].strips[cs];
@@ -2471,13 +2592,20 @@ void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap,const r
 			tv->v = tv->v * ts->ti.sizey * tv->w;
 		}
 
-		for(i=sv; i <= ev-2; i++)
-		{
-			if (!(debug_dip_status&0x2))
-				render_tri(bitmap, &ts->ti, grab[rs].verts + i);
+		texcache_bind(&ts->ti);
+	}
+	texcache_expire();
 
-		}
+	// rasterization only reads the display list and texture state, so hand
+	// each row of tiles to the work queue and wait for all of them
+	if (ns && !(debug_dip_status&0x2))
+	{
+		for (tile_row &row : tile_rows)
+			row.bitmap = &bitmap;
+		osd_work_item_queue_multiple(render_queue, render_tile_row_callback, ARRAY_LENGTH(tile_rows), tile_rows, sizeof(tile_rows[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(render_queue, osd_ticks_per_second() * 100);
 	}
+
 	grab[rs].busy=0;
 }
 
@@ -3638,6 +3766,16 @@ void powervr2_device::device_start()
 
 	fake_accumulationbuffer_bitmap = std::make_unique<bitmap_rgb32>(2048,2048);
 
+	render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	for (int row = 0; row < ARRAY_LENGTH(tile_rows); row++)
+	{
+		tile_rows[row].device = this;
+		tile_rows[row].bitmap = nullptr;
+		tile_rows[row].ymin = row * 32;
+		tile_rows[row].ymax = (row + 1) * 32;
+	}
+	texcache_frame = 0;
+
 	softreset = 0;
 	param_base = 0;
 	region_base = 0;
@@ -3753,6 +3891,14 @@ void powervr2_device::device_start()
 	save_item(NAME(next_y));
 }
 
+void powervr2_device::device_stop()
+{
+	if (render_queue != nullptr)
+		osd_work_queue_free(render_queue);
+	render_queue = nullptr;
+	texcache.clear();
+}
+
 void powervr2_device::device_reset()
 {
 	softreset =                 0x00000007;
@@ -3787,6 +3933,8 @@ void powervr2_device::device_reset()
 
 	dc_state *state = machine().driver_data<dc_state>();
 	dc_texture_ram = state->dc_texture_ram.target();
+	dc_texture_ram_size = state->dc_texture_ram.bytes();
+	texcache.clear();
 	dc_framebuffer_ram = state->dc_framebuffer_ram.target();
 }
 
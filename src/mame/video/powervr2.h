@@ -71,6 +71,7 @@ public:
 		int (*u_func)(float uv, int size);
 		int (*v_func)(float uv, int size);
 		int palbase, cd;
+		const uint32_t *texels;     // decoded texture from the cache, bound at render time
 	};
 
 	typedef struct
@@ -96,6 +97,31 @@ public:
 		int valid;
 	};
 
+	// decoded textures, kept across frames and revalidated against texture RAM on each render
+	struct texcache_key {
+		uint32_t address, vqbase;
+		int stride, pf, mode, sizes, palbase;
+
+		bool operator<(const texcache_key &that) const
+		{
+			return std::tie(address, vqbase, stride, pf, mode, sizes, palbase) < std::tie(that.address, that.vqbase, that.stride, that.pf, that.mode, that.sizes, that.palbase);
+		}
+	};
+
+	struct texcache_entry {
+		uint32_t (powervr2_device::*r)(struct texinfo *t, float x, float y);
+		uint64_t fingerprint;
+		uint32_t last_used;
+		std::vector<uint32_t> texels;
+	};
+
+	// one horizontal row of 32x32 tiles, rasterized as a single work item
+	struct tile_row {
+		powervr2_device *device;
+		bitmap_rgb32 *bitmap;
+		int ymin, ymax;
+	};
+
 	enum {
 		TEX_FILTER_NEAREST = 0,
 		TEX_FILTER_BILINEAR,
@@ -122,6 +148,7 @@ public:
 	float nontextured_fpal_a,nontextured_fpal_r,nontextured_fpal_g,nontextured_fpal_b;
 
 	uint64_t *dc_texture_ram;
+	uint32_t dc_texture_ram_size;
 	uint64_t *dc_framebuffer_ram;
 
 	uint64_t *pvr2_texture_ram;
@@ -281,12 +308,21 @@ public:
 
 protected:
 	virtual void device_start() override;
+	virtual void device_stop() override;
 	virtual void device_reset() override;
 
 private:
+	enum { TEXCACHE_MAX_AGE = 16 };
+
 	devcb_write8 irq_cb;
 	required_ioport m_mamedebug;
 
+	// Rendering
+	osd_work_queue *render_queue;
+	tile_row tile_rows[480 / 32];
+	std::map<texcache_key, texcache_entry> texcache;
+	uint32_t texcache_frame;
+
 	// Core registers
 	uint32_t softreset;
 	uint32_t param_base, region_base;
@@ -432,10 +468,14 @@ private:
 	uint32_t tex_r_nt_palfloat(texinfo *t, float x, float y);
 
 	uint32_t tex_r_default(texinfo *t, float x, float y);
+	uint32_t tex_r_cached(texinfo *t, float x, float y);
 	void tex_get_info(texinfo *t);
+	uint64_t texcache_fingerprint(const texinfo *t) const;
+	void texcache_bind(texinfo *t);
+	void texcache_expire();
 
 	void render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int y, float xl, float xr, float ul, float ur, float vl, float vr, float wl, float wr);
-	void render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+	void render_span(bitmap_rgb32 &bitmap, texinfo *ti, int ymin, int ymax,
 						float y0, float y1,
 						float xl, float xr,
 						float ul, float ur,
@@ -446,8 +486,10 @@ private:
 						float dvldy, float dvrdy,
 						float dwldy, float dwrdy);
 	void sort_vertices(const vert *v, int *i0, int *i1, int *i2);
-	void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2);
-	void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v);
+	void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, int ymin, int ymax, const vert *v0, const vert *v1, const vert *v2);
+	void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, int ymin, int ymax, const vert *v);
+	void render_tile_row(bitmap_rgb32 &bitmap, int ymin, int ymax);
+	static void *render_tile_row_callback(void *param, int threadid);
 	void render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void pvr_accumulationbuffer_to_framebuffer(address_space &space, int x, int y);
 	void pvr_drawframebuffer(bitmap_rgb32 &bitmap,const rectangle &cliprect);
@@ -657,10 +657,42 @@ void n64_texture_pipe_t::calculate_clamp_diffs(uint32_t prim_tile, rdp_span_aux*
 static int32_t sTexAddrSwap16[2] = { WORD_ADDR_XOR, WORD_XOR_DWORD_SWAP };
 static int32_t sTexAddrSwap8[2] = { BYTE_ADDR_XOR, BYTE_XOR_DWORD_SWAP };
 
+// Expand texels first to first + count - 1 of a snapshot of TMEM to ARGB for one of the
+// TEXCACHE_* layouts, indexed by the same taddr the matching fetch_* function computes.  All
+// cached layouts address 0x800 texels, each decoded from the TMEM at taddr alone plus the TLUT.
+void n64_texture_pipe_t::decode_tmem(uint32_t* dest, int32_t format, const uint8_t* tmem, int32_t first, int32_t count)
+{
+	const uint16_t* tc16 = (const uint16_t*)tmem;
+	const uint16_t* tlut = (const uint16_t*)(tmem + 0x800);
+
+	for (int32_t taddr = first; taddr < first + count; taddr++)
+	{
+		uint16_t c;
+		switch (format)
+		{
+			case TEXCACHE_RGBA16:       c = tc16[taddr]; break;
+			case TEXCACHE_RGBA16_TLUT0: c = tlut[(tc16[taddr] >> 8) << 2]; break;
+			default:                    c = tlut[tmem[taddr] << 2]; break;
+		}
+
+#if USE_64K_LUT
+		dest[taddr] = m_expand_16to32_table[c].to_rgba();
+#else
+		dest[taddr] = rgb_t((c & 1) * 0xff, GET_HI_RGBA16_TMEM(c), GET_MED_RGBA16_TMEM(c), GET_LOW_RGBA16_TMEM(c));
+#endif
+	}
+}
+
 void n64_texture_pipe_t::fetch_rgba16_tlut0(rgbaint_t& out, int32_t s, int32_t t, int32_t tbase, int32_t tpal, rdp_span_aux* userdata)
 {
 	int32_t taddr = (((tbase << 2) + s) ^ sTexAddrSwap16[t & 1]) & 0x7ff;
 
+	if (const uint32_t* texels = userdata->m_texels[TEXCACHE_RGBA16_TLUT0])
+	{
+		out.set(texels[taddr]);
+		return;
+	}
+
 	uint16_t c = ((uint16_t*)userdata->m_tmem)[taddr];
 	c = ((uint16_t*)(userdata->m_tmem + 0x800))[(c >> 8) << 2];
 
@@ -686,6 +718,12 @@ void n64_texture_pipe_t::fetch_rgba16_raw(rgbaint_t& out, int32_t s, int32_t t,
 {
 	const int32_t taddr = (((tbase << 2) + s) ^ sTexAddrSwap16[t & 1]) & 0x7ff;
 
+	if (const uint32_t* texels = userdata->m_texels[TEXCACHE_RGBA16])
+	{
+		out.set(texels[taddr]);
+		return;
+	}
+
 	const uint16_t c = ((uint16_t*)userdata->m_tmem)[taddr];
 
 #if USE_64K_LUT
@@ -797,6 +835,12 @@ void n64_texture_pipe_t::fetch_ci8_tlut0(rgbaint_t& out, int32_t s, int32_t t, i
 	const uint8_t *tc = userdata->m_tmem;
 	const int32_t taddr = (((tbase << 3) + s) ^ sTexAddrSwap8[t & 1]) & 0x7ff;
 
+	if (const uint32_t* texels = userdata->m_texels[TEXCACHE_CI8_TLUT0])
+	{
+		out.set(texels[taddr]);
+		return;
+	}
+
 	const uint8_t p = tc[taddr];
 	const uint16_t c = ((uint16_t*)(userdata->m_tmem + 0x800))[p << 2];
 
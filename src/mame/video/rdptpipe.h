@@ -104,6 +104,8 @@ class n64_texture_pipe_t
 
 		void                set_machine(running_machine& machine);
 
+		void                decode_tmem(uint32_t* dest, int32_t format, const uint8_t* tmem, int32_t first, int32_t count);
+
 		bool                m_start_span;
 
 	private:
@@ -53,6 +53,57 @@ void osd_process_kill(void);
 int osd_setenv(const char *name, const char *value, int overwrite);
 
 
+/*-----------------------------------------------------------------------------
+    osd_thread_set_affinity: restrict the calling thread to a set of CPUs
+
+    Parameters:
+
+        cpus - CPU numbers as the OS counts them
+
+    Return value:
+
+        true on success, false if the OS refused or cannot do it
+
+    Notes:
+
+        On Linux, threads started afterwards by the calling thread inherit
+        the set.
+-----------------------------------------------------------------------------*/
+
+bool osd_thread_set_affinity(const std::vector<int> &cpus);
+
+
+/*-----------------------------------------------------------------------------
+    osd_thread_get_affinity: list the CPUs the calling thread may run on
+
+    Parameters:
+
+        cpus - receives the CPU numbers, in ascending order
+
+    Return value:
+
+        true on success, false if the OS cannot tell
+-----------------------------------------------------------------------------*/
+
+bool osd_thread_get_affinity(std::vector<int> &cpus);
+
+
+/*-----------------------------------------------------------------------------
+    osd_get_numa_node_cpus: list the CPUs of a NUMA node
+
+    Parameters:
+
+        node - NUMA node number
+        cpus - receives the CPU numbers, in ascending order
+
+    Return value:
+
+        true if the node exists and has CPUs
+-----------------------------------------------------------------------------*/
+
+bool osd_get_numa_node_cpus(int node, std::vector<int> &cpus);
+
+
 /*-----------------------------------------------------------------------------
     osd_get_clipboard_text: retrieves text from the clipboard
 
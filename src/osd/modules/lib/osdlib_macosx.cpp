@@ -56,6 +56,36 @@ void osd_process_kill()
 	kill(getpid(), SIGKILL);
 }
 
+//============================================================
+//  osd_thread_set_affinity
+//============================================================
+
+bool osd_thread_set_affinity(const std::vector<int> &cpus)
+{
+	// Mac OS X only takes affinity hints, not hard placement
+	return false;
+}
+
+//============================================================
+//  osd_thread_get_affinity
+//============================================================
+
+bool osd_thread_get_affinity(std::vector<int> &cpus)
+{
+	cpus.clear();
+	return false;
+}
+
+//============================================================
+//  osd_get_numa_node_cpus
+//============================================================
+
+bool osd_get_numa_node_cpus(int node, std::vector<int> &cpus)
+{
+	cpus.clear();
+	return false;
+}
+
 //============================================================
 //  osd_alloc_executable
 //
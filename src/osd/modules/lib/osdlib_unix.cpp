@@ -14,6 +14,9 @@
 #include <sys/types.h>
 #include <signal.h>
 #include <dlfcn.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include <cstdio>
 #include <iomanip>
@@ -53,6 +56,68 @@ void osd_process_kill()
 	kill(getpid(), SIGKILL);
 }
 
+//============================================================
+//  osd_thread_set_affinity
+//============================================================
+
+bool osd_thread_set_affinity(const std::vector<int> &cpus)
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int cpu : cpus)
+		if (cpu >= 0 && cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &set);
+	if (CPU_COUNT(&set) == 0)
+		return false;
+
+	// a pid of 0 means the calling thread, not the whole process
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	return false;
+#endif
+}
+
+//============================================================
+//  osd_thread_get_affinity
+//============================================================
+
+bool osd_thread_get_affinity(std::vector<int> &cpus)
+{
+	cpus.clear();
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) != 0)
+		return false;
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		if (CPU_ISSET(cpu, &set))
+			cpus.push_back(cpu);
+#endif
+	return !cpus.empty();
+}
+
+//============================================================
+//  osd_get_numa_node_cpus
+//============================================================
+
+bool osd_get_numa_node_cpus(int node, std::vector<int> &cpus)
+{
+	cpus.clear();
+#if defined(__linux__)
+	// sysfs has a cpuN entry in the node directory for each of its CPUs
+	long const count = sysconf(_SC_NPROCESSORS_CONF);
+	for (int cpu = 0; cpu < count; cpu++)
+	{
+		char path[64];
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpu%d", node, cpu);
+		if (access(path, F_OK) == 0)
+			cpus.push_back(cpu);
+	}
+#endif
+	return !cpus.empty();
+}
+
 //============================================================
 //  osd_alloc_executable
 //
@@ -88,6 +88,35 @@ void osd_process_kill()
 	TerminateProcess(GetCurrentProcess(), -1);
 }
 
+//============================================================
+//  osd_thread_set_affinity
+//============================================================
+
+bool osd_thread_set_affinity(const std::vector<int> &cpus)
+{
+	return false;
+}
+
+//============================================================
+//  osd_thread_get_affinity
+//============================================================
+
+bool osd_thread_get_affinity(std::vector<int> &cpus)
+{
+	cpus.clear();
+	return false;
+}
+
+//============================================================
+//  osd_get_numa_node_cpus
+//============================================================
+
+bool osd_get_numa_node_cpus(int node, std::vector<int> &cpus)
+{
+	cpus.clear();
+	return false;
+}
+
 //============================================================
 //  osd_alloc_executable
 //
@@ -82,6 +82,55 @@ void osd_process_kill()
 	TerminateProcess(GetCurrentProcess(), -1);
 }
 
+//============================================================
+//  osd_thread_set_affinity
+//============================================================
+
+bool osd_thread_set_affinity(const std::vector<int> &cpus)
+{
+	// only the first processor group is reachable through a mask
+	DWORD_PTR mask = 0;
+	for (int cpu : cpus)
+		if (cpu >= 0 && cpu < int(sizeof(mask) * 8))
+			mask |= DWORD_PTR(1) << cpu;
+	if (mask == 0)
+		return false;
+	return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
+//============================================================
+//  osd_thread_get_affinity
+//============================================================
+
+bool osd_thread_get_affinity(std::vector<int> &cpus)
+{
+	// a thread can't read its own mask, but it starts with the process's
+	cpus.clear();
+	DWORD_PTR process, system;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process, &system))
+		return false;
+	for (int cpu = 0; cpu < int(sizeof(process) * 8); cpu++)
+		if (process & (DWORD_PTR(1) << cpu))
+			cpus.push_back(cpu);
+	return !cpus.empty();
+}
+
+//============================================================
+//  osd_get_numa_node_cpus
+//============================================================
+
+bool osd_get_numa_node_cpus(int node, std::vector<int> &cpus)
+{
+	cpus.clear();
+	ULONGLONG mask = 0;
+	if (node < 0 || node > 255 || !GetNumaNodeProcessorMask(UCHAR(node), &mask))
+		return false;
+	for (int cpu = 0; cpu < 64; cpu++)
+		if (mask & (ULONGLONG(1) << cpu))
+			cpus.push_back(cpu);
+	return !cpus.empty();
+}
+
 //============================================================
 //  osd_alloc_executable
 //
@@ -12,6 +12,10 @@
 #include "emu.h"
 #include "osdepend.h"
 #include "modules/lib/osdobj_common.h"
+#include "modules/lib/osdlib.h"
+#include "osdsync.h"
+
+#include <algorithm>
 
 const options_entry osd_options::s_option_entries[] =
 {
@@ -46,6 +50,9 @@ const options_entry osd_options::s_option_entries[] =
 
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD PERFORMANCE OPTIONS" },
 	{ OSDOPTION_NUMPROCESSORS ";np",          OSDOPTVAL_AUTO,   OPTION_STRING,    "number of processors; this overrides the number the system reports" },
+	{ OSDOPTION_AFFINITY,                     "",               OPTION_STRING,    "CPUs the emulation thread may run on, such as 0-3,8; empty for no restriction" },
+	{ OSDOPTION_WORKAFFINITY,                 "",               OPTION_STRING,    "CPUs the work queue threads may run on, such as 4-7; empty for no restriction" },
+	{ OSDOPTION_NUMANODE,                     "-1",             OPTION_INTEGER,   "keep the emulation and work queue threads on the CPUs of this NUMA node; -1 for no restriction" },
 	{ OSDOPTION_BENCH,                        "0",              OPTION_INTEGER,   "benchmark for the given number of emulated seconds; implies -video none -sound none -nothrottle" },
 
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD VIDEO OPTIONS" },
@@ -56,6 +63,7 @@ const options_entry osd_options::s_option_entries[] =
 	{ OSDOPTION_MAXIMIZE ";max",              "1",              OPTION_BOOLEAN,   "default to maximized windows; otherwise, windows will be minimized" },
 	{ OSDOPTION_WAITVSYNC ";vs",              "0",              OPTION_BOOLEAN,   "enable waiting for the start of VBLANK before flipping screens; reduces tearing effects" },
 	{ OSDOPTION_SYNCREFRESH ";srf",           "0",              OPTION_BOOLEAN,   "enable using the start of VBLANK for throttling instead of the game time" },
+	{ OSDOPTION_OFFSCREEN_SKIP,               "0",              OPTION_INTEGER,   "with -video offscreen, number of frames to skip between each one drawn" },
 	{ OSD_MONITOR_PROVIDER,                   OSDOPTVAL_AUTO,   OPTION_STRING,    "monitor discovery method" },
 
 	// per-window options
@@ -348,6 +356,7 @@ void osd_common_t::register_options()
 
 	// Register video options and update options
 	video_options_add("none", nullptr);
+	video_options_add(OSDOPTVAL_OFFSCREEN, nullptr);
 	video_register();
 	update_option(OSDOPTION_VIDEO, m_video_names);
 }
@@ -477,6 +486,9 @@ void osd_common_t::update(bool skip_redraw)
 	if (m_watchdog != nullptr)
 		m_watchdog->reset();
 
+	if (m_output != nullptr)
+		m_output->flush();
+
 	update_slider_list();
 
 }
@@ -554,6 +566,17 @@ void osd_common_t::set_mastervolume(int attenuation)
 }
 
 
+//-------------------------------------------------
+//  get_audio_buffer_fill - report how much audio
+//  is waiting to be played, for throttling
+//-------------------------------------------------
+
+bool osd_common_t::get_audio_buffer_fill(int &queued, int &target)
+{
+	return (m_sound != nullptr) && m_sound->get_buffer_fill(queued, target);
+}
+
+
 //-------------------------------------------------
 //  customize_input_type_list - provide OSD
 //  additions/modifications to the input list
@@ -634,13 +657,154 @@ bool osd_common_t::execute_command(const char *command)
 
 }
 
-static void output_notifier_callback(const char *outname, int32_t value, void *param)
+static void output_notifier_callback(output_manager &manager, const std::vector<u32> &ids, void *param)
+{
+	osd_common_t *const osd = static_cast<osd_common_t*>(param);
+	for (u32 id : ids)
+		osd->notify_changed(id, manager.id_to_name(id), manager.value(id));
+}
+
+//-------------------------------------------------
+//  parse_cpu_list - parse a list of CPUs such as
+//  "0-3,8"; returns false if it is malformed
+//-------------------------------------------------
+
+static bool parse_cpu_list(const char *spec, std::vector<int> &cpus)
+{
+	cpus.clear();
+	while (*spec != 0)
+	{
+		char *end;
+		long const first = strtol(spec, &end, 10);
+		if (end == spec || first < 0)
+			return false;
+		long last = first;
+		if (*end == '-')
+		{
+			spec = end + 1;
+			last = strtol(spec, &end, 10);
+			if (end == spec || last < first)
+				return false;
+		}
+		if (last >= 4096)
+			return false;
+		for (long cpu = first; cpu <= last; cpu++)
+			cpus.push_back(int(cpu));
+
+		spec = end;
+		if (*spec == ',')
+			spec++;
+		else if (*spec != 0)
+			return false;
+	}
+
+	std::sort(cpus.begin(), cpus.end());
+	cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+	return true;
+}
+
+
+//-------------------------------------------------
+//  format_cpu_list - the reverse of
+//  parse_cpu_list, for reporting
+//-------------------------------------------------
+
+static std::string format_cpu_list(const std::vector<int> &cpus)
+{
+	std::string result;
+	for (size_t index = 0; index < cpus.size(); )
+	{
+		size_t last = index;
+		while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+			last++;
+		if (!result.empty())
+			result.append(",");
+		result.append(std::to_string(cpus[index]));
+		if (last != index)
+			result.append("-").append(std::to_string(cpus[last]));
+		index = last + 1;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  init_affinity - place the emulation thread and
+//  the work queue threads on the requested CPUs
+//-------------------------------------------------
+
+void osd_common_t::init_affinity()
 {
-	static_cast<osd_common_t*>(param)->notify(outname, value);
+	// a NUMA node limits both sets to its CPUs
+	int const numanode = options().numa_node();
+	std::vector<int> nodecpus;
+	if (numanode >= 0 && !osd_get_numa_node_cpus(numanode, nodecpus))
+		osd_printf_warning("NUMA node %d not found, ignoring -%s\n", numanode, OSDOPTION_NUMANODE);
+
+	auto const resolve = [&nodecpus, numanode] (const char *name, const char *spec, std::vector<int> &cpus)
+	{
+		if (!parse_cpu_list(spec, cpus))
+		{
+			osd_printf_warning("Invalid CPU list '%s' for -%s, ignoring\n", spec, name);
+			cpus.clear();
+		}
+		if (nodecpus.empty())
+			return;
+
+		std::vector<int> both;
+		std::set_intersection(cpus.begin(), cpus.end(), nodecpus.begin(), nodecpus.end(), std::back_inserter(both));
+		if (both.empty() && !cpus.empty())
+			osd_printf_warning("None of the CPUs for -%s are on NUMA node %d, using the whole node\n", name, numanode);
+		cpus = both.empty() ? nodecpus : both;
+	};
+
+	std::vector<int> emulation, work;
+	resolve(OSDOPTION_AFFINITY, options().affinity(), emulation);
+	resolve(OSDOPTION_WORKAFFINITY, options().work_affinity(), work);
+	std::string const node = nodecpus.empty() ? std::string() : string_format(" (NUMA node %d)", numanode);
+
+	// this runs again on a hard reset or a system change, by which time
+	// the previous machine may have restricted the emulation thread, so
+	// the set the process started with is read the first time only
+	static std::vector<int> const original = [] () { std::vector<int> cpus; osd_thread_get_affinity(cpus); return cpus; }();
+	static bool restricted = false;
+
+	// work queue threads are started from the emulation thread and would
+	// inherit its set on Linux, so without -workaffinity they get the set
+	// the process started with
+	bool const work_given = !work.empty();
+	if (!work_given && !emulation.empty())
+		work = original;
+
+	// this runs before video and sound start their threads, so on systems
+	// where new threads inherit the set they stay with the emulation
+	if (!emulation.empty())
+	{
+		if (osd_thread_set_affinity(emulation))
+			osd_printf_info("Emulation thread running on CPUs %s%s\n", format_cpu_list(emulation).c_str(), node.c_str());
+		else
+			osd_printf_warning("Unable to restrict the emulation thread to CPUs %s\n", format_cpu_list(emulation).c_str());
+		restricted = true;
+	}
+	else if (restricted && !original.empty())
+	{
+		// the previous machine's set doesn't carry over to this one
+		osd_thread_set_affinity(original);
+		restricted = false;
+	}
+
+	// the work queue threads pick this up as they start
+	osd_work_affinity = work;
+	if (work_given)
+		osd_printf_info("Work queue threads running on CPUs %s%s\n", format_cpu_list(work).c_str(), node.c_str());
 }
 
+
 void osd_common_t::init_subsystems()
 {
+	// place threads before anything starts its own
+	init_affinity();
+
 	// monitors have to be initialized before video init
 	m_monitor_module = select_module_options<monitor_module *>(options(), OSD_MONITOR_PROVIDER);
 	assert(m_monitor_module != nullptr);
@@ -673,7 +837,7 @@ void osd_common_t::init_subsystems()
 
 	m_output = select_module_options<output_module *>(options(), OSD_OUTPUT_PROVIDER);
 	m_output->set_machine(&machine());
-	machine().output().set_notifier(nullptr, output_notifier_callback, this);
+	machine().output().add_batch_notifier(output_notifier_callback, this);
 
 	m_mod_man.init(options());
 
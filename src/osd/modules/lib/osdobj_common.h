@@ -42,6 +42,9 @@
 #define OSDOPTION_WATCHDOG              "watchdog"
 
 #define OSDOPTION_NUMPROCESSORS         "numprocessors"
+#define OSDOPTION_AFFINITY              "affinity"
+#define OSDOPTION_WORKAFFINITY          "workaffinity"
+#define OSDOPTION_NUMANODE              "numanode"
 #define OSDOPTION_BENCH                 "bench"
 
 #define OSDOPTION_VIDEO                 "video"
@@ -50,6 +53,7 @@
 #define OSDOPTION_MAXIMIZE              "maximize"
 #define OSDOPTION_WAITVSYNC             "waitvsync"
 #define OSDOPTION_SYNCREFRESH           "syncrefresh"
+#define OSDOPTION_OFFSCREEN_SKIP        "offscreen_skip"
 
 #define OSDOPTION_SCREEN                "screen"
 #define OSDOPTION_ASPECT                "aspect"
@@ -82,6 +86,7 @@
 
 #define OSDOPTVAL_AUTO                  "auto"
 #define OSDOPTVAL_NONE                  "none"
+#define OSDOPTVAL_OFFSCREEN             "offscreen"
 
 #define OSDOPTION_BGFX_PATH             "bgfx_path"
 #define OSDOPTION_BGFX_BACKEND          "bgfx_backend"
@@ -111,6 +116,9 @@ public:
 
 	// performance options
 	const char *numprocessors() const { return value(OSDOPTION_NUMPROCESSORS); }
+	const char *affinity() const { return value(OSDOPTION_AFFINITY); }
+	const char *work_affinity() const { return value(OSDOPTION_WORKAFFINITY); }
+	int numa_node() const { return int_value(OSDOPTION_NUMANODE); }
 	int bench() const { return int_value(OSDOPTION_BENCH); }
 
 	// video options
@@ -120,6 +128,7 @@ public:
 	bool maximize() const { return bool_value(OSDOPTION_MAXIMIZE); }
 	bool wait_vsync() const { return bool_value(OSDOPTION_WAITVSYNC); }
 	bool sync_refresh() const { return bool_value(OSDOPTION_SYNCREFRESH); }
+	int offscreen_skip() const { return int_value(OSDOPTION_OFFSCREEN_SKIP); }
 
 	// per-window options
 	const char *screen() const { return value(OSDOPTION_SCREEN); }
@@ -198,6 +207,7 @@ public:
 	virtual void update_audio_stream(const int16_t *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
 	virtual bool no_sound() override;
+	virtual bool get_audio_buffer_fill(int &queued, int &target) override;
 
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) override;
@@ -246,12 +256,15 @@ public:
 	void set_verbose(bool print_verbose) { m_print_verbose = print_verbose; }
 
 	void notify(const char *outname, int32_t value) const { m_output->notify(outname, value); }
+	void notify_changed(uint32_t id, const char *outname, int32_t value) const { m_output->notify_changed(id, outname, value); }
 
 	static std::list<std::shared_ptr<osd_window>> s_window_list;
 protected:
 	virtual bool input_init();
 	virtual void input_pause();
 
+	void init_affinity();
+
 	virtual void build_slider_list() { }
 	virtual void update_slider_list() { }
 
@@ -10,6 +10,7 @@
 #include "osdwindow.h"
 
 #include "render/drawnone.h"
+#include "render/drawoffscreen.h"
 #include "render/drawbgfx.h"
 #if (USE_OPENGL)
 #include "render/drawogl.h"
@@ -35,6 +36,8 @@ std::unique_ptr<osd_renderer> osd_renderer::make_for_type(int mode, std::shared_
 		case VIDEO_MODE_NONE:
 			return std::make_unique<renderer_none>(window);
 #endif
+		case VIDEO_MODE_OFFSCREEN:
+			return std::make_unique<renderer_offscreen>(window);
 		case VIDEO_MODE_BGFX:
 			return std::make_unique<renderer_bgfx>(window);
 #if (USE_OPENGL)
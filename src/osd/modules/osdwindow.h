@@ -43,6 +43,7 @@ enum
 	VIDEO_MODE_SDL2ACCEL,
 	VIDEO_MODE_D3D,
 	VIDEO_MODE_SOFT,
+	VIDEO_MODE_OFFSCREEN,
 
 	VIDEO_MODE_COUNT
 };
@@ -6,6 +6,22 @@
 
     Network output interface.
 
+    Clients are greeted with "hello = 1" and then receive output changes
+    as "name = value" text messages.  A client that sends "binary = 1"
+    switches to the batched binary protocol instead: it gets a table of
+    every known output name with its ID, followed by one delta packet per
+    frame carrying only the outputs that changed.  All binary values are
+    little-endian, and every packet starts with a u8 type and a u32
+    payload length:
+
+        OUTPUT_NAMES: repeated u32 id, u16 length, name characters
+        OUTPUT_DELTA: u32 frame, u32 count, repeated u32 id, s32 value
+
+    IDs are the output manager's, the same ones "send_id" resolves; ID 0
+    is "mamerun", which goes to 0 when MAME exits.  Names first seen
+    during a frame are sent in an OUTPUT_NAMES packet ahead of that
+    frame's delta.
+
 ***************************************************************************/
 
 #include "output_module.h"
@@ -18,24 +34,87 @@
 #include <set>
 #include "asio.h"
 
+// binary packet types
+enum : std::uint8_t
+{
+	OUTPUT_NAMES = 1,
+	OUTPUT_DELTA = 2
+};
+
+// one frame's worth of changes, handed from the emulation thread to the network thread
+struct output_batch
+{
+	std::uint32_t frame;
+	std::vector<std::pair<std::uint32_t, std::string>> names;     // outputs first seen this frame
+	std::vector<std::pair<std::uint32_t, std::int32_t>> values;   // latest value of each changed output
+};
+
+using output_batch_ptr = std::shared_ptr<const output_batch>;
+using output_buffer = std::vector<char>;
+
+static void put_u16(output_buffer &buffer, std::uint16_t value)
+{
+	buffer.push_back(char(value));
+	buffer.push_back(char(value >> 8));
+}
+
+static void put_u32(output_buffer &buffer, std::uint32_t value)
+{
+	put_u16(buffer, std::uint16_t(value));
+	put_u16(buffer, std::uint16_t(value >> 16));
+}
+
+// start a binary packet, returning where its length goes
+static std::size_t begin_packet(output_buffer &buffer, std::uint8_t type)
+{
+	buffer.push_back(char(type));
+	std::size_t const length_pos = buffer.size();
+	put_u32(buffer, 0);
+	return length_pos;
+}
+
+static void end_packet(output_buffer &buffer, std::size_t length_pos)
+{
+	std::uint32_t const length = buffer.size() - length_pos - 4;
+	for (int i = 0; i < 4; i++)
+		buffer[length_pos + i] = char(length >> (8 * i));
+}
+
+static void put_names(output_buffer &buffer, const std::vector<std::pair<std::uint32_t, std::string>> &names)
+{
+	std::size_t const length_pos = begin_packet(buffer, OUTPUT_NAMES);
+	for (auto &name : names)
+	{
+		put_u32(buffer, name.first);
+		put_u16(buffer, std::uint16_t(name.second.length()));
+		buffer.insert(buffer.end(), name.second.begin(), name.second.end());
+	}
+	end_packet(buffer, length_pos);
+}
+
 class output_client
 {
 public:
   virtual ~output_client() {}
-  virtual void deliver(std::string &msg) = 0;
+  virtual void deliver(const output_batch &batch, const std::vector<std::string> &names) = 0;
+  virtual void deliver_text(const std::string &msg) = 0;
 };
 
 using output_client_ptr = std::shared_ptr<output_client>;
 using client_set = std::set<output_client_ptr>;
 
+// everything below runs on the network thread only
 class output_session : public output_client,
 		public std::enable_shared_from_this<output_session>
 
 {
 public:
-  output_session(asio::ip::tcp::socket socket, client_set *clients) :
+  output_session(asio::ip::tcp::socket socket, client_set *clients, const std::vector<std::string> *names) :
 	m_socket(std::move(socket)),
-	m_clients(clients)
+	m_clients(clients),
+	m_names(names),
+	m_binary(false),
+	m_writing(false)
   {
   }
 
@@ -44,16 +123,47 @@ public:
 	m_machine = &machine;
 	m_clients->insert(shared_from_this());
 	// now send "hello = 1" to the newly connected client
-	std::strncpy(m_data, "hello = 1\1", max_length);
-	do_write(10);
+	deliver_text("hello = 1\1");
 	do_read();
   }
 
 private:
-  void deliver(std::string &msg)
+  void deliver(const output_batch &batch, const std::vector<std::string> &names)
+  {
+	if (m_binary)
+	{
+		if (!batch.names.empty())
+			put_names(m_pending, batch.names);
+
+		std::size_t const length_pos = begin_packet(m_pending, OUTPUT_DELTA);
+		put_u32(m_pending, batch.frame);
+		put_u32(m_pending, batch.values.size());
+		for (auto &value : batch.values)
+		{
+			put_u32(m_pending, value.first);
+			put_u32(m_pending, std::uint32_t(value.second));
+		}
+		end_packet(m_pending, length_pos);
+	}
+	else
+	{
+		// the whole frame still goes out in a single write
+		char buf[32];
+		for (auto &value : batch.values)
+		{
+			std::string const &name = names[value.first];
+			m_pending.insert(m_pending.end(), name.begin(), name.end());
+			int const length = std::snprintf(buf, sizeof(buf), " = %d\1", value.second);
+			m_pending.insert(m_pending.end(), buf, buf + length);
+		}
+	}
+	do_write();
+  }
+
+  void deliver_text(const std::string &msg)
   {
-	std::strncpy(m_data, msg.c_str(), max_length);
-	do_write(msg.size());
+	m_pending.insert(m_pending.end(), msg.begin(), msg.end());
+	do_write();
   }
 
   void handle_message(char *msg)
@@ -64,36 +174,55 @@ private:
 	//printf("handle_message: got [%s]\n", msg);
 
 	std::uint32_t ch = 0;
-	while (msg[ch] != ' ')
+	while (msg[ch] != ' ' && msg[ch] != '\0')
 	{
 		ch++;
 	}
+	if (msg[ch] == '\0')
+		return;
 	msg[ch] = '\0';
 	ch++;
 	std::strncpy(verb, msg, sizeof(verb)-1);
+	verb[sizeof(verb)-1] = '\0';
 	//printf("verb = [%s], ", verb);
 
-	while (msg[ch] != ' ')
+	while (msg[ch] != ' ' && msg[ch] != '\0')
 	{
 		ch++;
 	}
+	if (msg[ch] == '\0')
+		return;
 
 	ch++;
 	value = atoi(&msg[ch]);
 	//printf("value = %d\n", value);
 
+	char buf[1024];
 	if (!std::strcmp(verb, "send_id"))
 	{
 		if (value == 0)
 		{
-			std::snprintf(m_data, max_length, "req_id = %s\1", machine().system().name);
+			std::snprintf(buf, sizeof(buf), "req_id = %s\1", machine().system().name);
 		}
 		else
 		{
-			std::snprintf(m_data, max_length, "req_id = %s\1", machine().output().id_to_name(value));
+			// the IDs clients get in binary mode
+			const char *const name = machine().output().id_to_name(value);
+			std::snprintf(buf, sizeof(buf), "req_id = %s\1", (name != nullptr) ? name : "none");
 		}
 
-		do_write(std::strlen(m_data));
+		deliver_text(buf);
+	}
+	else if (!std::strcmp(verb, "binary") && value != 0 && !m_binary)
+	{
+		// switch over, starting with every name known so far
+		m_binary = true;
+		std::vector<std::pair<std::uint32_t, std::string>> names;
+		for (std::uint32_t id = 0; id < m_names->size(); id++)
+			if (!(*m_names)[id].empty())
+				names.emplace_back(id, (*m_names)[id]);
+		put_names(m_pending, names);
+		do_write();
 	}
   }
 
@@ -119,27 +248,55 @@ private:
 		});
   }
 
-  void do_write(std::size_t length)
+  // one write in flight at a time; anything delivered meanwhile is
+  // appended to the pending buffer and goes out with the next write
+  void do_write()
   {
+	// a client this far behind is not reading at all
+	if (m_pending.size() > max_pending)
+	{
+		std::error_code ec;
+		m_pending.clear();
+		m_socket.close(ec);
+		m_clients->erase(shared_from_this());
+		return;
+	}
+
+	if (m_writing || m_pending.empty())
+		return;
+
+	m_writing = true;
+	m_sending.clear();
+	m_sending.swap(m_pending);
+
 	auto self(shared_from_this());
-		asio::async_write(m_socket, asio::buffer(m_data, length),
+		asio::async_write(m_socket, asio::buffer(m_sending),
 		[this, self](std::error_code ec, std::size_t /*length*/)
 		{
+		  m_writing = false;
 		  if (ec)
 		  {
 			m_clients->erase(shared_from_this());
 		  }
+		  else
+		  {
+			do_write();
+		  }
 		});
   }
 
   running_machine &machine() const { return *m_machine; }
 
   asio::ip::tcp::socket m_socket;
-  enum { max_length = 1024 };
-  char m_data[max_length];
-  char m_input_m_data[max_length];
+  enum { max_length = 1024, max_pending = 1 << 20 };
+  char m_input_m_data[max_length + 1];
+  output_buffer m_pending;
+  output_buffer m_sending;
   client_set *m_clients;
+  const std::vector<std::string> *m_names;
   running_machine *m_machine;
+  bool m_binary;
+  bool m_writing;
 };
 
 class output_network_server
@@ -152,10 +309,19 @@ public:
 	do_accept();
   }
 
-  void deliver_to_all(std::string msg)
+  void deliver_to_all(const output_batch &batch)
   {
-	for (auto client: m_clients)
-	  client->deliver(msg);
+	for (auto &name : batch.names)
+	{
+		if (m_names.size() <= name.first)
+			m_names.resize(name.first + 1);
+		m_names[name.first] = name.second;
+	}
+
+	// sessions may drop out of the set while delivering
+	client_set const clients(m_clients);
+	for (auto client : clients)
+	  client->deliver(batch, m_names);
   }
 
 private:
@@ -166,7 +332,7 @@ private:
 		{
 		  if (!ec)
 		  {
-			std::make_shared<output_session>(std::move(socket),&m_clients)->start(machine());
+			std::make_shared<output_session>(std::move(socket), &m_clients, &m_names)->start(machine());
 		  }
 
 		  do_accept();
@@ -177,6 +343,7 @@ private:
 
   asio::ip::tcp::acceptor m_acceptor;
   client_set m_clients;
+  std::vector<std::string> m_names;     // indexed by output ID, as sent to clients
   running_machine *m_machine;
 };
 
@@ -187,7 +354,7 @@ public:
 	output_network()
 	: osd_module(OSD_OUTPUT_PROVIDER, "network"),
 	  output_module(),
-	  m_io_context(nullptr), m_server(nullptr)
+	  m_io_context(nullptr), m_server(nullptr), m_frame(0)
 	{
 	}
 
@@ -197,6 +364,7 @@ public:
 
 	virtual int init(const osd_options &options) override
 	{
+		m_io_context = new asio::io_context();
 		m_working_thread = std::thread([](output_network* self) { self->process_output(); }, this);
 		return 0;
 	}
@@ -204,7 +372,8 @@ public:
 	virtual void exit() override
 	{
 		// tell clients MAME is shutting down
-		notify("mamerun", 0);
+		notify_changed(0, "mamerun", 0);
+		flush();
 		m_io_context->stop();
 		m_working_thread.join();
 		delete m_server;
@@ -215,15 +384,61 @@ public:
 
 	virtual void notify(const char *outname, int32_t value) override
 	{
-		static char buf[256];
-		sprintf(buf, "%s = %d\1", ((outname==nullptr) ? "none" : outname), value);
-		m_server->deliver_to_all(buf);
+		// every output the manager knows has an ID
+		std::uint32_t const id = machine().output().name_to_id(outname);
+		if (id != 0)
+			notify_changed(id, outname, value);
+	}
+
+	virtual void notify_changed(std::uint32_t id, const char *outname, std::int32_t value) override
+	{
+		if (m_values.size() <= id)
+		{
+			m_values.resize(id + 1, 0);
+			m_dirty.resize(id + 1, false);
+			m_named.resize(id + 1, false);
+		}
+		if (!m_named[id])
+		{
+			m_named[id] = true;
+			m_new_names.emplace_back(id, (outname == nullptr) ? "none" : outname);
+		}
+
+		// only the last value of the frame is sent
+		m_values[id] = value;
+		if (!m_dirty[id])
+		{
+			m_dirty[id] = true;
+			m_changed.push_back(id);
+		}
+	}
+
+	virtual void flush() override
+	{
+		std::uint32_t const frame = m_frame++;
+		if (m_changed.empty())
+			return;
+
+		auto batch = std::make_shared<output_batch>();
+		batch->frame = frame;
+		batch->names.swap(m_new_names);
+		batch->values.reserve(m_changed.size());
+		for (std::uint32_t id : m_changed)
+		{
+			batch->values.emplace_back(id, m_values[id]);
+			m_dirty[id] = false;
+		}
+		m_changed.clear();
+
+		// the server and its sessions are only touched from the network thread
+		output_batch_ptr const delivered(std::move(batch));
+		asio::post(*m_io_context, [this, delivered] () { m_server->deliver_to_all(*delivered); });
 	}
 
 	// implementation
 	void process_output()
 	{
-		m_io_context = new asio::io_context();
+		// created before run(), so posted batches always find it
 		m_server = new output_network_server(*m_io_context, 8000, machine());
 		m_io_context->run();
 	}
@@ -232,6 +447,14 @@ private:
 	std::thread m_working_thread;
 	asio::io_context *m_io_context;
 	output_network_server *m_server;
+
+	// emulation thread state, indexed by output ID
+	std::vector<std::int32_t> m_values;
+	std::vector<bool> m_dirty;
+	std::vector<bool> m_named;
+	std::vector<std::uint32_t> m_changed;
+	std::vector<std::pair<std::uint32_t, std::string>> m_new_names;
+	std::uint32_t m_frame;
 };
 
 MODULE_DEFINITION(OUTPUT_NETWORK, output_network)
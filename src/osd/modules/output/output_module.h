@@ -26,6 +26,13 @@ public:
 
 	virtual void notify(const char *outname, int32_t value) = 0;
 
+	// called for each output changed during a frame, with the ID the output
+	// manager gave it; modules that keep per-output state can index it by ID
+	virtual void notify_changed(uint32_t id, const char *outname, int32_t value) { notify(outname, value); }
+
+	// called once per OSD update, so modules can send notifications in batches
+	virtual void flush() { }
+
 	void set_machine(running_machine *machine) { m_machine = machine;  };
 	running_machine &machine() const { return *m_machine; }
 private:
@@ -28,6 +28,8 @@ public:
 
 	// Getters
 	bool recording() const { return m_recording; }
+	uint32_t width() const { return m_width; }
+	uint32_t height() const { return m_height; }
 
 private:
 	void begin_avi_recording(const char *name);
@@ -19,6 +19,8 @@ renderer_gdi::~renderer_gdi()
 	// free the bitmap memory
 	if (m_bmdata != nullptr)
 		global_free_array(m_bmdata);
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 //============================================================
@@ -86,8 +88,10 @@ int renderer_gdi::draw(const int update)
 	}
 
 	// draw the primitives to the bitmap
+	if (m_work_queue == nullptr)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 	win->m_primlist->acquire_lock();
-	software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, m_bmdata, width, height, pitch);
+	software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, m_bmdata, width, height, pitch, m_work_queue);
 	win->m_primlist->release_lock();
 
 	// fill in bitmap-specific info
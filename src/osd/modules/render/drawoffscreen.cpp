@@ -0,0 +1,192 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+//============================================================
+//
+//  drawoffscreen.cpp - software drawing to an in-memory bitmap
+//
+//  Draws the complete render target, artwork and UI
+//  included, at the size given by -resolution (or the
+//  target's native size) on hosts with no display.  The
+//  first window's bitmap feeds the web server's frame
+//  stream.  save() and record() only run from the OSD's
+//  own hotkeys (the Windows snapshot/movie keys, and the
+//  SDL movie key); the core's snapshot and movie commands
+//  still capture through the core's snapshot target.
+//
+//============================================================
+
+// MAME headers
+#include "emu.h"
+#include "png.h"
+#include "rendersw.hxx"
+
+// MAMEOS headers
+#include "drawoffscreen.h"
+#include "aviwrite.h"
+#include "modules/lib/osdobj_common.h"
+
+//============================================================
+//  constructor
+//============================================================
+
+renderer_offscreen::renderer_offscreen(std::shared_ptr<osd_window> window)
+	: osd_renderer(window, FLAG_NONE)
+	, m_work_queue(nullptr)
+	, m_skip(0)
+	, m_skipped(0)
+	, m_http(nullptr)
+{
+}
+
+//============================================================
+//  destructor
+//============================================================
+
+renderer_offscreen::~renderer_offscreen()
+{
+	m_avi_writer.reset();
+	if (m_http != nullptr)
+		m_http->set_frame_source(nullptr);
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
+}
+
+//============================================================
+//  renderer_offscreen::create
+//============================================================
+
+int renderer_offscreen::create()
+{
+	auto win = assert_window();
+	osd_options &options = downcast<osd_options &>(win->machine().options());
+	m_skip = std::max(options.offscreen_skip(), 0);
+
+	m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (m_work_queue == nullptr)
+		return 1;
+
+	// the first window's frames go to the web server's frame stream
+	if (win->m_index == 0 && win->machine().manager().http()->is_active())
+	{
+		m_http = win->machine().manager().http();
+		m_http->set_frame_source(&m_bitmap);
+	}
+	return 0;
+}
+
+//============================================================
+//  renderer_offscreen::frame_size
+//============================================================
+
+osd_dim renderer_offscreen::frame_size() const
+{
+	auto win = assert_window();
+
+	// an explicit -resolution wins; otherwise use the target's native size
+	if (win->m_win_config.width > 0 && win->m_win_config.height > 0)
+		return osd_dim(win->m_win_config.width, win->m_win_config.height);
+
+	s32 width, height;
+	win->target()->compute_minimum_size(width, height);
+	return osd_dim(std::max(width, 1), std::max(height, 1));
+}
+
+//============================================================
+//  renderer_offscreen::get_primitives
+//============================================================
+
+render_primitive_list *renderer_offscreen::get_primitives()
+{
+	auto win = try_getwindow();
+	if (win == nullptr)
+		return nullptr;
+
+	osd_dim const size = frame_size();
+	win->target()->set_bounds(size.width(), size.height(), 1.0f);
+	return &win->target()->get_primitives();
+}
+
+//============================================================
+//  renderer_offscreen::draw
+//============================================================
+
+int renderer_offscreen::draw(const int update)
+{
+	auto win = assert_window();
+
+	// honour -offscreen_skip, but never leave the bitmap empty
+	if (m_skipped < m_skip && m_bitmap.valid())
+	{
+		m_skipped++;
+		return 0;
+	}
+	m_skipped = 0;
+
+	// the bitmap follows the target, which only changes size with the native resolution
+	win->m_primlist->acquire_lock();
+	u32 const width = win->target()->width();
+	u32 const height = win->target()->height();
+	if (m_bitmap.width() != s32(width) || m_bitmap.height() != s32(height))
+		m_bitmap.allocate(width, height);
+	software_renderer<u32, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, &m_bitmap.pix32(0), width, height, m_bitmap.rowpixels(), m_work_queue);
+	win->m_primlist->release_lock();
+
+	// a size change ends the movie, since AVI frames cannot change size
+	if (m_avi_writer != nullptr && m_avi_writer->recording())
+	{
+		if (m_avi_writer->width() == width && m_avi_writer->height() == height)
+			m_avi_writer->video_frame(m_bitmap);
+		else
+			record();
+	}
+	return 0;
+}
+
+//============================================================
+//  renderer_offscreen::save
+//============================================================
+
+void renderer_offscreen::save()
+{
+	auto win = assert_window();
+	running_machine &machine = win->machine();
+	if (!m_bitmap.valid())
+		return;
+
+	emu_file file(machine.options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (machine.video().open_next(file, "png", win->m_index) != osd_file::error::NONE)
+		return;
+
+	std::string const text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+	std::string const text2 = std::string(machine.system().manufacturer).append(" ").append(machine.system().type.fullname());
+	png_info pnginfo;
+	pnginfo.add_text("Software", text1.c_str());
+	pnginfo.add_text("System", text2.c_str());
+
+	png_error const error = png_write_bitmap(file, &pnginfo, m_bitmap, 0, nullptr);
+	if (error != PNGERR_NONE)
+		osd_printf_error("Error generating PNG for offscreen snapshot: png_error = %d\n", error);
+}
+
+//============================================================
+//  renderer_offscreen::record
+//============================================================
+
+void renderer_offscreen::record()
+{
+	auto win = assert_window();
+
+	if (win->m_index > 0)
+		return;
+
+	if (m_avi_writer != nullptr && m_avi_writer->recording())
+	{
+		m_avi_writer->stop();
+		m_avi_writer.reset();
+	}
+	else if (m_bitmap.valid())
+	{
+		m_avi_writer = std::make_unique<avi_write>(win->machine(), m_bitmap.width(), m_bitmap.height());
+		m_avi_writer->record(nullptr);
+	}
+}
@@ -0,0 +1,49 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+//============================================================
+//
+//  drawoffscreen.h - software drawing to an in-memory bitmap
+//
+//============================================================
+
+#pragma once
+
+#ifndef __DRAWOFFSCREEN__
+#define __DRAWOFFSCREEN__
+
+#include "modules/osdwindow.h"
+
+class avi_write;
+
+/* renderer_offscreen draws the window's render target without ever showing it */
+class renderer_offscreen : public osd_renderer
+{
+public:
+	renderer_offscreen(std::shared_ptr<osd_window> window);
+	virtual ~renderer_offscreen();
+
+	static bool init(running_machine &machine) { return false; }
+	static void exit() { }
+
+	virtual int create() override;
+	virtual render_primitive_list *get_primitives() override;
+	virtual int draw(const int update) override;
+	virtual void save() override;
+	virtual void record() override;
+	virtual void toggle_fsfx() override { }
+
+	// the most recently drawn frame
+	const bitmap_rgb32 &frame() const { return m_bitmap; }
+
+private:
+	osd_dim frame_size() const;
+
+	bitmap_rgb32            m_bitmap;           // drawn frame
+	osd_work_queue *        m_work_queue;       // work queue for drawing large frames in bands
+	std::unique_ptr<avi_write> m_avi_writer;    // movie being recorded, if any
+	int                     m_skip;             // frames to skip between drawn frames
+	int                     m_skipped;          // frames skipped since the last one drawn
+	http_manager *          m_http;             // web server we publish frames to, if any
+};
+
+#endif // __DRAWOFFSCREEN__
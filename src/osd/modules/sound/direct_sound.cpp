@@ -68,6 +68,7 @@ public:
 	// sound_module
 	virtual void update_audio_stream(bool is_throttled, int16_t const *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual bool get_buffer_fill(int &queued, int &target) override;
 
 private:
 	class buffer
@@ -372,6 +373,26 @@ void sound_direct_sound::set_mastervolume(int attenuation)
 }
 
 
+//============================================================
+//  get_buffer_fill
+//============================================================
+
+bool sound_direct_sound::get_buffer_fill(int &queued, int &target)
+{
+	if (!m_stream_buffer)
+		return false;
+
+	DWORD play_position, write_position;
+	if (DS_OK != m_stream_buffer.get_current_positions(play_position, write_position))
+		return false;
+
+	DWORD const size = m_stream_buffer.size();
+	queued = ((m_stream_buffer_in + size - play_position) % size) / m_bytes_per_sample;
+	target = size / 2 / m_bytes_per_sample;
+	return true;
+}
+
+
 //============================================================
 //  dsound_init
 //============================================================
@@ -64,6 +64,7 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual bool get_buffer_fill(int &queued, int &target) override;
 
 private:
 	int lock_buffer(bool is_throttled, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2);
@@ -342,6 +343,28 @@ void sound_sdl::set_mastervolume(int _attenuation)
 	}
 }
 
+//============================================================
+//  get_buffer_fill
+//============================================================
+
+bool sound_sdl::get_buffer_fill(int &queued, int &target)
+{
+	if (sample_rate() == 0 || !stream_buffer || !stream_in_initialized)
+		return false;
+
+	// the callback may move the play position under us, so clamp the result
+	int const frame_bytes = sizeof(int16_t) * 2;
+	int32_t const playpos = stream_playpos;
+	int32_t in = stream_buffer_in;
+	if (stream_loop)
+		in += stream_buffer_size;
+	queued = std::max(std::min<int32_t>(in - playpos, stream_buffer_size), 0) / frame_bytes;
+
+	// update_audio_stream starts writing halfway between the write position and the end
+	target = (((sample_rate() / 50) * frame_bytes + stream_buffer_size) / 2) / frame_bytes;
+	return true;
+}
+
 //============================================================
 //  sdl_callback
 //============================================================
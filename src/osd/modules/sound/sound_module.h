@@ -27,6 +27,10 @@ public:
 	virtual void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame) = 0;
 	virtual void set_mastervolume(int attenuation) = 0;
 
+	// sample frames written but not yet played, and the number the module tries
+	// to keep queued; modules that cannot tell return false
+	virtual bool get_buffer_fill(int &queued, int &target) { return false; }
+
 	int sample_rate() const { return m_sample_rate; }
 
 	int m_sample_rate;
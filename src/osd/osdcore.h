@@ -517,9 +517,8 @@ typedef void *(*osd_work_callback)(void *param, int threadid);
                 here are assumed to be fully independent or shared
 
             WORK_QUEUE_FLAG_HIGH_FREQ - indicates that items are expected
-                to be queued at high frequency and acted upon quickly; in
-                general, this implies doing some spin-waiting internally
-                before falling back to OS-specific synchronization
+                to be queued at high frequency and acted upon quickly; such
+                items are picked up ahead of those from ordinary queues
 
     Return value:
 
@@ -530,6 +529,11 @@ typedef void *(*osd_work_callback)(void *param, int threadid);
         A work queue abstracts the notion of how potentially threaded work
         can be performed. If no threading support is available, it is a
         simple matter to execute the work items as they are queued.
+
+        All queues share a single pool of threads. Items from I/O queues
+        are picked up first, then those from high-frequency queues. Queues
+        without WORK_QUEUE_FLAG_MULTI run their items one at a time, in
+        the order they were queued.
 -----------------------------------------------------------------------------*/
 osd_work_queue *osd_work_queue_alloc(int flags);
 
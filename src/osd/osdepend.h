@@ -74,6 +74,10 @@ public:
 	virtual void set_mastervolume(int attenuation) = 0;
 	virtual bool no_sound() = 0;
 
+	/** sample frames queued for output but not yet played, and the fill the
+	 * sound module aims for; returns false if the module cannot tell */
+	virtual bool get_audio_buffer_fill(int &queued, int &target) = 0;
+
 	// input overridables
 	virtual void customize_input_type_list(simple_list<input_type_entry> &typelist) = 0;
 
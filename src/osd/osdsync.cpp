@@ -18,12 +18,15 @@
 #endif
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <thread>
 #include <vector>
 #include <algorithm>
 // MAME headers
 #include "osdcore.h"
 #include "osdsync.h"
+#include "modules/lib/osdlib.h"
 
 #include "eminline.h"
 
@@ -44,8 +47,6 @@
 #define ENV_PROCESSORS               "OSDPROCESSORS"
 #define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
 
-#define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
-
 //============================================================
 //  MACROS
 //============================================================
@@ -60,27 +61,6 @@
 #define end_timing(v)           do { } while (0)
 #endif
 
-template<typename _AtomType, typename _MainType>
-static void spin_while(const volatile _AtomType * volatile atom, const _MainType val, const osd_ticks_t timeout, const int invert = 0)
-{
-	osd_ticks_t stopspin = osd_ticks() + timeout;
-
-	do {
-		int spin = 10000;
-		while (--spin)
-		{
-			if ((*atom != val) ^ invert)
-				return;
-		}
-	} while (((*atom == val) ^ invert) && osd_ticks() < stopspin);
-}
-
-template<typename _AtomType, typename _MainType>
-static void spin_while_not(const volatile _AtomType * volatile atom, const _MainType val, const osd_ticks_t timeout)
-{
-	spin_while<_AtomType, _MainType>(atom, val, timeout, 1);
-}
-
 //============================================================
 //  osd_num_processors
 //============================================================
@@ -100,79 +80,110 @@ int osd_get_num_processors(void)
 //  TYPE DEFINITIONS
 //============================================================
 
+// all queues share one pool of worker threads; items are scheduled in
+// three priority classes, highest first
+enum work_priority
+{
+	PRIORITY_IO = 0,        // I/O queues: mostly blocked, so get them going first
+	PRIORITY_HIGH_FREQ,     // high-frequency queues: someone is usually waiting
+	PRIORITY_NORMAL,        // everything else
+	PRIORITY_COUNT
+};
+
+struct work_pool;
+
 struct work_thread_info
 {
-	work_thread_info(uint32_t aid, osd_work_queue &aqueue)
-	: queue(aqueue)
+	work_thread_info(uint32_t aid, work_pool &apool)
+	: pool(apool)
 	, handle(nullptr)
-	, wakeevent(false, false)  // auto-reset, not signalled
-	, active(0)
 	, id(aid)
 #if KEEP_STATISTICS
 	, itemsdone(0)
+	, steals(0)
+	, sleeps(0)
 	, actruntime(0)
-	, runtime(0)
-	, spintime(0)
 	, waittime(0)
 #endif
 	{
 	}
-	osd_work_queue &    queue;          // pointer back to the queue
+	work_pool &         pool;           // pointer back to the pool
 	std::thread *       handle;         // handle to the thread
-	osd_event           wakeevent;      // wake event for the thread
-	std::atomic<int32_t>  active;         // are we actively processing work?
+	std::mutex          lock;           // lock protecting the deques
+	std::deque<osd_work_item *> deque[PRIORITY_COUNT]; // items owned by this thread
 	uint32_t              id;
 
 #if KEEP_STATISTICS
 	int32_t               itemsdone;
+	int32_t               steals;
+	int32_t               sleeps;
 	osd_ticks_t         actruntime;
-	osd_ticks_t         runtime;
-	osd_ticks_t         spintime;
 	osd_ticks_t         waittime;
 #endif
 };
 
 
+struct work_pool
+{
+	work_pool()
+	: queues(0)
+	, pending(0)
+	, sleepers(0)
+	, exiting(false)
+	, nextthread(0)
+	{
+	}
+
+	std::vector<work_thread_info *>  thread;   // array of worker threads
+	uint32_t              queues;         // number of queues using the pool
+	std::atomic<int32_t>  pending;        // items sitting in deques
+	std::atomic<int32_t>  sleepers;       // number of threads waiting for work
+	std::atomic<bool>     exiting;        // should the threads exit?
+	std::atomic<uint32_t> nextthread;     // round-robin target for outside submissions
+	std::mutex          lock;           // lock for sleeping
+	std::condition_variable wake;       // signalled when work arrives
+};
+
+
 struct osd_work_queue
 {
 	osd_work_queue()
-	: list(nullptr)
-	, tailptr(nullptr)
+	: pool(nullptr)
+	, list(nullptr)
+	, tailptr(&list)
 	, free(nullptr)
 	, items(0)
-	, livethreads(0)
 	, waiting(0)
-	, exiting(0)
+	, scheduled(false)
 	, threads(0)
 	, flags(0)
+	, priority(PRIORITY_NORMAL)
 	, doneevent(true, true)     // manual reset, signalled
 #if KEEP_STATISTICS
 	, itemsqueued(0)
 	, setevents(0)
-	, extraitems(0)
-	, spinloops(0)
+	, helped(0)
 #endif
 	{
 	}
 
+	work_pool *         pool;           // shared pool, or nullptr if items run inline
 	std::mutex          lock;           // lock for protecting the queue
-	std::atomic<osd_work_item *> list;  // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
-	std::atomic<osd_work_item *> free;  // free list of work items
+	osd_work_item *     list;           // serial queues: items waiting behind the scheduled one
+	osd_work_item **    tailptr;        // pointer to the tail pointer of work items in the list
+	osd_work_item *     free;           // free list of work items
 	std::atomic<int32_t>  items;          // items in the queue
-	std::atomic<int32_t>  livethreads;    // number of live threads
 	std::atomic<int32_t>  waiting;        // is someone waiting on the queue to complete?
-	std::atomic<int32_t>  exiting;        // should the threads exit on their next opportunity?
-	uint32_t              threads;        // number of threads in this queue
+	bool                scheduled;      // serial queues: is an item in the pool or running?
+	uint32_t              threads;        // number of threads that may run this queue's items
 	uint32_t              flags;          // creation flags
-	std::vector<work_thread_info *>  thread;         // array of thread information
+	work_priority       priority;       // priority class in the pool
 	osd_event           doneevent;      // event signalled when work is complete
 
 #if KEEP_STATISTICS
 	std::atomic<int32_t>  itemsqueued;    // total items queued
 	std::atomic<int32_t>  setevents;      // number of times we called SetEvent
-	std::atomic<int32_t>  extraitems;     // how many extra items we got after the first in the queue loop
-	std::atomic<int32_t>  spinloops;      // how many times spinning bought us more items
+	std::atomic<int32_t>  helped;         // items run by threads waiting on the queue
 #endif
 };
 
@@ -206,15 +217,23 @@ struct osd_work_item
 //============================================================
 
 int osd_num_processors = 0;
+std::vector<int> osd_work_affinity;
+
+static std::mutex s_pool_lock;          // protects creation and destruction of the pool
+static work_pool *s_pool = nullptr;     // the shared pool, while any queue uses it
+static thread_local work_thread_info *s_current_thread = nullptr;   // pool thread we are running on
 
 //============================================================
 //  FUNCTION PROTOTYPES
 //============================================================
 
 static int effective_num_processors(void);
-static void * worker_thread_entry(void *param);
-static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
-static bool queue_has_list_items(osd_work_queue *queue);
+static work_pool *pool_acquire(void);
+static void pool_release(work_pool *pool);
+static void pool_push(work_pool &pool, osd_work_item *item);
+static osd_work_item *pool_take(work_pool &pool, work_thread_info *thread, osd_work_queue *queue);
+static void worker_thread_entry(work_thread_info *thread);
+static void work_item_run(osd_work_item *item, int threadid);
 
 //============================================================
 //  osd_thread_adjust_priority
@@ -250,75 +269,34 @@ int thread_adjust_priority(std::thread *thread, int adjust)
 
 osd_work_queue *osd_work_queue_alloc(int flags)
 {
-	int threadnum;
 	int numprocs = effective_num_processors();
-	osd_work_queue *queue;
-	int osdthreadnum = 0;
-	int allocthreadnum;
-	const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
 
 	// allocate a new queue
-	queue = new osd_work_queue();
-
-	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
+	osd_work_queue *queue = new osd_work_queue();
 	queue->flags = flags;
-
-	// determine how many threads to create...
-	// on a single-CPU system, create 1 thread for I/O queues, and 0 threads for everything else
-	if (numprocs == 1)
-		threadnum = (flags & WORK_QUEUE_FLAG_IO) ? 1 : 0;
-	// on an n-CPU system, create n-1 threads for multi queues, and 1 thread for everything else
-	else
-		threadnum = (flags & WORK_QUEUE_FLAG_MULTI) ? (numprocs - 1) : 1;
-
-	if (osdworkqueuemaxthreads != nullptr && sscanf(osdworkqueuemaxthreads, "%d", &osdthreadnum) == 1 && threadnum > osdthreadnum)
-		threadnum = osdthreadnum;
-
-	// clamp to the maximum
-	queue->threads = std::min(threadnum, WORK_MAX_THREADS);
-
-	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI)
-	if (flags & WORK_QUEUE_FLAG_MULTI)
-		allocthreadnum = queue->threads + 1;
-	else
-		allocthreadnum = queue->threads;
-
-#if KEEP_STATISTICS
-	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
-#endif
-
-	for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
-		queue->thread.push_back(new work_thread_info(threadnum, *queue));
-
-	// iterate over threads
-	for (threadnum = 0; threadnum < queue->threads; threadnum++)
+	if (flags & WORK_QUEUE_FLAG_IO)
+		queue->priority = PRIORITY_IO;
+	else if (flags & WORK_QUEUE_FLAG_HIGH_FREQ)
+		queue->priority = PRIORITY_HIGH_FREQ;
+
+	// on a single-CPU system only I/O queues get a thread; everything else runs
+	// on the calling thread as it is queued
+	if (numprocs == 1 && !(flags & WORK_QUEUE_FLAG_IO))
+		return queue;
+
+	// attach to the shared pool; an empty pool means threads are disabled
+	work_pool *pool = pool_acquire();
+	if (pool->thread.empty())
 	{
-		work_thread_info *thread = queue->thread[threadnum];
-
-		// create the thread
-		thread->handle = new std::thread(worker_thread_entry, thread);
-		if (thread->handle == nullptr)
-			goto error;
-
-		// set its priority: I/O threads get high priority because they are assumed to be
-		// blocked most of the time; other threads just match the creator's priority
-		if (flags & WORK_QUEUE_FLAG_IO)
-			thread_adjust_priority(thread->handle, 1);
-		else
-			thread_adjust_priority(thread->handle, 0);
+		pool_release(pool);
+		return queue;
 	}
 
-	// start a timer going for "waittime" on the main thread
-	if (flags & WORK_QUEUE_FLAG_MULTI)
-	{
-		begin_timing(queue->thread[queue->threads]->waittime);
-	}
+	// multi queues may use every thread in the pool, everything else runs
+	// its items one at a time in order
+	queue->pool = pool;
+	queue->threads = (flags & WORK_QUEUE_FLAG_MULTI) ? pool->thread.size() : 1;
 	return queue;
-
-error:
-	osd_work_queue_free(queue);
-	return nullptr;
 }
 
 
@@ -340,38 +318,28 @@ int osd_work_queue_items(osd_work_queue *queue)
 bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 {
 	// if no threads, no waiting
-	if (queue->threads == 0)
+	if (queue->pool == nullptr)
 		return true;
 
 	// if no items, we're done
 	if (queue->items == 0)
 		return true;
 
-	// if this is a multi queue, help out rather than doing nothing
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	// help out rather than doing nothing: run whatever items of this queue are
+	// still sitting in the pool; this also keeps pool threads that wait on
+	// another queue from starving it
+	work_pool &pool = *queue->pool;
+	work_thread_info *thread = s_current_thread;
+	int threadid = (thread != nullptr) ? thread->id : pool.thread.size();
+	osd_work_item *item;
+	while ((item = pool_take(pool, thread, queue)) != nullptr)
 	{
-		work_thread_info *thread = queue->thread[queue->threads];
-
-		end_timing(thread->waittime);
-
-		// process what we can as a worker thread
-		worker_thread_process(queue, thread);
-
-		// if we're a high frequency queue, spin until done
-		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
-		{
-			// spin until we're done
-			begin_timing(thread->spintime);
-			spin_while_not<std::atomic<int>,int>(&queue->items, 0, timeout);
-			end_timing(thread->spintime);
-
-			begin_timing(thread->waittime);
-			return (queue->items == 0);
-		}
-		begin_timing(thread->waittime);
+		add_to_stat(queue->helped, 1);
+		work_item_run(item, threadid);
 	}
 
-	// reset our done event and double-check the items before waiting
+	// reset our done event and double-check the items before waiting for the
+	// ones still running elsewhere
 	queue->doneevent.reset();
 	queue->waiting = true;
 	if (queue->items != 0)
@@ -389,80 +357,33 @@ bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 
 void osd_work_queue_free(osd_work_queue *queue)
 {
-	// stop the timer for "waittime" on the main thread
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
-	{
-		end_timing(queue->thread[queue->threads]->waittime);
-	}
+	// let everything already queued finish
+	while (!osd_work_queue_wait(queue, OSD_EVENT_WAIT_INFINITE)) { }
 
-	// signal all the threads to exit
-	queue->exiting = true;
-	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
+	// the last item may still be signalling us; wait for it to let go
 	{
-		work_thread_info *thread = queue->thread[threadnum];
-		thread->wakeevent.set();
-	}
-
-	// wait for all the threads to go away
-	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
-	{
-		work_thread_info *thread = queue->thread[threadnum];
-
-		// block on the thread going away, then close the handle
-		if (thread->handle != nullptr)
-		{
-			thread->handle->join();
-			delete thread->handle;
-		}
-
+		std::lock_guard<std::mutex> lock(queue->lock);
 	}
 
 #if KEEP_STATISTICS
-	// output per-thread statistics
-	for (work_thread_info *thread : queue->thread)
-	{
-		osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-		printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-				thread->id, thread->itemsdone,
-				(double)thread->runtime * 100.0 / (double)total,
-				(double)thread->actruntime * 100.0 / (double)total,
-				(double)thread->spintime * 100.0 / (double)total,
-				(double)thread->waittime * 100.0 / (double)total,
-				(uint32_t) total);
-	}
+	printf("Items queued   = %9d\n", queue->itemsqueued.load());
+	printf("SetEvent calls = %9d\n", queue->setevents.load());
+	printf("Helped items   = %9d\n", queue->helped.load());
 #endif
 
-	// free the list
-	for (auto & th : queue->thread)
-		delete th;
-	queue->thread.clear();
-
 	// free all items in the free list
-	while (queue->free.load() != nullptr)
+	while (queue->free != nullptr)
 	{
-		osd_work_item *item = (osd_work_item *)queue->free;
+		osd_work_item *item = queue->free;
 		queue->free = item->next;
 		if (item->event != nullptr)
 			delete item->event;
 		delete item;
 	}
 
-	// free all items in the active list
-	while (queue->list.load() != nullptr)
-	{
-		osd_work_item *item = (osd_work_item *)queue->list;
-		queue->list = item->next;
-		if (item->event != nullptr)
-			delete item->event;
-		delete item;
-	}
-
-#if KEEP_STATISTICS
-	printf("Items queued   = %9d\n", queue->itemsqueued.load());
-	printf("SetEvent calls = %9d\n", queue->setevents.load());
-	printf("Extra items    = %9d\n", queue->extraitems.load());
-	printf("Spin loops     = %9d\n", queue->spinloops.load());
-#endif
+	// detach from the pool; the last queue shuts it down
+	if (queue->pool != nullptr)
+		pool_release(queue->pool);
 
 	// free the queue itself
 	delete queue;
@@ -487,24 +408,16 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		// first allocate a new work item; try the free list first
 		{
 			std::lock_guard<std::mutex> lock(queue->lock);
-			do
-			{
-				item = (osd_work_item *)queue->free;
-			} while (item != nullptr && !queue->free.compare_exchange_weak(item, item->next, std::memory_order_release, std::memory_order_relaxed));
+			item = queue->free;
+			if (item != nullptr)
+				queue->free = item->next;
 		}
 
 		// if nothing, allocate something new
 		if (item == nullptr)
-		{
-			// allocate the item
 			item = new osd_work_item(*queue);
-			if (item == nullptr)
-				return nullptr;
-		}
 		else
-		{
-			item->done = false; // needs to be set this way to prevent data race/usage of uninitialized memory on Linux
-		}
+			item->done = false;
 
 		// fill in the basics
 		item->next = nullptr;
@@ -520,49 +433,56 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		parambase = (uint8_t *)parambase + paramstep;
 	}
 
-	// enqueue the whole thing within the critical section
-	{
-		std::lock_guard<std::mutex> lock(queue->lock);
-		*queue->tailptr = itemlist;
-		queue->tailptr = item_tailptr;
-	}
+	// only return the item if it won't get released automatically
+	osd_work_item *result = (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? nullptr : lastitem;
 
 	// increment the number of items in the queue
 	queue->items += numitems;
 	add_to_stat(queue->itemsqueued, numitems);
 
-	// look for free threads to do the work
-	if (queue->livethreads < queue->threads)
+	// if no threads, run the items now on this thread
+	if (queue->pool == nullptr)
 	{
-		int threadnum;
-
-		// iterate over all the threads
-		for (threadnum = 0; threadnum < queue->threads; threadnum++)
+		while (itemlist != nullptr)
 		{
-			work_thread_info *thread = queue->thread[threadnum];
-
-			// if this thread is not active, wake him up
-			if (!thread->active)
-			{
-				thread->wakeevent.set();
-				add_to_stat(queue->setevents, 1);
+			osd_work_item *item = itemlist;
+			itemlist = item->next;
+			work_item_run(item, 0);
+		}
+		return result;
+	}
 
-				// for non-shared, the first one we find is good enough
-				if (--numitems == 0)
-					break;
-			}
+	// multi queue items go straight to the pool where any thread can take them
+	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	{
+		while (itemlist != nullptr)
+		{
+			osd_work_item *item = itemlist;
+			itemlist = item->next;
+			pool_push(*queue->pool, item);
 		}
+		return result;
 	}
 
-	// if no threads, run the queue now on this thread
-	if (queue->threads == 0)
+	// serial queues keep their own list and only ever have one item in the
+	// pool, which keeps them in order and off more than one thread
+	osd_work_item *first = nullptr;
 	{
-		end_timing(queue->thread[0]->waittime);
-		worker_thread_process(queue, queue->thread[0]);
-		begin_timing(queue->thread[0]->waittime);
+		std::lock_guard<std::mutex> lock(queue->lock);
+		*queue->tailptr = itemlist;
+		queue->tailptr = item_tailptr;
+		if (!queue->scheduled)
+		{
+			first = queue->list;
+			queue->list = first->next;
+			if (queue->list == nullptr)
+				queue->tailptr = &queue->list;
+			queue->scheduled = true;
+		}
 	}
-	// only return the item if it won't get released automatically
-	return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? nullptr : lastitem;
+	if (first != nullptr)
+		pool_push(*queue->pool, first);
+	return result;
 }
 
 
@@ -577,23 +497,16 @@ bool osd_work_item_wait(osd_work_item *item, osd_ticks_t timeout)
 		return true;
 
 	// if we don't have an event, create one
-	if (item->event == nullptr)
 	{
 		std::lock_guard<std::mutex> lock(item->queue.lock);
-		item->event = new osd_event(true, false);     // manual reset, not signalled
-	}
-	else
-		item->event->reset();
-
-	// if we don't have an event, we need to spin (shouldn't ever really happen)
-	if (item->event == nullptr)
-	{
-		// TODO: do we need to measure the spin time here as well? and how can we do it?
-		spin_while<std::atomic<int>,int>(&item->done, 0, timeout);
+		if (item->event == nullptr)
+			item->event = new osd_event(true, false);     // manual reset, not signalled
+		else
+			item->event->reset();
 	}
 
-	// otherwise, block on the event until done
-	else if (!item->done)
+	// block on the event until done
+	if (!item->done)
 		item->event->wait(timeout);
 
 	// return true if the refcount actually hit 0
@@ -617,18 +530,13 @@ void *osd_work_item_result(osd_work_item *item)
 
 void osd_work_item_release(osd_work_item *item)
 {
-	osd_work_item *next;
-
 	// make sure we're done first
 	osd_work_item_wait(item, 100 * osd_ticks_per_second());
 
 	// add us to the free list on our queue
 	std::lock_guard<std::mutex> lock(item->queue.lock);
-	do
-	{
-		next = (osd_work_item *) item->queue.free;
-		item->next = next;
-	} while (!item->queue.free.compare_exchange_weak(next, item, std::memory_order_release, std::memory_order_relaxed));
+	item->next = item->queue.free;
+	item->queue.free = item;
 }
 
 
@@ -662,155 +570,271 @@ static int effective_num_processors(void)
 
 
 //============================================================
-//  worker_thread_entry
+//  pool_acquire
 //============================================================
 
-static void *worker_thread_entry(void *param)
+static work_pool *pool_acquire(void)
 {
-	work_thread_info *thread = (work_thread_info *)param;
-	osd_work_queue &queue = thread->queue;
+	std::lock_guard<std::mutex> lock(s_pool_lock);
 
-	// loop until we exit
-	for ( ;; )
+	// the first queue creates the pool
+	if (s_pool == nullptr)
 	{
-		// block waiting for work or exit
-		// bail on exit, and only wait if there are no pending items in queue
-		if (queue.exiting)
-			break;
+		int numprocs = effective_num_processors();
+		int osdthreadnum = 0;
+		const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
 
-		if (!queue_has_list_items(&queue))
-		{
-			begin_timing(thread->waittime);
-			thread->wakeevent.wait( OSD_EVENT_WAIT_INFINITE);
-			end_timing(thread->waittime);
-		}
+		// n-1 threads leave a processor for the thread feeding them; keep one
+		// thread even on a single CPU so I/O can overlap with emulation
+		int threadnum = std::max(numprocs - 1, 1);
+		if (osdworkqueuemaxthreads != nullptr && sscanf(osdworkqueuemaxthreads, "%d", &osdthreadnum) == 1 && threadnum > osdthreadnum)
+			threadnum = std::max(osdthreadnum, 0);
 
-		if (queue.exiting)
-			break;
+		// clamp to the maximum, leaving one thread ID for threads that help out
+		threadnum = std::min(threadnum, WORK_MAX_THREADS - 1);
 
-		// indicate that we are live
-		thread->active = true;
-		++queue.livethreads;
+#if KEEP_STATISTICS
+		printf("osdprocs: %d effecprocs: %d osdthreads: %d maxthreads: %d poolthreads: %d\n", osd_num_processors, numprocs, osdthreadnum, WORK_MAX_THREADS, threadnum);
+#endif
 
-		// process work items
-		for ( ;; )
-		{
-			// process as much as we can
-			worker_thread_process(&queue, thread);
+		s_pool = new work_pool();
+		for (int index = 0; index < threadnum; index++)
+			s_pool->thread.push_back(new work_thread_info(index, *s_pool));
+		for (work_thread_info *thread : s_pool->thread)
+			thread->handle = new std::thread(worker_thread_entry, thread);
+	}
 
-			// if we're a high frequency queue, spin for a while before giving up
-			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue.list.load() == nullptr)
-			{
-				// spin for a while looking for more work
-				begin_timing(thread->spintime);
-				spin_while<std::atomic<osd_work_item *>, osd_work_item *>(&queue.list, (osd_work_item *)nullptr, SPIN_LOOP_TIME);
-				end_timing(thread->spintime);
-			}
+	s_pool->queues++;
+	return s_pool;
+}
 
-			// if nothing more, release the processor
-			if (!queue_has_list_items(&queue))
-				break;
-			add_to_stat(queue.spinloops, 1);
-		}
 
-		// decrement the live thread count
-		thread->active = false;
-		--queue.livethreads;
+//============================================================
+//  pool_release
+//============================================================
+
+static void pool_release(work_pool *pool)
+{
+	std::lock_guard<std::mutex> lock(s_pool_lock);
+
+	// the last queue shuts the pool down
+	if (--pool->queues != 0)
+		return;
+
+	// signal all the threads to exit
+	{
+		std::lock_guard<std::mutex> sleeplock(pool->lock);
+		pool->exiting = true;
 	}
+	pool->wake.notify_all();
 
-	return nullptr;
+	// wait for all the threads to go away before freeing any of them, since a
+	// thread still looking for work may be stealing from another's deque
+	for (work_thread_info *thread : pool->thread)
+		thread->handle->join();
+
+	for (work_thread_info *thread : pool->thread)
+	{
+		delete thread->handle;
+
+#if KEEP_STATISTICS
+		osd_ticks_t total = thread->actruntime + thread->waittime;
+		printf("Thread %d:  items=%9d steals=%9d sleeps=%9d run=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
+				thread->id, thread->itemsdone, thread->steals, thread->sleeps,
+				(double)thread->actruntime * 100.0 / (double)total,
+				(double)thread->waittime * 100.0 / (double)total,
+				(uint32_t) total);
+#endif
+		delete thread;
+	}
+
+	s_pool = nullptr;
+	delete pool;
 }
 
 
 //============================================================
-//  worker_thread_process
+//  pool_push
 //============================================================
 
-static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread)
+static void pool_push(work_pool &pool, osd_work_item *item)
 {
-	int threadid = thread->id;
+	// pool threads keep what they queue, so nested work stays local; anyone
+	// else deals items out round-robin
+	work_thread_info *thread = s_current_thread;
+	if (thread == nullptr || &thread->pool != &pool)
+		thread = pool.thread[pool.nextthread++ % pool.thread.size()];
 
-	begin_timing(thread->runtime);
+	{
+		std::lock_guard<std::mutex> lock(thread->lock);
+		thread->deque[item->queue.priority].push_back(item);
+	}
+	++pool.pending;
 
-	// loop until everything is processed
-	while (true)
+	// wake a sleeping thread; the lock closes the window between a thread
+	// checking for work and going to sleep
+	if (pool.sleepers != 0)
 	{
-		osd_work_item *item = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(pool.lock);
+		}
+		pool.wake.notify_one();
+	}
+}
 
-		bool end_loop = false;
 
-		// use a critical section to synchronize the removal of items
-		{
-			std::lock_guard<std::mutex> lock(queue->lock);
+//============================================================
+//  pool_take - take the highest-priority item,
+//  preferring the thread's own deque and stealing
+//  from the others; if queue is given, only its
+//  items are taken
+//============================================================
+
+static osd_work_item *pool_take(work_pool &pool, work_thread_info *thread, osd_work_queue *queue)
+{
+	if (pool.pending == 0)
+		return nullptr;
 
-			if (queue->list.load() == nullptr)
+	int const count = pool.thread.size();
+	int const start = (thread != nullptr) ? thread->id : 0;
+	int const firstpriority = (queue != nullptr) ? queue->priority : 0;
+	int const lastpriority = (queue != nullptr) ? queue->priority : PRIORITY_COUNT - 1;
+
+	for (int priority = firstpriority; priority <= lastpriority; priority++)
+	{
+		for (int index = 0; index < count; index++)
+		{
+			work_thread_info &victim = *pool.thread[(start + index) % count];
+			bool const own = (&victim == thread);
+			std::lock_guard<std::mutex> lock(victim.lock);
+			std::deque<osd_work_item *> &deque = victim.deque[priority];
+			if (deque.empty())
+				continue;
+
+			osd_work_item *item = nullptr;
+			if (queue != nullptr)
 			{
-				end_loop = true;
+				// pick out the oldest item of this queue
+				auto const found = std::find_if(deque.begin(), deque.end(), [queue] (osd_work_item *entry) { return &entry->queue == queue; });
+				if (found == deque.end())
+					continue;
+				item = *found;
+				deque.erase(found);
+			}
+			else if (own)
+			{
+				// our own items come off the front, in the order they were queued
+				item = deque.front();
+				deque.pop_front();
 			}
 			else
 			{
-				// pull the item from the queue
-				item = (osd_work_item *)queue->list;
-				if (item != nullptr)
-				{
-					queue->list = item->next;
-					if (queue->list.load() == nullptr)
-						queue->tailptr = (osd_work_item **)&queue->list;
-				}
+				// steal from the back, away from the owner
+				item = deque.back();
+				deque.pop_back();
+				if (thread != nullptr)
+					add_to_stat(thread->steals, 1);
 			}
+			--pool.pending;
+			return item;
 		}
+	}
+	return nullptr;
+}
 
-		if (end_loop)
-			break;
 
-		// process non-NULL items
+//============================================================
+//  worker_thread_entry
+//============================================================
+
+static void worker_thread_entry(work_thread_info *thread)
+{
+	work_pool &pool = thread->pool;
+	s_current_thread = thread;
+
+	// keep to the CPUs we were given, if any
+	if (!osd_work_affinity.empty())
+		osd_thread_set_affinity(osd_work_affinity);
+
+	// loop until we exit
+	for ( ;; )
+	{
+		// process as much as we can
+		osd_work_item *item = pool_take(pool, thread, nullptr);
 		if (item != nullptr)
 		{
-			// call the callback and stash the result
 			begin_timing(thread->actruntime);
-			item->result = (*item->callback)(item->param, threadid);
+			work_item_run(item, thread->id);
 			end_timing(thread->actruntime);
-
-			// decrement the item count after we are done
-			--queue->items;
-			item->done = true;
 			add_to_stat(thread->itemsdone, 1);
+			continue;
+		}
 
-			// if it's an auto-release item, release it
-			if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
-				osd_work_item_release(item);
+		// nothing anywhere: sleep until something is queued rather than spin
+		std::unique_lock<std::mutex> lock(pool.lock);
+		if (pool.exiting)
+			break;
+		++pool.sleepers;
+		if (pool.pending == 0)
+		{
+			add_to_stat(thread->sleeps, 1);
+			begin_timing(thread->waittime);
+			pool.wake.wait(lock, [&pool] { return pool.exiting || pool.pending != 0; });
+			end_timing(thread->waittime);
+		}
+		--pool.sleepers;
+	}
+}
 
-			// set the result and signal the event
-			else
-			{
-				std::lock_guard<std::mutex> lock(queue->lock);
 
-				if (item->event != nullptr)
-				{
-					item->event->set();
-					add_to_stat(item->queue.setevents, 1);
-				}
-			}
+//============================================================
+//  work_item_run
+//============================================================
 
-			// if we removed an item and there's still work to do, bump the stats
-			if (queue_has_list_items(queue))
-				add_to_stat(queue->extraitems, 1);
-		}
-	}
+static void work_item_run(osd_work_item *item, int threadid)
+{
+	osd_work_queue &queue = item->queue;
 
-	// we don't need to set the doneevent for multi queues because they spin
-	if (queue->waiting)
+	for ( ; item != nullptr; )
 	{
-		queue->doneevent.set();
-		add_to_stat(queue->setevents, 1);
-	}
+		// call the callback and stash the result
+		item->result = (*item->callback)(item->param, threadid);
 
-	end_timing(thread->runtime);
-}
+		std::lock_guard<std::mutex> lock(queue.lock);
+		item->done = true;
 
-bool queue_has_list_items(osd_work_queue *queue)
-{
-	std::lock_guard<std::mutex> lock(queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+		// if it's an auto-release item, release it, otherwise signal its event
+		if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
+		{
+			item->next = queue.free;
+			queue.free = item;
+		}
+		else if (item->event != nullptr)
+		{
+			item->event->set();
+			add_to_stat(queue.setevents, 1);
+		}
+
+		// serial queues run the next item straight away on this thread
+		item = nullptr;
+		if (queue.scheduled)
+		{
+			item = queue.list;
+			if (item != nullptr)
+			{
+				queue.list = item->next;
+				if (queue.list == nullptr)
+					queue.tailptr = &queue.list;
+			}
+			else
+				queue.scheduled = false;
+		}
+
+		// decrement the item count after we are done
+		if (--queue.items == 0 && queue.waiting)
+		{
+			queue.doneevent.set();
+			add_to_stat(queue.setevents, 1);
+		}
+	}
 }
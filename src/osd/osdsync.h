@@ -13,9 +13,13 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <vector>
 
 #include "osdcomm.h"
 
+/* CPUs the work queue threads are restricted to; empty for no restriction */
+extern std::vector<int> osd_work_affinity;
+
 /***************************************************************************
     SYNCHRONIZATION INTERFACES - Events
 ***************************************************************************/
@@ -217,6 +217,12 @@ void sdl_osd_interface::extract_video_config()
 		if (!emulator_info::standalone() && options().seconds_to_run() == 0)
 			osd_printf_warning("Warning: -video none doesn't make much sense without -seconds_to_run\n");
 	}
+	else if (strcmp(stemp, OSDOPTVAL_OFFSCREEN) == 0)
+	{
+		// the window is never shown, so it must not take over the display
+		video_config.mode = VIDEO_MODE_OFFSCREEN;
+		video_config.windowed = true;
+	}
 #if (USE_OPENGL)
 	else if (strcmp(stemp, SDLOPTVAL_OPENGL) == 0)
 		video_config.mode = VIDEO_MODE_OPENGL;
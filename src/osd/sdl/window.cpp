@@ -37,6 +37,7 @@
 #include "modules/render/drawbgfx.h"
 #include "modules/render/drawsdl.h"
 #include "modules/render/draw13.h"
+#include "modules/render/drawoffscreen.h"
 #include "modules/monitor/monitor_common.h"
 #if (USE_OPENGL)
 #include "modules/render/drawogl.h"
@@ -108,6 +109,9 @@ bool sdl_osd_interface::window_init()
 		case VIDEO_MODE_SOFT:
 			renderer_sdl1::init(machine());
 			break;
+		case VIDEO_MODE_OFFSCREEN:
+			renderer_offscreen::init(machine());
+			break;
 	}
 
 	/* We may want to set a number of the hints SDL2 provides.
@@ -198,6 +202,9 @@ void sdl_osd_interface::window_exit()
 		case VIDEO_MODE_SOFT:
 			renderer_sdl1::exit();
 			break;
+		case VIDEO_MODE_OFFSCREEN:
+			renderer_offscreen::exit();
+			break;
 		case VIDEO_MODE_BGFX:
 			renderer_bgfx::exit();
 			break;
@@ -739,6 +746,10 @@ int sdl_window_info::complete_create()
 	m_extra_flags |= (fullscreen() ?
 			SDL_WINDOW_BORDERLESS | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_FULLSCREEN : SDL_WINDOW_RESIZABLE);
 
+	// offscreen drawing never shows the window, so "-videodriver dummy" works without a display
+	if (video_config.mode == VIDEO_MODE_OFFSCREEN)
+		m_extra_flags = SDL_WINDOW_HIDDEN;
+
 #if defined(SDLMAME_WIN32)
 	SDL_SetHint(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS, "0");
 #endif
@@ -792,10 +803,13 @@ int sdl_window_info::complete_create()
 
 	// show window
 
-	SDL_ShowWindow(platform_window());
-	//SDL_SetWindowFullscreen(window->sdl_window(), 0);
-	//SDL_SetWindowFullscreen(window->sdl_window(), window->fullscreen());
-	SDL_RaiseWindow(platform_window());
+	if (video_config.mode != VIDEO_MODE_OFFSCREEN)
+	{
+		SDL_ShowWindow(platform_window());
+		//SDL_SetWindowFullscreen(window->sdl_window(), 0);
+		//SDL_SetWindowFullscreen(window->sdl_window(), window->fullscreen());
+		SDL_RaiseWindow(platform_window());
+	}
 
 #ifdef SDLMAME_WIN32
 	if (fullscreen())
@@ -63,7 +63,7 @@ bool windows_osd_interface::video_init()
 		win_window_info::create(machine(), index, m_monitor_module->pick_monitor(options, index), &windows[index]);
 	}
 
-	if (video_config.mode != VIDEO_MODE_NONE)
+	if (video_config.mode != VIDEO_MODE_NONE && video_config.mode != VIDEO_MODE_OFFSCREEN)
 		SetForegroundWindow(std::static_pointer_cast<win_window_info>(osd_common_t::s_window_list.front())->platform_window());
 
 	return true;
@@ -172,6 +172,12 @@ void windows_osd_interface::extract_video_config()
 		if (!emulator_info::standalone() && options().seconds_to_run() == 0)
 			osd_printf_warning("Warning: -video none doesn't make much sense without -seconds_to_run\n");
 	}
+	else if (strcmp(stemp, OSDOPTVAL_OFFSCREEN) == 0)
+	{
+		// the window is never shown, so it must not take over the display
+		video_config.mode = VIDEO_MODE_OFFSCREEN;
+		video_config.windowed = TRUE;
+	}
 #if (USE_OPENGL)
 	else if (strcmp(stemp, "opengl") == 0)
 		video_config.mode = VIDEO_MODE_OPENGL;
@@ -41,6 +41,7 @@ using namespace Windows::UI::Core;
 
 #include "modules/render/drawbgfx.h"
 #include "modules/render/drawnone.h"
+#include "modules/render/drawoffscreen.h"
 #include "modules/render/drawd3d.h"
 #include "modules/render/drawgdi.h"
 #if (USE_OPENGL)
@@ -155,7 +156,8 @@ bool windows_osd_interface::window_init()
 #else
 		VIDEO_MODE_GDI,     // D3D -> GDI
 #endif
-		-1                  // No SOFT on Windows OSD
+		-1,                 // No SOFT on Windows OSD
+		VIDEO_MODE_NONE     // OFFSCREEN -> NONE
 	};
 
 	int current_mode = video_config.mode;
@@ -187,6 +189,9 @@ bool windows_osd_interface::window_init()
 			case VIDEO_MODE_SOFT:
 				fatalerror("SDL1 renderer unavailable on Windows OSD.");
 				break;
+			case VIDEO_MODE_OFFSCREEN:
+				error = renderer_offscreen::init(machine());
+				break;
 			default:
 				fatalerror("Unknown video mode.");
 				break;
@@ -288,6 +293,9 @@ void windows_osd_interface::window_exit()
 		case VIDEO_MODE_D3D:
 			renderer_d3d9::exit();
 			break;
+		case VIDEO_MODE_OFFSCREEN:
+			renderer_offscreen::exit();
+			break;
 		default:
 			break;
 	}
@@ -1080,8 +1088,8 @@ int win_window_info::complete_create()
 	// set a pointer back to us
 	SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)this);
 
-	// skip the positioning stuff for -video none */
-	if (video_config.mode == VIDEO_MODE_NONE)
+	// skip the positioning stuff for -video none and -video offscreen */
+	if (video_config.mode == VIDEO_MODE_NONE || video_config.mode == VIDEO_MODE_OFFSCREEN)
 	{
 		set_renderer(osd_renderer::make_for_type(video_config.mode, shared_from_this()));
 		renderer().create();
@@ -1811,7 +1819,7 @@ void win_window_info::set_fullscreen(int fullscreen)
 	// show ourself
 	if (!this->fullscreen() || m_fullscreen_safe)
 	{
-		if (video_config.mode != VIDEO_MODE_NONE)
+		if (video_config.mode != VIDEO_MODE_NONE && video_config.mode != VIDEO_MODE_OFFSCREEN)
 			ShowWindow(platform_window(), SW_SHOW);
 
 		set_renderer(osd_renderer::make_for_type(video_config.mode, shared_from_this()));
@@ -0,0 +1,381 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    covtool.cpp
+
+    Coverage file utility: summarizes files saved with the debugger's
+    coversave command, lists covered address ranges, renders access
+    heatmaps as PNG images and compares runs.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "osdcore.h"
+#include "coverage.h"
+#include "png.h"
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef std::vector<std::unique_ptr<util::coverage_map>> map_list;
+
+struct coverage_file
+{
+	std::string tag;
+	map_list    maps;
+};
+
+/***************************************************************************
+    IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    load_file - load a coverage file, reporting
+    errors
+-------------------------------------------------*/
+
+static bool load_file(const char *filename, coverage_file &file)
+{
+	util::core_file::ptr fp;
+	if (util::core_file::open(filename, OPEN_FLAG_READ, fp) != osd_file::error::NONE)
+	{
+		fprintf(stderr, "Error opening '%s'\n", filename);
+		return false;
+	}
+
+	switch (util::coverage_map::load(*fp, file.tag, file.maps))
+	{
+	case util::coverage_error::NONE:
+		return true;
+	case util::coverage_error::BAD_SIGNATURE:
+		fprintf(stderr, "'%s' is not a coverage file\n", filename);
+		return false;
+	case util::coverage_error::UNSUPPORTED_VERSION:
+		fprintf(stderr, "'%s' uses an unsupported coverage file version\n", filename);
+		return false;
+	default:
+		fprintf(stderr, "'%s' is truncated or corrupt\n", filename);
+		return false;
+	}
+}
+
+
+/*-------------------------------------------------
+    find_map - find a space by name, or the first
+    one if no name is given
+-------------------------------------------------*/
+
+static const util::coverage_map *find_map(const coverage_file &file, const char *name)
+{
+	for (auto &map : file.maps)
+		if (name == nullptr || map->name() == name)
+			return map.get();
+	fprintf(stderr, "No space '%s' in coverage for '%s'\n", name ? name : "", file.tag.c_str());
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    parse_type - parse an access type name
+-------------------------------------------------*/
+
+static bool parse_type(const char *name, util::coverage_map::access_type &type)
+{
+	if (!strcmp(name, "read"))
+		type = util::coverage_map::READ;
+	else if (!strcmp(name, "write"))
+		type = util::coverage_map::WRITE;
+	else if (!strcmp(name, "exec"))
+		type = util::coverage_map::EXEC;
+	else
+	{
+		fprintf(stderr, "Unknown access type '%s'; expected read, write or exec\n", name);
+		return false;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    for_each_range - call back with each run of
+    consecutive addresses matching a predicate;
+    pages neither map touched are skipped, or
+    matched whole when absent_matches is set
+-------------------------------------------------*/
+
+static void for_each_range(const util::coverage_map &map, const util::coverage_map *other, bool absent_matches, const std::function<bool (std::uint32_t)> &match, const std::function<void (std::uint32_t, std::uint32_t)> &range)
+{
+	bool inrange = false;
+	std::uint32_t start = 0, last = 0;
+	auto const add = [&] (std::uint32_t first, std::uint32_t end)
+	{
+		if (inrange && first == last + 1)
+		{
+			last = end;
+			return;
+		}
+		if (inrange)
+			range(start, last);
+		inrange = true;
+		start = first;
+		last = end;
+	};
+
+	for (std::uint32_t number = 0; number < map.page_count(); number++)
+	{
+		std::uint32_t const base = number << util::coverage_map::PAGE_BITS;
+		if (!map.find_page(number) && (!other || !other->find_page(number)))
+		{
+			if (absent_matches)
+				add(base, base + util::coverage_map::PAGE_SIZE - 1);
+			continue;
+		}
+		for (std::uint32_t offset = 0; offset < util::coverage_map::PAGE_SIZE; offset++)
+			if (match(base + offset))
+				add(base + offset, base + offset);
+	}
+	if (inrange)
+		range(start, last);
+}
+
+
+/*-------------------------------------------------
+    print_range - print one address range
+-------------------------------------------------*/
+
+static void print_range(const util::coverage_map &map, std::uint32_t start, std::uint32_t end)
+{
+	int digits = 1;
+	while (digits < 8 && (map.addrmask() >> (4 * digits)) != 0)
+		digits++;
+	if (start == end)
+		printf("  %0*X\n", digits, start);
+	else
+		printf("  %0*X-%0*X (%u)\n", digits, start, digits, end, end - start + 1);
+}
+
+
+/*-------------------------------------------------
+    do_info - summarize a coverage file
+-------------------------------------------------*/
+
+static int do_info(const char *filename)
+{
+	coverage_file file;
+	if (!load_file(filename, file))
+		return 1;
+
+	printf("Coverage for '%s'\n", file.tag.c_str());
+	for (auto &map : file.maps)
+	{
+		std::uint32_t pages = 0;
+		for (std::uint32_t number = 0; number < map->page_count(); number++)
+			if (map->find_page(number))
+				pages++;
+		printf("  %-10s mask %08X, %u pages touched: %llu read, %llu written, %llu executed\n",
+				map->name().c_str(), map->addrmask(), pages,
+				(unsigned long long)map->touched_count(util::coverage_map::READ),
+				(unsigned long long)map->touched_count(util::coverage_map::WRITE),
+				(unsigned long long)map->touched_count(util::coverage_map::EXEC));
+	}
+	return 0;
+}
+
+
+/*-------------------------------------------------
+    do_ranges - list ranges that saw (or, with
+    unused, never saw) a type of access
+-------------------------------------------------*/
+
+static int do_ranges(const char *filename, const char *type_name, const char *space, bool unused)
+{
+	util::coverage_map::access_type type;
+	coverage_file file;
+	if (!parse_type(type_name, type) || !load_file(filename, file))
+		return 1;
+	const util::coverage_map *const map = find_map(file, space);
+	if (map == nullptr)
+		return 1;
+
+	printf("%s addresses %s in %s:\n", type_name, unused ? "never accessed" : "accessed", map->name().c_str());
+	for_each_range(*map, nullptr, unused,
+			[map, type, unused] (std::uint32_t address) { return map->touched(type, address) != unused; },
+			[map] (std::uint32_t start, std::uint32_t end) { print_range(*map, start, end); });
+	return 0;
+}
+
+
+/*-------------------------------------------------
+    do_compare - list addresses covered by only one
+    of two runs
+-------------------------------------------------*/
+
+static int do_compare(const char *basename, const char *newname, const char *space)
+{
+	coverage_file basefile, newfile;
+	if (!load_file(basename, basefile) || !load_file(newname, newfile))
+		return 1;
+	const util::coverage_map *const basemap = find_map(basefile, space);
+	const util::coverage_map *const newmap = find_map(newfile, space);
+	if (basemap == nullptr || newmap == nullptr)
+		return 1;
+	if (basemap->addrmask() != newmap->addrmask())
+	{
+		fprintf(stderr, "Spaces have different address masks (%08X and %08X)\n", basemap->addrmask(), newmap->addrmask());
+		return 1;
+	}
+
+	static const char *const names[] = { "read", "write", "exec" };
+	for (int t = 0; t < util::coverage_map::TYPE_COUNT; t++)
+	{
+		auto const type = util::coverage_map::access_type(t);
+		std::uint64_t gained = 0, lost = 0;
+		printf("%s only in %s:\n", names[t], newname);
+		for_each_range(*newmap, basemap, false,
+				[basemap, newmap, type] (std::uint32_t address) { return newmap->touched(type, address) && !basemap->touched(type, address); },
+				[newmap, &gained] (std::uint32_t start, std::uint32_t end) { print_range(*newmap, start, end); gained += end - start + 1; });
+		printf("%s only in %s:\n", names[t], basename);
+		for_each_range(*basemap, newmap, false,
+				[basemap, newmap, type] (std::uint32_t address) { return basemap->touched(type, address) && !newmap->touched(type, address); },
+				[basemap, &lost] (std::uint32_t start, std::uint32_t end) { print_range(*basemap, start, end); lost += end - start + 1; });
+		printf("%s: %llu addresses gained, %llu lost\n\n", names[t], (unsigned long long)gained, (unsigned long long)lost);
+	}
+	return 0;
+}
+
+
+/*-------------------------------------------------
+    do_heatmap - render one row of cells per touched
+    page, with writes in red, execution in green and
+    reads in blue on a logarithmic scale
+-------------------------------------------------*/
+
+static int do_heatmap(const char *filename, const char *outname, const char *space, int scale)
+{
+	coverage_file file;
+	if (!load_file(filename, file))
+		return 1;
+	const util::coverage_map *const map = find_map(file, space);
+	if (map == nullptr)
+		return 1;
+
+	// gather the rows and the peak of each access type
+	std::vector<const util::coverage_map::page *> rows;
+	std::uint32_t peak[util::coverage_map::TYPE_COUNT] = { 0, 0, 0 };
+	for (std::uint32_t number = 0; number < map->page_count(); number++)
+	{
+		const util::coverage_map::page *const p = map->find_page(number);
+		if (p == nullptr)
+			continue;
+		rows.push_back(p);
+		for (int type = 0; type < util::coverage_map::TYPE_COUNT; type++)
+			for (std::uint32_t hits : p->hits[type])
+				peak[type] = std::max(peak[type], hits);
+	}
+	if (rows.empty())
+	{
+		fprintf(stderr, "No coverage recorded for %s\n", map->name().c_str());
+		return 1;
+	}
+
+	auto const intensity = [&peak] (int type, std::uint32_t hits) -> std::uint8_t
+	{
+		if (hits == 0)
+			return 0;
+		// anything touched at all stays visible
+		double const level = std::log2(double(hits) + 1.0) / std::log2(double(peak[type]) + 1.0);
+		return std::uint8_t(48 + level * 207.0);
+	};
+
+	bitmap_argb32 bitmap(util::coverage_map::PAGE_CELLS * scale, rows.size() * scale);
+	for (std::size_t row = 0; row < rows.size(); row++)
+	{
+		const util::coverage_map::page &p = *rows[row];
+		for (std::uint32_t cell = 0; cell < util::coverage_map::PAGE_CELLS; cell++)
+		{
+			rgb_t const color(
+					intensity(util::coverage_map::WRITE, p.hits[util::coverage_map::WRITE][cell]),
+					intensity(util::coverage_map::EXEC, p.hits[util::coverage_map::EXEC][cell]),
+					intensity(util::coverage_map::READ, p.hits[util::coverage_map::READ][cell]));
+			for (int y = 0; y < scale; y++)
+				for (int x = 0; x < scale; x++)
+					bitmap.pix32(row * scale + y, cell * scale + x) = color;
+		}
+	}
+
+	util::core_file::ptr fp;
+	if (util::core_file::open(outname, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, fp) != osd_file::error::NONE)
+	{
+		fprintf(stderr, "Error creating '%s'\n", outname);
+		return 1;
+	}
+	if (png_write_bitmap(*fp, nullptr, bitmap, 0, nullptr) != PNGERR_NONE)
+	{
+		fprintf(stderr, "Error writing '%s'\n", outname);
+		return 1;
+	}
+
+	// the image has no room for addresses, so print the row legend
+	printf("%s: %u rows of %u addresses, %u per pixel\n", map->name().c_str(), unsigned(rows.size()),
+			util::coverage_map::PAGE_SIZE, 1U << util::coverage_map::CELL_BITS);
+	for (std::size_t row = 0; row < rows.size(); row++)
+		printf("  row %u: %08X\n", unsigned(row), rows[row]->number << util::coverage_map::PAGE_BITS);
+	return 0;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	// pull out the optional switches
+	const char *space = nullptr;
+	int scale = 2;
+	std::vector<const char *> args;
+	for (int arg = 1; arg < argc; arg++)
+	{
+		if (!strcmp(argv[arg], "-space") && arg + 1 < argc)
+			space = argv[++arg];
+		else if (!strcmp(argv[arg], "-scale") && arg + 1 < argc)
+			scale = std::max(1, std::min(16, atoi(argv[++arg])));
+		else
+			args.push_back(argv[arg]);
+	}
+
+	if (args.size() == 2 && !strcmp(args[0], "info"))
+		return do_info(args[1]);
+	if (args.size() == 3 && !strcmp(args[0], "ranges"))
+		return do_ranges(args[1], args[2], space, false);
+	if (args.size() == 3 && !strcmp(args[0], "unused"))
+		return do_ranges(args[1], args[2], space, true);
+	if (args.size() == 3 && !strcmp(args[0], "compare"))
+		return do_compare(args[1], args[2], space);
+	if (args.size() == 3 && !strcmp(args[0], "heatmap"))
+		return do_heatmap(args[1], args[2], space, scale);
+
+	fprintf(stderr,
+			"Usage:\n"
+			"  covtool info <file>\n"
+			"  covtool ranges <file> <read|write|exec> [-space <name>]\n"
+			"  covtool unused <file> <read|write|exec> [-space <name>]\n"
+			"  covtool compare <basefile> <newfile> [-space <name>]\n"
+			"  covtool heatmap <file> <output.png> [-space <name>] [-scale <n>]\n"
+			"\n"
+			"Files are written by the debugger's coversave command.  Without -space,\n"
+			"the first space in the file (normally program) is used.\n");
+	return 1;
+}
@@ -0,0 +1,232 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    outputbench.cpp
+
+    Test client for the network output module: connects to a running
+    emulator started with -output network, receives output updates for
+    a while and reports throughput for the text or binary protocol.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "asio.h"
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct bench_stats
+{
+	std::uint64_t bytes = 0;            // bytes received
+	std::uint64_t reads = 0;            // socket reads that returned data
+	std::uint64_t messages = 0;         // text messages or binary packets
+	std::uint64_t updates = 0;          // output values received
+	std::uint64_t frames = 0;           // binary delta packets
+	std::unordered_map<std::uint32_t, std::string> names;
+};
+
+/***************************************************************************
+    IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    get_u16/get_u32 - little-endian fields
+-------------------------------------------------*/
+
+static std::uint16_t get_u16(const std::uint8_t *data)
+{
+	return data[0] | (data[1] << 8);
+}
+
+static std::uint32_t get_u32(const std::uint8_t *data)
+{
+	return get_u16(data) | (std::uint32_t(get_u16(data + 2)) << 16);
+}
+
+
+/*-------------------------------------------------
+    parse_text - consume complete "name = value"
+    messages terminated by \1
+-------------------------------------------------*/
+
+static size_t parse_text(const std::vector<std::uint8_t> &buffer, bench_stats &stats, bool verbose)
+{
+	size_t start = 0;
+	for (size_t pos = 0; pos < buffer.size(); pos++)
+	{
+		if (buffer[pos] != 1)
+			continue;
+		if (verbose)
+			printf("%.*s\n", int(pos - start), reinterpret_cast<const char *>(&buffer[start]));
+		stats.messages++;
+		stats.updates++;
+		start = pos + 1;
+	}
+	return start;
+}
+
+
+/*-------------------------------------------------
+    parse_binary - consume complete binary packets
+-------------------------------------------------*/
+
+static size_t parse_binary(const std::vector<std::uint8_t> &buffer, bench_stats &stats, bool verbose)
+{
+	size_t start = 0;
+	while (start < buffer.size())
+	{
+		// the greeting arrives as text before the switch
+		if (buffer[start] != 1 && buffer[start] != 2)
+		{
+			size_t pos = start;
+			while (pos < buffer.size() && buffer[pos] != 1)
+				pos++;
+			if (pos == buffer.size())
+				break;
+			start = pos + 1;
+			continue;
+		}
+		if (buffer.size() - start < 5)
+			break;
+
+		const std::uint8_t *const packet = &buffer[start];
+		std::uint32_t const length = get_u32(packet + 1);
+		if (buffer.size() - start - 5 < length)
+			break;
+
+		const std::uint8_t *data = packet + 5;
+		const std::uint8_t *const end = data + length;
+		switch (packet[0])
+		{
+		case 1: // names
+			while (end - data >= 6)
+			{
+				std::uint32_t const id = get_u32(data);
+				std::uint16_t const namelen = get_u16(data + 4);
+				if (end - data - 6 < namelen)
+					break;
+				stats.names[id].assign(reinterpret_cast<const char *>(data + 6), namelen);
+				data += 6 + namelen;
+			}
+			break;
+
+		case 2: // delta
+			if (length >= 8)
+			{
+				std::uint32_t const frame = get_u32(data);
+				std::uint32_t const count = get_u32(data + 4);
+				data += 8;
+				for (std::uint32_t i = 0; i < count && end - data >= 8; i++, data += 8)
+				{
+					if (verbose)
+						printf("%u: %s = %d\n", frame, stats.names[get_u32(data)].c_str(), std::int32_t(get_u32(data + 4)));
+					stats.updates++;
+				}
+				stats.frames++;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		stats.messages++;
+		start += 5 + length;
+	}
+	return start;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	const char *host = "127.0.0.1";
+	const char *port = "8000";
+	double seconds = 10.0;
+	bool binary = true;
+	bool verbose = false;
+
+	for (int arg = 1; arg < argc; arg++)
+	{
+		if (!strcmp(argv[arg], "-text"))
+			binary = false;
+		else if (!strcmp(argv[arg], "-verbose"))
+			verbose = true;
+		else if (!strcmp(argv[arg], "-host") && arg + 1 < argc)
+			host = argv[++arg];
+		else if (!strcmp(argv[arg], "-port") && arg + 1 < argc)
+			port = argv[++arg];
+		else if (!strcmp(argv[arg], "-seconds") && arg + 1 < argc)
+			seconds = atof(argv[++arg]);
+		else
+		{
+			fprintf(stderr, "Usage:\noutputbench [-host <host>] [-port <port>] [-seconds <seconds>] [-text] [-verbose]\n");
+			return 1;
+		}
+	}
+
+	try
+	{
+		asio::io_context io_context;
+		asio::ip::tcp::resolver resolver(io_context);
+		asio::ip::tcp::socket socket(io_context);
+		asio::connect(socket, resolver.resolve(host, port));
+
+		if (binary)
+		{
+			static const char request[] = "binary = 1";
+			asio::write(socket, asio::buffer(request, sizeof(request) - 1));
+		}
+
+		bench_stats stats;
+		std::vector<std::uint8_t> buffer;
+		std::uint8_t chunk[65536];
+		auto const start = std::chrono::steady_clock::now();
+		auto const stop = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+		while (std::chrono::steady_clock::now() < stop)
+		{
+			std::error_code ec;
+			size_t const length = socket.read_some(asio::buffer(chunk), ec);
+			if (ec)
+			{
+				fprintf(stderr, "Connection closed: %s\n", ec.message().c_str());
+				break;
+			}
+
+			stats.bytes += length;
+			stats.reads++;
+			buffer.insert(buffer.end(), chunk, chunk + length);
+			size_t const used = binary ? parse_binary(buffer, stats, verbose) : parse_text(buffer, stats, verbose);
+			buffer.erase(buffer.begin(), buffer.begin() + used);
+		}
+
+		double const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		printf("%s protocol, %.2f seconds\n", binary ? "Binary" : "Text", elapsed);
+		printf("  %llu bytes (%.1f KB/s) in %llu reads\n", (unsigned long long)stats.bytes, stats.bytes / elapsed / 1024.0, (unsigned long long)stats.reads);
+		printf("  %llu messages, %llu output updates (%.0f/s)\n", (unsigned long long)stats.messages, (unsigned long long)stats.updates, stats.updates / elapsed);
+		if (binary)
+			printf("  %llu frames, %u named outputs\n", (unsigned long long)stats.frames, unsigned(stats.names.size()));
+	}
+	catch (std::exception &e)
+	{
+		fprintf(stderr, "Error: %s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
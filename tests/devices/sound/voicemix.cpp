@@ -0,0 +1,354 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "sound/voicemix.h"
+#include "sound/c352voice.h"
+#include "sound/multipcmslot.h"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace {
+
+u32 next_random(u32 &seed)
+{
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("voice mixer matches per-sample mixing", "[devices][sound]")
+{
+	/*
+	    Devices used to step every voice once per output sample and sum
+	    into an accumulator; with the mixer they render one voice over
+	    the whole block first.  Feed both the same voice data and make
+	    sure every output sample comes out identical, including the
+	    rounding of negative values by the shifts and the wrap/saturate
+	    behaviour on output.
+	*/
+	const int voices = 32;
+	u32 seed = 12345;
+
+	voice_mixer mixer(2, 3);
+
+	// a few block sizes, including growing and shrinking between updates
+	for (int samples : { 1, 7, 256, 257, 1000, 64, 2048 })
+	{
+		std::vector<s32> smp(voices * samples), gain(voices * samples);
+		for (int i = 0; i < voices * samples; i++)
+		{
+			smp[i] = s16(next_random(seed));
+			gain[i] = s32(next_random(seed) & 0x1ff) - 0x100;
+		}
+		const s32 fixed_gain = 0xc3;
+
+		// reference: per sample, over all voices
+		std::vector<stream_sample_t> expected_wrap(samples), expected_clamp(samples);
+		for (int i = 0; i < samples; i++)
+		{
+			long out0 = 0, out1 = 0;
+			for (int v = 0; v < voices; v++)
+			{
+				out0 += (smp[v * samples + i] * gain[v * samples + i]) >> 8;
+				out1 += (smp[v * samples + i] * fixed_gain) >> 8;
+			}
+			expected_wrap[i] = s16(out0 >> 3);
+			expected_clamp[i] = std::max<long>(-32768, std::min<long>(32767, out1));
+		}
+
+		// block: one voice at a time
+		mixer.begin(samples);
+		REQUIRE(mixer.samples() == samples);
+		for (int v = 0; v < voices; v++)
+		{
+			std::copy_n(&smp[v * samples], samples, mixer.buffer(0));
+			std::copy_n(&gain[v * samples], samples, mixer.buffer(1));
+			mixer.mix(0, mixer.buffer(0), mixer.buffer(1), 8);
+			mixer.mix(1, mixer.buffer(0), fixed_gain, 8);
+		}
+
+		std::vector<stream_sample_t> actual_wrap(samples), actual_clamp(samples);
+		mixer.write(0, &actual_wrap[0], 3);
+		mixer.write_clamped(1, &actual_clamp[0], 0);
+
+		REQUIRE(actual_wrap == expected_wrap);
+		REQUIRE(actual_clamp == expected_clamp);
+	}
+}
+
+
+namespace {
+
+/*
+    The devices' voice engines, fed from a small sample ROM filled with
+    noise.  Each one is driven exactly as the device drives it, so the
+    block update can be compared against the old per-sample update.
+*/
+
+class c352_test : public c352_voices<c352_test>
+{
+public:
+	c352_test() : m_rom(0x20000)
+	{
+		u32 seed = 1;
+		for (u8 &b : m_rom)
+			b = u8(next_random(seed));
+	}
+
+	u8 read_byte(u32 address) { return m_rom[address & 0x1ffff]; }
+
+	c352_voice_t &voice(int index) { return m_c352_v[index]; }
+
+	void key_on(int index, u16 flags, u16 start, u16 end, u16 loop, u16 freq, u16 vol_f, u16 vol_r)
+	{
+		c352_voice_t &v = m_c352_v[index];
+		v.wave_bank = index & 1;
+		v.wave_start = start;
+		v.wave_end = end;
+		v.wave_loop = loop;
+		v.freq = freq;
+		v.vol_f = vol_f;
+		v.vol_r = vol_r;
+		v.flags = flags | C352_FLG_KEYON;
+		key_voices();
+	}
+
+	void key_off(int index)
+	{
+		m_c352_v[index].flags |= C352_FLG_KEYOFF;
+		key_voices();
+	}
+
+private:
+	std::vector<u8> m_rom;
+};
+
+
+class multipcm_test : public multipcm_slots<multipcm_test>
+{
+public:
+	multipcm_test()
+		: m_rom(0x20000)
+		, m_slot_store(28)
+		, m_left(0x800)
+		, m_right(0x800)
+		, m_exp(0x400)
+		, m_lfo_table(256)
+		, m_lfo_scale(256)
+	{
+		u32 seed = 2;
+		for (u8 &b : m_rom)
+			b = u8(next_random(seed));
+
+		// the same shapes as the device's tables, without the float maths
+		for (int pan = 0; pan < 0x10; pan++)
+			for (int level = 0; level < 0x80; level++)
+			{
+				const s32 total = (0x80 - level) << (TL_SHIFT - 9);
+				m_left[(pan << 7) | level] = (pan & 8) ? total : total * (8 - pan) / 8;
+				m_right[(pan << 7) | level] = (pan & 8) ? total * (0x10 - pan) / 8 : total;
+			}
+		for (int i = 0; i < 0x400; i++)
+			m_exp[i] = (i * i) >> 8;
+		for (int i = 0; i < 256; i++)
+		{
+			m_lfo_table[i] = (i < 128) ? 255 - i * 2 : i * 2 - 256;
+			m_lfo_scale[i] = (1 << LFO_SHIFT) - 32 + (i >> 2);
+		}
+
+		m_slots = &m_slot_store[0];
+		m_left_pan_table = &m_left[0];
+		m_right_pan_table = &m_right[0];
+		m_linear_to_exp_volume = &m_exp[0];
+	}
+
+	u8 read_byte(u32 address) { return m_rom[address & 0x1ffff]; }
+
+	slot_t &slot(int index) { return m_slots[index]; }
+
+	void key_on(int index, u32 seed)
+	{
+		slot_t &s = m_slots[index];
+		s = slot_t();
+		s.m_slot_index = index;
+		s.m_regs[6] = (seed & 1) ? 3 : 0;
+		s.m_regs[7] = (seed & 2) ? 5 : 0;
+		s.m_playing = true;
+		s.m_sample.m_loop = (seed >> 4) & 0x3ff;
+		s.m_sample.m_end = s.m_sample.m_loop + 0x40 + ((seed >> 8) & 0x3ff);
+		s.m_base = index << 12;
+		s.m_step = 0x400 + ((seed >> 12) & 0x1fff);
+		s.m_pan = (seed >> 2) & 0xf;
+		s.m_dest_total_level = (seed >> 20) & 0x7f;
+		s.m_total_level = ((seed >> 26) & 0x3f) << TL_SHIFT;
+		s.m_total_level_step = (s.m_total_level >> TL_SHIFT) > s.m_dest_total_level ? -0x98 : 0x4c;
+		s.m_envelope_gen.m_state = state_t::ATTACK;
+		s.m_envelope_gen.m_attack_rate = 0x40 << EG_SHIFT;
+		s.m_envelope_gen.m_decay1_rate = 0x4 << EG_SHIFT;
+		s.m_envelope_gen.m_decay2_rate = 0x1 << EG_SHIFT;
+		s.m_envelope_gen.m_release_rate = (0x8 << EG_SHIFT) + (seed & 0xffff);
+		s.m_envelope_gen.m_decay_level = 8;
+		s.m_pitch_lfo.m_phase_step = 0x300;
+		s.m_pitch_lfo.m_table = &m_lfo_table[0];
+		s.m_pitch_lfo.m_scale = &m_lfo_scale[0];
+		s.m_amplitude_lfo.m_phase_step = 0x500;
+		s.m_amplitude_lfo.m_table = &m_lfo_table[0];
+		s.m_amplitude_lfo.m_scale = &m_lfo_scale[0];
+	}
+
+	void key_off(int index)
+	{
+		m_slots[index].m_envelope_gen.m_state = state_t::RELEASE;
+	}
+
+	// the update as it was before the mixer: every slot once per sample
+	void update_interleaved(stream_sample_t **outputs, s32 samples)
+	{
+		for (s32 i = 0; i < samples; ++i)
+		{
+			s32 smpl = 0;
+			s32 smpr = 0;
+			for (s32 sl = 0; sl < 28; ++sl)
+			{
+				slot_t *s = m_slots + sl;
+				if (s->m_playing)
+				{
+					u32 vol;
+					const s32 sample = step_slot(s, vol);
+					smpl += (m_left_pan_table[vol] * sample) >> TL_SHIFT;
+					smpr += (m_right_pan_table[vol] * sample) >> TL_SHIFT;
+				}
+			}
+			outputs[0][i] = std::max<s32>(-32768, std::min<s32>(32767, smpl));
+			outputs[1][i] = std::max<s32>(-32768, std::min<s32>(32767, smpr));
+		}
+	}
+
+private:
+	std::vector<u8> m_rom;
+	std::vector<slot_t> m_slot_store;
+	std::vector<s32> m_left, m_right, m_exp, m_lfo_table, m_lfo_scale;
+};
+
+
+// run two copies of an engine over the same blocks, one per update path
+template <typename Engine, typename Change>
+void compare_updates(int outputs, Change &&change)
+{
+	Engine reference, block;
+	u32 seed = 4321;
+
+	int round = 0;
+	for (int samples : { 1, 3, 64, 257, 1000, 16, 2048, 511, 2, 4096 })
+	{
+		u32 const change_seed = next_random(seed);
+		change(reference, round, change_seed);
+		change(block, round, change_seed);
+		round++;
+
+		std::vector<stream_sample_t> expected(outputs * samples), actual(outputs * samples);
+		stream_sample_t *expected_out[4], *actual_out[4];
+		for (int o = 0; o < outputs; o++)
+		{
+			expected_out[o] = &expected[o * samples];
+			actual_out[o] = &actual[o * samples];
+		}
+
+		reference.update_interleaved(expected_out, samples);
+		block.update_block(actual_out, samples);
+
+		REQUIRE(actual == expected);
+	}
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("C352 block update matches the per-sample update", "[devices][sound]")
+{
+	/*
+	    Every flag combination the voice stepping cares about: forward,
+	    reverse and bidirectional loops, LINK, mulaw, filter off, phase
+	    inversion per output, volume ramps, and sample ends and keyoffs
+	    landing in the middle of a block.  Noise gets a run on its own
+	    (block path) and with a second noise voice (interleaved fallback).
+	*/
+	struct engine : c352_test
+	{
+		void update_block(stream_sample_t **outputs, int samples) { update_voices(outputs, samples); }
+	};
+
+	SECTION("sample voices")
+	{
+		compare_updates<engine>(4, [] (engine &chip, int round, u32 seed)
+		{
+			for (int v = 0; v < 32; v++)
+			{
+				u32 const r = seed ^ (v * 0x9e3779b9);
+				if ((r & 3) == 0 && (chip.voice(v).flags & c352_test::C352_FLG_BUSY))
+				{
+					chip.key_off(v);
+				}
+				else if ((r & 3) == 1 || round == 0)
+				{
+					u16 const flags = (r >> 2) & (c352_test::C352_FLG_PHASERL | c352_test::C352_FLG_PHASEFL | c352_test::C352_FLG_PHASEFR |
+							c352_test::C352_FLG_LINK | c352_test::C352_FLG_MULAW | c352_test::C352_FLG_FILTER | c352_test::C352_FLG_REVLOOP);
+					u16 const start = (r >> 8) & 0x3ff;
+					u16 const length = 0x10 + ((r >> 18) & 0x7ff);
+					u16 const loop = (flags & c352_test::C352_FLG_REVERSE) ? start + length / 2 : start + length / 4;
+					chip.key_on(v, flags, start, start + length, loop, 0x1000 + ((r >> 4) & 0x3fff), u16(r >> 16), u16(r));
+				}
+				else if ((r & 3) == 2)
+				{
+					// new target volumes ramp in over the next samples
+					chip.voice(v).vol_f = u16(r >> 12);
+					chip.voice(v).vol_r = u16(r >> 3);
+				}
+			}
+		});
+	}
+
+	SECTION("noise voices")
+	{
+		compare_updates<engine>(4, [] (engine &chip, int round, u32 seed)
+		{
+			if (round == 0)
+				chip.key_on(5, c352_test::C352_FLG_NOISE | c352_test::C352_FLG_PHASEFL, 0, 0, 0, 0x8000, 0xc040, 0x4080);
+			else if (round == 4)
+				chip.key_on(9, c352_test::C352_FLG_NOISE, 0, 0, 0, 0x3000, 0x80ff, 0xff80);
+			else if (round == 7)
+				chip.key_off(5);
+			chip.key_on(20 + (round & 7), c352_test::C352_FLG_LOOP, 0x100, 0x180 + (seed & 0xff), 0x120, 0x6000, 0x8080, 0x8080);
+		});
+	}
+}
+
+
+TEST_CASE("MultiPCM block update matches the per-sample update", "[devices][sound]")
+{
+	/*
+	    Slots with vibrato, tremolo, both or neither, all panning
+	    settings, total level interpolation in either direction, and
+	    release envelopes that finish in the middle of a block.
+	*/
+	struct engine : multipcm_test
+	{
+		void update_block(stream_sample_t **outputs, int samples) { update_slots(outputs, samples); }
+	};
+
+	compare_updates<engine>(2, [] (engine &chip, int round, u32 seed)
+	{
+		for (int sl = 0; sl < 28; sl++)
+		{
+			u32 const r = seed ^ (sl * 0x9e3779b9);
+			if ((r & 3) == 0 && chip.slot(sl).m_playing)
+				chip.key_off(sl);
+			else if ((r & 3) == 1 || round == 0)
+				chip.key_on(sl, r >> 2);
+		}
+	});
+}
@@ -0,0 +1,149 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "video/texcache.h"
+
+
+namespace {
+
+// decode a texture as "source byte plus a per-format bias", counting calls
+struct test_source
+{
+	u8 mem[0x1000];
+	int decodes = 0;
+
+	const u32 *get(texture_cache &cache, u32 address, u32 format, u32 palette, u32 length, texture_cache::range pal = { 0, 0 })
+	{
+		return cache.get(address, format, palette, length, texture_cache::range{ address, length }, pal, [this, address, format, length] (u32 *dest)
+		{
+			decodes++;
+			for (u32 i = 0; i < length; i++)
+				dest[i] = mem[address + i] + (format << 8);
+		});
+	}
+};
+
+} // anonymous namespace
+
+
+TEST_CASE("texture cache reuses decodes until written", "[devices][video]")
+{
+	test_source src;
+	for (int i = 0; i < 0x1000; i++)
+		src.mem[i] = u8(i);
+
+	texture_cache cache(0x1000, 8, 4);
+
+	const u32 *tex = src.get(cache, 0x100, 1, 0, 0x100);
+	REQUIRE(src.decodes == 1);
+	REQUIRE(tex[5] == 0x105);
+
+	// same key hits, different format or palette misses
+	REQUIRE(src.get(cache, 0x100, 1, 0, 0x100) == tex);
+	src.get(cache, 0x100, 2, 0, 0x100);
+	src.get(cache, 0x100, 1, 3, 0x100);
+	REQUIRE(src.decodes == 3);
+	REQUIRE(cache.hits() == 1);
+	REQUIRE(cache.misses() == 3);
+
+	// writes to other pages leave the entry alone
+	src.mem[0x000] = 0xaa;
+	cache.invalidate(0x000, 1);
+	src.mem[0x200] = 0xbb;
+	cache.invalidate(0x200, 1);
+	src.get(cache, 0x100, 1, 0, 0x100);
+	REQUIRE(src.decodes == 3);
+
+	// a write inside the range forces a re-decode with the new data
+	src.mem[0x1ff] = 0x42;
+	cache.invalidate(0x1ff, 1);
+	tex = src.get(cache, 0x100, 1, 0, 0x100);
+	REQUIRE(src.decodes == 4);
+	REQUIRE(tex[0xff] == 0x142);
+}
+
+TEST_CASE("texture cache tracks palette ranges", "[devices][video]")
+{
+	test_source src;
+	texture_cache cache(0x1000, 8, 4);
+
+	src.get(cache, 0x000, 0, 0, 0x100, texture_cache::range{ 0x800, 0x20 });
+	cache.invalidate(0x900, 0x10);
+	src.get(cache, 0x000, 0, 0, 0x100, texture_cache::range{ 0x800, 0x20 });
+	REQUIRE(src.decodes == 1);
+
+	cache.invalidate(0x810, 2);
+	src.get(cache, 0x000, 0, 0, 0x100, texture_cache::range{ 0x800, 0x20 });
+	REQUIRE(src.decodes == 2);
+}
+
+TEST_CASE("texture cache evicts least recently used entries", "[devices][video]")
+{
+	test_source src;
+	texture_cache cache(0x1000, 8, 2);
+
+	src.get(cache, 0x000, 0, 0, 0x10);
+	src.get(cache, 0x100, 0, 0, 0x10);
+	src.get(cache, 0x000, 0, 0, 0x10);      // touch the first one
+	src.get(cache, 0x200, 0, 0, 0x10);      // evicts 0x100
+	REQUIRE(cache.entries() == 2);
+	REQUIRE(src.decodes == 3);
+
+	src.get(cache, 0x000, 0, 0, 0x10);
+	REQUIRE(src.decodes == 3);
+	src.get(cache, 0x100, 0, 0, 0x10);
+	REQUIRE(src.decodes == 4);
+
+	cache.flush();
+	REQUIRE(cache.entries() == 0);
+}
+
+TEST_CASE("texture cache redecodes only written pages", "[devices][video]")
+{
+	// 16-bit texels: two source bytes each, 128 to a page
+	u16 mem[0x800];
+	for (int i = 0; i < 0x800; i++)
+		mem[i] = u16(i);
+	u32 decoded = 0;
+	auto get = [&mem, &decoded] (texture_cache &cache, texture_cache::range pal)
+	{
+		return cache.get_pages(0, 0, 0, 0x800, texture_cache::range{ 0, 0x1000 }, pal, 1, [&mem, &decoded] (u32 *dest, u32 first, u32 count)
+		{
+			decoded += count;
+			for (u32 i = first; i < first + count; i++)
+				dest[i] = mem[i];
+		});
+	};
+
+	texture_cache cache(0x1000, 8, 4);
+	const u32 *tex = get(cache, texture_cache::range{ 0xf00, 0x100 });
+	REQUIRE(decoded == 0x800);
+
+	// a write straddling two pages redoes just those two
+	mem[0x17f] = 0xaaaa;
+	mem[0x180] = 0xbbbb;
+	cache.invalidate(0x2fe, 4);
+	decoded = 0;
+	REQUIRE(get(cache, texture_cache::range{ 0xf00, 0x100 }) == tex);
+	REQUIRE(decoded == 0x100);
+	REQUIRE(tex[0x17f] == 0xaaaa);
+	REQUIRE(tex[0x180] == 0xbbbb);
+	REQUIRE(cache.partial_decodes() == 1);
+
+	// separate writes make separate runs
+	cache.invalidate(0x000, 1);
+	cache.invalidate(0x800, 1);
+	decoded = 0;
+	get(cache, texture_cache::range{ 0xf00, 0x100 });
+	REQUIRE(decoded == 0x100);
+
+	// nothing written, nothing done
+	decoded = 0;
+	get(cache, texture_cache::range{ 0xf00, 0x100 });
+	REQUIRE(decoded == 0);
+
+	// a palette write redoes everything
+	cache.invalidate(0xf80, 2);
+	get(cache, texture_cache::range{ 0xf00, 0x100 });
+	REQUIRE(decoded == 0x800);
+}
@@ -0,0 +1,166 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "debug/express.h"
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+// a symbol table whose accesses are all logged, so compiled and
+// interpreted execution can be compared for order of side effects
+struct test_machine
+{
+	u64 a = 5, b = 3, c = 0;
+	u64 reg = 0x1234;
+	u8 mem[0x100];
+	std::string log;
+	symbol_table symbols;
+
+	test_machine() : symbols(nullptr)
+	{
+		for (int i = 0; i < 0x100; i++)
+			mem[i] = u8(i * 7);
+
+		symbols.add("a", symbol_table::READ_WRITE, &a);
+		symbols.add("b", symbol_table::READ_WRITE, &b);
+		symbols.add("c", symbol_table::READ_ONLY, &c);
+		symbols.add("k", 0x40);
+		symbols.add("local", symbol_table::READ_WRITE);
+		symbols.add("reg",
+				[this] (symbol_table &table) { log += "r"; return reg; },
+				[this] (symbol_table &table, u64 value) { log += "w"; reg = value; });
+		symbols.add("sum", 0, 4, [this] (symbol_table &table, int numparams, const u64 *paramlist)
+		{
+			log += "f" + std::to_string(numparams);
+			u64 result = 0;
+			for (int i = 0; i < numparams; i++)
+				result = result * 10 + paramlist[i];
+			return result;
+		});
+		symbols.configure_memory(this,
+				[] (void *param, const char *name, expression_space space) { return expression_error::NONE; },
+				[] (void *param, const char *name, expression_space space, u32 offset, int size, bool disable_se)
+				{
+					test_machine &m = *reinterpret_cast<test_machine *>(param);
+					m.log += "m" + std::to_string(offset & 0xff);
+					u64 result = 0;
+					for (int i = size - 1; i >= 0; i--)
+						result = (result << 8) | m.mem[(offset + i) & 0xff];
+					return result;
+				},
+				[] (void *param, const char *name, expression_space space, u32 offset, int size, u64 value, bool disable_se)
+				{
+					test_machine &m = *reinterpret_cast<test_machine *>(param);
+					m.log += "M" + std::to_string(offset & 0xff);
+					for (int i = 0; i < size; i++)
+						m.mem[(offset + i) & 0xff] = u8(value >> (8 * i));
+				});
+	}
+
+	std::string state() const
+	{
+		return std::to_string(a) + "," + std::to_string(b) + "," + std::to_string(reg) + "," + std::to_string(symbols.find("local")->value()) + "," +
+				std::string(reinterpret_cast<const char *>(mem), sizeof(mem)) + "," + log;
+	}
+};
+
+// run an expression a few times, returning results, errors and side effects
+std::string run(const char *string, bool compiled)
+{
+	test_machine machine;
+	std::string result;
+	try
+	{
+		parsed_expression expression(&machine.symbols, string);
+		for (int i = 0; i < 3; i++)
+		{
+			try
+			{
+				result += std::to_string(compiled ? expression.execute() : expression.execute_interpreted()) + ";";
+			}
+			catch (expression_error &err)
+			{
+				result += "error " + std::to_string(int(err.code())) + "@" + std::to_string(err.offset()) + ";";
+			}
+		}
+	}
+	catch (expression_error &err)
+	{
+		result += "parse error " + std::to_string(int(err.code())) + ";";
+	}
+	return result + machine.state();
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("compiled expressions match the token interpreter", "[emu][debug]")
+{
+	static const char *const expressions[] =
+	{
+		"1 + 2 * 3",
+		"(a + b) * k - 1",
+		"a / b % 2",
+		"a / (b - 3)",
+		"a % 0",
+		"10 / 0",
+		"-a + ~b + !c + +k",
+		"a == 5 && b != 3 || c < 1",
+		"a << 4 >> b",
+		"a > b, b >= a, a <= b",
+		"a = b = 7",
+		"a += 2, b -= 1, a *= b",
+		"a /= 0",
+		"a %= b",
+		"a <<= 2, a >>= 1, a &= 0x7f, a |= 0x100, a ^= 0x3",
+		"++a + a++ + --b + b--",
+		"local = local + 1",
+		"reg + reg * 2",
+		"reg = reg + 1",
+		"reg++ + ++reg",
+		"b@10 + w@20 + d@30",
+		"b@(a + 2) = 0xaa",
+		"w@a += reg",
+		"d@reg + b@b@4",
+		"sum()",
+		"sum(1, 2, 3)",
+		"sum(reg, b@1, a++)",
+		"sum(sum(1, 2), sum(reg))",
+		"(reg, b@2), a",
+		"k = 1",
+		"c = 1",
+		"5 = a",
+		"a +",
+		"sum",
+		"sum + 1",
+		"1 2",
+		"(1 + 2",
+		"1 + 2)",
+		"((((((((((((((((1))))))))))))))))",
+		"1+(2+(3+(4+(5+(6+(7+(8+(9+(10+(11+(12+(13+(14+(15+(16+17)))))))))))))))",
+		"a+(b+(a+(b+(a+(b+(a+(b+(a+(b+(a+(b+(a+(b+(a+(b+a)))))))))))))))"
+	};
+
+	for (const char *string : expressions)
+	{
+		INFO(string);
+		REQUIRE(run(string, true) == run(string, false));
+	}
+}
+
+TEST_CASE("copied expressions execute like the original", "[emu][debug]")
+{
+	test_machine machine;
+	parsed_expression original(&machine.symbols, "(a + b) * 2");
+	parsed_expression copy(original);
+	parsed_expression assigned;
+	assigned = original;
+
+	REQUIRE(original.execute() == 16);
+	REQUIRE(copy.execute() == 16);
+	REQUIRE(assigned.execute() == 16);
+	REQUIRE(copy.execute_interpreted() == 16);
+}
@@ -0,0 +1,68 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "debug/memsearch.h"
+
+#include <vector>
+
+
+TEST_CASE("Memory search patterns follow endianness and wildcards", "[debug]")
+{
+	memory_search::pattern little, big;
+	little.add(0x1234, 2, ENDIANNESS_LITTLE);
+	little.add_wildcard(1);
+	little.add(0x56, 1, ENDIANNESS_LITTLE);
+	big.add(0x1234, 2, ENDIANNESS_BIG);
+
+	u8 const data[] = { 0x34, 0x12, 0x99, 0x56 };
+	REQUIRE(little.length() == 4);
+	REQUIRE(little.matches(data));
+	REQUIRE_FALSE(big.matches(data));
+	REQUIRE(big.matches(data + 1) == false);
+
+	u8 const bigdata[] = { 0x12, 0x34 };
+	REQUIRE(big.matches(bigdata));
+}
+
+TEST_CASE("Memory search finds aligned matches", "[debug]")
+{
+	std::vector<u8> data(1000, 0);
+	data[10] = 0xaa; data[11] = 0xbb;
+	data[501] = 0xaa; data[502] = 0xbb;
+	data[998] = 0xaa; data[999] = 0xbb;
+
+	memory_search::pattern pattern;
+	pattern.add(0xaa, 1, ENDIANNESS_LITTLE);
+	pattern.add(0xbb, 1, ENDIANNESS_LITTLE);
+
+	memory_search search;
+	std::vector<size_t> results;
+
+	// every match that fits
+	search.find(&data[0], data.size() - pattern.length() + 1, 1, pattern, results);
+	REQUIRE(results == std::vector<size_t>({ 10, 501, 998 }));
+
+	// only even positions
+	search.find(&data[0], data.size() - pattern.length() + 1, 2, pattern, results);
+	REQUIRE(results == std::vector<size_t>({ 10, 998 }));
+
+	// positions limit where a match may start, not where it may end
+	search.find(&data[0], 999, 1, pattern, results);
+	REQUIRE(results.back() == 998);
+	search.find(&data[0], 998, 1, pattern, results);
+	REQUIRE(results.back() == 501);
+}
+
+TEST_CASE("Memory search matches wildcard-only patterns everywhere", "[debug]")
+{
+	std::vector<u8> data(64, 0x5a);
+	memory_search::pattern pattern;
+	pattern.add_wildcard(4);
+
+	memory_search search;
+	std::vector<size_t> results;
+	search.find(&data[0], 61, 4, pattern, results);
+	REQUIRE(results.size() == 16);
+	REQUIRE(results.front() == 0);
+	REQUIRE(results.back() == 60);
+}
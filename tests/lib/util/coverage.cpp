@@ -0,0 +1,90 @@
+#include "catch.hpp"
+
+#include "coverage.h"
+
+#include <cstdio>
+
+
+TEST_CASE("Coverage map records accesses per address and cell", "[util]")
+{
+	util::coverage_map map("program", 0xffff);
+
+	REQUIRE(map.page_count() == 16);
+	REQUIRE(map.find_page(1) == nullptr);
+
+	map.record(util::coverage_map::EXEC, 0x1234);
+	map.record(util::coverage_map::EXEC, 0x1234);
+	map.record(util::coverage_map::EXEC, 0x1235);
+	map.record(util::coverage_map::READ, 0x21234);     // masked to 0x1234
+
+	REQUIRE(map.find_page(1) != nullptr);
+	REQUIRE(map.find_page(2) == nullptr);
+	REQUIRE(map.touched(util::coverage_map::EXEC, 0x1234));
+	REQUIRE(map.touched(util::coverage_map::EXEC, 0x1235));
+	REQUIRE_FALSE(map.touched(util::coverage_map::EXEC, 0x1236));
+	REQUIRE_FALSE(map.touched(util::coverage_map::WRITE, 0x1234));
+	REQUIRE(map.touched(util::coverage_map::READ, 0x1234));
+	REQUIRE(map.hits(util::coverage_map::EXEC, 0x123f) == 3);
+	REQUIRE(map.hits(util::coverage_map::EXEC, 0x1240) == 0);
+	REQUIRE(map.touched_count(util::coverage_map::EXEC) == 2);
+
+	map.clear();
+	REQUIRE(map.find_page(1) == nullptr);
+	REQUIRE(map.touched_count(util::coverage_map::EXEC) == 0);
+}
+
+TEST_CASE("Coverage maps merge runs", "[util]")
+{
+	util::coverage_map first("program", 0xffff), second("program", 0xffff);
+
+	first.record(util::coverage_map::WRITE, 0x0010);
+	second.record(util::coverage_map::WRITE, 0x0011);
+	second.record(util::coverage_map::EXEC, 0x8000);
+	first.merge(second);
+
+	REQUIRE(first.touched(util::coverage_map::WRITE, 0x0010));
+	REQUIRE(first.touched(util::coverage_map::WRITE, 0x0011));
+	REQUIRE(first.touched(util::coverage_map::EXEC, 0x8000));
+	REQUIRE(first.hits(util::coverage_map::WRITE, 0x0010) == 2);
+}
+
+TEST_CASE("Coverage files round trip", "[util]")
+{
+	util::coverage_map program("program", 0xffff), io("io", 0xff);
+	program.record(util::coverage_map::EXEC, 0xc000);
+	program.record(util::coverage_map::READ, 0x0100);
+	io.record(util::coverage_map::WRITE, 0x42);
+
+	char const *const filename = "coverage_test.cov";
+	{
+		util::core_file::ptr file;
+		REQUIRE(util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) == osd_file::error::NONE);
+		REQUIRE(util::coverage_map::save(*file, ":maincpu", { &program, &io }) == util::coverage_error::NONE);
+	}
+
+	std::string tag;
+	std::vector<std::unique_ptr<util::coverage_map>> maps;
+	{
+		util::core_file::ptr file;
+		REQUIRE(util::core_file::open(filename, OPEN_FLAG_READ, file) == osd_file::error::NONE);
+		REQUIRE(util::coverage_map::load(*file, tag, maps) == util::coverage_error::NONE);
+	}
+	std::remove(filename);
+
+	REQUIRE(tag == ":maincpu");
+	REQUIRE(maps.size() == 2);
+	REQUIRE(maps[0]->name() == "program");
+	REQUIRE(maps[0]->addrmask() == 0xffff);
+	REQUIRE(maps[0]->touched(util::coverage_map::EXEC, 0xc000));
+	REQUIRE(maps[0]->touched(util::coverage_map::READ, 0x0100));
+	REQUIRE(maps[0]->touched_count(util::coverage_map::WRITE) == 0);
+	REQUIRE(maps[1]->name() == "io");
+	REQUIRE(maps[1]->touched(util::coverage_map::WRITE, 0x42));
+	REQUIRE(maps[1]->hits(util::coverage_map::WRITE, 0x42) == 1);
+
+	// anything else is rejected
+	static char const garbage[] = "not a coverage file";
+	util::core_file::ptr file;
+	REQUIRE(util::core_file::open_ram(garbage, sizeof(garbage), OPEN_FLAG_READ, file) == osd_file::error::NONE);
+	REQUIRE(util::coverage_map::load(*file, tag, maps) == util::coverage_error::BAD_SIGNATURE);
+}
@@ -0,0 +1,71 @@
+#include "catch.hpp"
+
+#include "spscqueue.h"
+
+#include <memory>
+#include <thread>
+
+
+TEST_CASE("SPSC queue keeps order and capacity", "[util]")
+{
+	util::spsc_queue<int, 4> queue;
+	int value = 0;
+
+	REQUIRE(queue.empty());
+	REQUIRE_FALSE(queue.pop(value));
+
+	for (int i = 0; i < 4; i++)
+		REQUIRE(queue.push(int(i)));
+	REQUIRE_FALSE(queue.push(99));
+
+	for (int i = 0; i < 4; i++)
+	{
+		REQUIRE(queue.pop(value));
+		REQUIRE(value == i);
+	}
+	REQUIRE(queue.empty());
+}
+
+TEST_CASE("SPSC queue moves items through", "[util]")
+{
+	util::spsc_queue<std::unique_ptr<int>, 2> queue;
+	std::unique_ptr<int> item(new int(5));
+
+	REQUIRE(queue.push(std::move(item)));
+	REQUIRE(item == nullptr);
+
+	std::unique_ptr<int> full(new int(6));
+	REQUIRE(queue.push(std::move(full)));
+	std::unique_ptr<int> rejected(new int(7));
+	REQUIRE_FALSE(queue.push(std::move(rejected)));
+	REQUIRE(rejected != nullptr);
+
+	REQUIRE(queue.pop(item));
+	REQUIRE(*item == 5);
+}
+
+TEST_CASE("SPSC queue passes every item between threads", "[util]")
+{
+	util::spsc_queue<unsigned, 16> queue;
+	unsigned const count = 100000;
+
+	std::thread producer([&queue, count] ()
+	{
+		for (unsigned i = 0; i < count; )
+			if (queue.push(unsigned(i)))
+				i++;
+	});
+
+	unsigned expected = 0;
+	bool ordered = true;
+	while (expected < count)
+	{
+		unsigned value;
+		if (queue.pop(value))
+			ordered = ordered && (value == expected++);
+	}
+	producer.join();
+
+	REQUIRE(ordered);
+	REQUIRE(queue.empty());
+}
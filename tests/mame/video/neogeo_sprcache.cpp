@@ -0,0 +1,154 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "video/neogeo_sprcache.h"
+
+#include <random>
+
+
+namespace {
+
+constexpr int LINES = 0x108;
+
+// the per-line scan the cache replaces
+void reference_list(const u16 *scb3, int scanline, u16 *sprite_list)
+{
+	int y = 0;
+	int rows = 0;
+	int active_sprite_count = 0;
+
+	for (int sprite_number = 0; sprite_number < neogeo_sprite_cache::SPRITES_PER_SCREEN; sprite_number++)
+	{
+		u16 const y_control = scb3[sprite_number];
+
+		if (~y_control & 0x40)
+		{
+			y = 0x200 - (y_control >> 7);
+			rows = y_control & 0x3f;
+		}
+
+		if (rows == 0 || !neogeo_sprite_cache::sprite_on_scanline(scanline, y, rows))
+			continue;
+
+		*sprite_list++ = sprite_number;
+		if (++active_sprite_count == neogeo_sprite_cache::SPRITES_PER_LINE)
+			break;
+	}
+
+	std::fill(sprite_list, sprite_list + neogeo_sprite_cache::SPRITES_PER_LINE - active_sprite_count + 1, 0);
+}
+
+// the 16 step zoom loop the cache replaces, with the wrap-around case
+void reference_line(u32 *row, int x, int zoom_x, int gfx_base, bool flip)
+{
+	const int *zoom_x_table = neogeo_sprite_cache::zoom_x_tables[zoom_x];
+	int x_inc = 1;
+	if (flip)
+	{
+		gfx_base += 0x0f;
+		x_inc = -1;
+	}
+
+	u32 *pixel_addr = (x <= 0x1f0) ? row + x : row;
+	for (int i = 0; i < 0x10; i++)
+	{
+		if (*zoom_x_table)
+		{
+			if (x <= 0x1f0)
+			{
+				*pixel_addr++ = gfx_base + 1;
+			}
+			else
+			{
+				if (x >= 0x200)
+					*pixel_addr++ = gfx_base + 1;
+				x++;
+			}
+		}
+		zoom_x_table++;
+		gfx_base += x_inc;
+	}
+}
+
+void random_scb3(std::mt19937 &rng, u16 *scb3)
+{
+	for (int i = 0; i < 0x200; i++)
+		scb3[i] = u16(rng());
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("neogeo sprite lists match a full scan", "[mame][video]")
+{
+	std::mt19937 rng(0x5eed);
+	neogeo_sprite_cache cache(LINES);
+	u16 scb3[0x200];
+	u16 expected[neogeo_sprite_cache::LIST_LENGTH];
+	u16 actual[neogeo_sprite_cache::LIST_LENGTH];
+
+	for (int frame = 0; frame < 8; frame++)
+	{
+		if (frame & 1)
+		{
+			// a few sprites moved
+			for (int i = 0; i < 4; i++)
+				scb3[rng() % neogeo_sprite_cache::SPRITES_PER_SCREEN] = u16(rng());
+		}
+		else
+		{
+			random_scb3(rng, scb3);
+		}
+		cache.invalidate();
+
+		// the second pass over each frame is served from the cache
+		for (int pass = 0; pass < 2; pass++)
+		{
+			for (int scanline = 0; scanline < LINES; scanline++)
+			{
+				std::fill(std::begin(actual), std::end(actual), 0xffff);
+				reference_list(scb3, scanline, expected);
+				cache.build_list(scb3, scanline, actual);
+				REQUIRE(std::equal(std::begin(expected), std::end(expected), std::begin(actual)));
+			}
+		}
+	}
+}
+
+TEST_CASE("neogeo sprite lists stop at the per-line limit", "[mame][video]")
+{
+	neogeo_sprite_cache cache(LINES);
+	u16 scb3[0x200];
+	u16 list[neogeo_sprite_cache::LIST_LENGTH];
+
+	// every sprite 31 rows tall, starting on line 0
+	for (int i = 0; i < 0x200; i++)
+		scb3[i] = 0x1f;
+	cache.build_list(scb3, 0, list);
+
+	REQUIRE(list[0] == 0);
+	REQUIRE(list[neogeo_sprite_cache::SPRITES_PER_LINE - 1] == neogeo_sprite_cache::SPRITES_PER_LINE - 1);
+	REQUIRE(list[neogeo_sprite_cache::SPRITES_PER_LINE] == 0);
+}
+
+TEST_CASE("neogeo sprite zoom offsets are pixel exact", "[mame][video]")
+{
+	neogeo_sprite_cache cache(LINES);
+	static const int positions[] = { 0x000, 0x001, 0x0a0, 0x13f, 0x1f1, 0x1f8, 0x1ff };
+
+	for (int zoom_x = 0; zoom_x < 16; zoom_x++)
+	{
+		for (int flip = 0; flip < 2; flip++)
+		{
+			for (int x : positions)
+			{
+				u32 expected[0x160] = { 0 };
+				u32 actual[0x160] = { 0 };
+
+				reference_line(expected, x, zoom_x, 0x1230, flip);
+				cache.draw_line(actual, x, zoom_x, 0x1230, flip, [] (int romaddr, u32 *dst) { *dst = romaddr + 1; });
+				REQUIRE(std::equal(std::begin(expected), std::end(expected), std::begin(actual)));
+			}
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+
+#include "osdcore.h"
+
+#include <atomic>
+
+
+namespace {
+
+std::atomic<int> s_total;
+osd_work_queue *s_inner;
+
+void *add_one(void *param, int threadid)
+{
+	s_total++;
+	return nullptr;
+}
+
+void *queue_inner(void *param, int threadid)
+{
+	// queue more work from a worker and wait on it there, so the pool threads
+	// are busy stealing from each other when the queues go away
+	osd_work_item_queue_multiple(s_inner, add_one, 16, nullptr, 0, WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(s_inner, osd_ticks_per_second() * 10);
+	return nullptr;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Work queues can be freed while the pool is busy", "[osd]")
+{
+	for (int round = 0; round < 50; round++)
+	{
+		s_total = 0;
+		osd_work_queue *const multi = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+		osd_work_queue *const io = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		osd_work_queue *const serial = osd_work_queue_alloc(0);
+		s_inner = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		REQUIRE(multi != nullptr);
+		REQUIRE(io != nullptr);
+		REQUIRE(serial != nullptr);
+		REQUIRE(s_inner != nullptr);
+
+		osd_work_item_queue_multiple(multi, queue_inner, 8, nullptr, 0, WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_item_queue_multiple(multi, add_one, 256, nullptr, 0, WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_item_queue_multiple(io, add_one, 64, nullptr, 0, WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_item_queue_multiple(serial, add_one, 64, nullptr, 0, WORK_ITEM_FLAG_AUTO_RELEASE);
+
+		// freeing waits for each queue's own items; the last one shuts the pool down
+		osd_work_queue_free(serial);
+		osd_work_queue_free(io);
+		osd_work_queue_free(multi);
+		osd_work_queue_free(s_inner);
+		REQUIRE(s_total == 8 * 16 + 256 + 64 + 64);
+	}
+}